@@ -0,0 +1,331 @@
+#include "global.h"
+
+// 비동기 에셋 로더
+// 파일 읽기와 디코딩(IMG_Load, cJSON_Parse)은 로더 스레드에서, 텍스처 생성(SDL_CreateTextureFromSurface)은
+// 렌더러를 가진 메인 스레드에서 프레임마다 정해진 개수만큼 처리
+// 같은 경로는 한 번만 로드하고 참조 횟수로 공유, 0이 되면 해제
+// 게임 컨텍스트마다 다른 스레드에서 요청/반납할 수 있으므로 참조 횟수와 칸 할당, 큐에 넣기는 assetLock으로 보호
+#define MAX_ASSETS 128
+#define ASSET_QUEUE_SIZE 128        // 2의 거듭제곱
+
+typedef struct Asset{
+    char path[128];
+    AssetType type;
+    SDL_atomic_t state;     // AssetState (로더 스레드와 같이 씀)
+    int refCount;           // assetLock
+    SDL_Surface *surface;   // 디코딩된 이미지 (업로드 전까지)
+    SDL_Texture *texture;
+    cJSON *json;
+} Asset;
+
+Asset assets[MAX_ASSETS];
+SDL_SpinLock assetLock;
+
+// 로더 스레드에 넘길 요청 큐 (assetLock을 잡은 쪽만 넣고 로더만 꺼냄)
+AssetHandle assetQueue[ASSET_QUEUE_SIZE];
+SDL_atomic_t assetQueueHead;  // 로더가 꺼낼 위치
+SDL_atomic_t assetQueueTail;  // 요청하는 쪽이 넣을 위치
+SDL_sem *assetSemaphore = NULL;
+SDL_Thread *assetLoader = NULL;
+SDL_atomic_t assetLoaderRunning;
+
+// 로더가 에셋을 하나 끝낼 때마다 깨움 (그 자리에서 에셋을 기다리는 쪽이 코어를 돌리며 기다리지 않도록)
+SDL_mutex *assetDoneMutex = NULL;
+SDL_cond *assetDoneCondition = NULL;
+
+static void decodeAsset(Asset *asset){
+    Uint64 start = SDL_GetPerformanceCounter();
+    if(asset->type == ASSET_TEXTURE && renderer == NULL){
+        SDL_AtomicSet(&asset->state, ASSET_FAILED); // 렌더러가 없으면 (시뮬레이션) 이미지는 읽지 않음
+        return;
+    }
+    if(asset->type == ASSET_TEXTURE){
+        asset->surface = IMG_Load_RW(openAssetFile(asset->path), 1);
+        recordIOEvent("load", asset->path, start);
+        if(asset->surface == NULL){
+            LOG_ERROR(LOG_ASSET, "Failed to load image %s: %s", asset->path, IMG_GetError());
+            SDL_AtomicSet(&asset->state, ASSET_FAILED);
+            return;
+        }
+        SDL_AtomicSet(&asset->state, ASSET_DECODED); // 텍스처는 메인 스레드에서
+    }
+    else{
+        char *data = readFile(asset->path);
+        asset->json = data != NULL ? cJSON_Parse(data) : NULL;
+        MEM_FREE(data);
+        recordIOEvent("load", asset->path, start);
+        if(asset->json == NULL){
+            LOG_ERROR(LOG_ASSET, "Failed to load JSON %s", asset->path);
+            SDL_AtomicSet(&asset->state, ASSET_FAILED);
+            return;
+        }
+        SDL_AtomicSet(&asset->state, ASSET_READY);
+    }
+}
+
+static int assetLoaderThread(void *data){
+    while(SDL_AtomicGet(&assetLoaderRunning)){
+        int head = SDL_AtomicGet(&assetQueueHead);
+        if(head == SDL_AtomicGet(&assetQueueTail)){
+            SDL_SemWaitTimeout(assetSemaphore, 100);
+            continue;
+        }
+
+        Asset *asset = &assets[assetQueue[head & (ASSET_QUEUE_SIZE - 1)] - 1];
+        SDL_AtomicSet(&assetQueueHead, head + 1);
+        if(SDL_AtomicCAS(&asset->state, ASSET_QUEUED, ASSET_LOADING)){
+            decodeAsset(asset);
+            // 상태를 바꾼 뒤 뮤텍스를 잡고 깨우므로, 상태를 확인하고 잠드는 쪽이 신호를 놓치지 않음
+            SDL_LockMutex(assetDoneMutex);
+            SDL_CondBroadcast(assetDoneCondition);
+            SDL_UnlockMutex(assetDoneMutex);
+        }
+    }
+    return 0;
+}
+
+void initAssets(){
+    memset(assets, 0, sizeof(assets));
+    SDL_AtomicSet(&assetQueueHead, 0);
+    SDL_AtomicSet(&assetQueueTail, 0);
+    SDL_AtomicSet(&assetLoaderRunning, 1);
+    assetSemaphore = SDL_CreateSemaphore(0);
+    assetDoneMutex = SDL_CreateMutex();
+    assetDoneCondition = SDL_CreateCond();
+    assetLoader = SDL_CreateThread(assetLoaderThread, "AssetLoader", NULL);
+    if(assetLoader == NULL){
+        LOG_ERROR(LOG_ASSET, "Failed to create asset loader, loading synchronously: %s", SDL_GetError());
+    }
+}
+
+static SDL_bool isAssetInLoader(AssetHandle handle){
+    AssetState state = (AssetState)SDL_AtomicGet(&assets[handle - 1].state);
+    return state == ASSET_QUEUED || state == ASSET_LOADING;
+}
+
+// 로더가 에셋을 끝낼 때까지 최대 timeout ms 잠듦 (handle이 ASSET_NONE이면 아무 에셋이나)
+// 이미 로더에서 나왔으면 (디코딩 끝, 준비, 실패) 바로 반환, 텍스처 업로드는 부르는 쪽이 processAssetUploads로
+void waitForAssetLoader(AssetHandle handle, Uint32 timeout){
+    if(assetLoader == NULL) return; // 로더가 없으면 요청할 때 이미 읽음
+    if(handle < ASSET_NONE || handle > MAX_ASSETS) return;
+
+    SDL_LockMutex(assetDoneMutex);
+    SDL_bool loading = SDL_FALSE;
+    if(handle != ASSET_NONE){
+        loading = isAssetInLoader(handle);
+    }
+    else{
+        for(int i = 1; i <= MAX_ASSETS && !loading; i++) loading = isAssetInLoader(i);
+    }
+    if(loading){
+        SDL_CondWaitTimeout(assetDoneCondition, assetDoneMutex, timeout);
+    }
+    SDL_UnlockMutex(assetDoneMutex);
+}
+
+// 에셋 요청, 핸들 반환 (이미 있으면 참조 횟수만 올림, 가득 차면 ASSET_NONE)
+AssetHandle requestAsset(const char *path, AssetType type){
+    int freeSlot = -1;
+    SDL_AtomicLock(&assetLock);
+    for(int i = 0; i < MAX_ASSETS; i++){
+        if(assets[i].refCount > 0){
+            if(assets[i].type == type && strcmp(assets[i].path, path) == 0){
+                assets[i].refCount++;
+                SDL_AtomicUnlock(&assetLock);
+                return i + 1;
+            }
+        }
+        else if(freeSlot == -1 && SDL_AtomicGet(&assets[i].state) == ASSET_EMPTY){
+            freeSlot = i;
+        }
+    }
+    if(freeSlot == -1){
+        SDL_AtomicUnlock(&assetLock);
+        LOG_WARN(LOG_ASSET, "Asset table is full!");
+        return ASSET_NONE;
+    }
+
+    Asset *asset = &assets[freeSlot];
+    strncpy(asset->path, path, sizeof(asset->path) - 1);
+    asset->path[sizeof(asset->path) - 1] = '\0';
+    asset->type = type;
+    asset->refCount = 1;
+    asset->surface = NULL;
+    asset->texture = NULL;
+    asset->json = NULL;
+    SDL_AtomicSet(&asset->state, ASSET_QUEUED);
+
+    int tail = SDL_AtomicGet(&assetQueueTail);
+    if(assetLoader == NULL || tail - SDL_AtomicGet(&assetQueueHead) >= ASSET_QUEUE_SIZE){
+        // 로더가 없거나 밀려 있으면 그 자리에서 로드 (LOADING인 동안은 아무도 해제하지 않으므로 잠금 없이)
+        SDL_AtomicSet(&asset->state, ASSET_LOADING);
+        SDL_AtomicUnlock(&assetLock);
+        decodeAsset(asset);
+        return freeSlot + 1;
+    }
+    assetQueue[tail & (ASSET_QUEUE_SIZE - 1)] = freeSlot + 1;
+    SDL_AtomicSet(&assetQueueTail, tail + 1);
+    SDL_AtomicUnlock(&assetLock);
+    SDL_SemPost(assetSemaphore);
+    return freeSlot + 1;
+}
+
+AssetState getAssetState(AssetHandle handle){
+    if(handle <= ASSET_NONE || handle > MAX_ASSETS) return ASSET_FAILED;
+    return (AssetState)SDL_AtomicGet(&assets[handle - 1].state);
+}
+
+// 준비됐거나 실패했으면 (더 기다려도 바뀌지 않음)
+SDL_bool isAssetSettled(AssetHandle handle){
+    AssetState state = getAssetState(handle);
+    return state == ASSET_READY || state == ASSET_FAILED;
+}
+
+SDL_Texture *getAssetTexture(AssetHandle handle){
+    if(getAssetState(handle) != ASSET_READY) return NULL;
+    return assets[handle - 1].texture;
+}
+
+cJSON *getAssetJson(AssetHandle handle){
+    if(getAssetState(handle) != ASSET_READY) return NULL;
+    return assets[handle - 1].json;
+}
+
+// 에셋 반납, 아무도 안 쓰면 해제 (로더가 아직 처리 중이면 끝난 뒤 processAssetUploads에서 해제)
+void releaseAsset(AssetHandle handle){
+    if(handle <= ASSET_NONE || handle > MAX_ASSETS) return;
+
+    Asset *asset = &assets[handle - 1];
+    SDL_AtomicLock(&assetLock);
+    if(asset->refCount > 0) asset->refCount--;
+    SDL_AtomicUnlock(&assetLock);
+}
+
+// 텍스처가 차지하는 크기 (RGBA 기준 추정, 할당 추적용)
+static int getTextureBytes(SDL_Texture *texture){
+    int width = 0, height = 0;
+    SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+    return width * height * 4;
+}
+
+static void freeAsset(Asset *asset){
+    if(asset->surface != NULL) SDL_FreeSurface(asset->surface);
+    if(asset->texture != NULL){
+        trackExternal(MEM_TEXTURE, -getTextureBytes(asset->texture));
+        SDL_DestroyTexture(asset->texture);
+    }
+    if(asset->json != NULL) cJSON_Delete(asset->json);
+    asset->surface = NULL;
+    asset->texture = NULL;
+    asset->json = NULL;
+    SDL_AtomicSet(&asset->state, ASSET_EMPTY);
+}
+
+// 프레임마다 호출: 디코딩이 끝난 이미지를 최대 maxUploads개 텍스처로 만들고, 반납된 에셋 해제
+// 이미지는 렌더러가 있을 때만 디코딩되므로 업로드는 렌더러를 가진 메인 스레드에서만 일어남
+void processAssetUploads(int maxUploads){
+    int uploads = 0;
+    for(int i = 0; i < MAX_ASSETS; i++){
+        Asset *asset = &assets[i];
+        AssetState state = (AssetState)SDL_AtomicGet(&asset->state);
+        if(state == ASSET_EMPTY || state == ASSET_QUEUED || state == ASSET_LOADING) continue;
+
+        // 해제와 업로드 시작은 다른 스레드의 요청/반납과 겹치지 않도록 잠금 안에서 정함
+        SDL_AtomicLock(&assetLock);
+        state = (AssetState)SDL_AtomicGet(&asset->state);
+        if(state != ASSET_EMPTY && state != ASSET_QUEUED && state != ASSET_LOADING && asset->refCount <= 0){
+            freeAsset(asset);
+            SDL_AtomicUnlock(&assetLock);
+            continue;
+        }
+        // 업로드하는 동안은 LOADING으로 두어 다른 스레드가 해제하지 않게 함
+        SDL_bool upload = state == ASSET_DECODED && uploads < maxUploads && SDL_AtomicCAS(&asset->state, ASSET_DECODED, ASSET_LOADING);
+        SDL_AtomicUnlock(&assetLock);
+
+        if(upload){
+            Uint64 start = SDL_GetPerformanceCounter();
+            asset->texture = SDL_CreateTextureFromSurface(renderer, asset->surface);
+            if(asset->texture != NULL) trackExternal(MEM_TEXTURE, getTextureBytes(asset->texture));
+            SDL_FreeSurface(asset->surface);
+            asset->surface = NULL;
+            recordIOEvent("upload", asset->path, start);
+            SDL_AtomicSet(&asset->state, asset->texture != NULL ? ASSET_READY : ASSET_FAILED);
+            uploads++;
+        }
+    }
+}
+
+// 이미 올라온 JSON 에셋을 파일에서 다시 읽어 교체 (핫 리로드용, 메인 스레드에서 프레임 사이에 호출)
+// 그 경로의 JSON 에셋이 준비된 상태로 있고 새로 파싱에 성공하면 SDL_TRUE, 실패하면 예전 내용 유지
+SDL_bool reloadAssetJson(const char *path){
+    for(int i = 0; i < MAX_ASSETS; i++){
+        Asset *asset = &assets[i];
+        if(asset->refCount <= 0 || asset->type != ASSET_JSON || strcmp(asset->path, path) != 0) continue;
+        if(SDL_AtomicGet(&asset->state) != ASSET_READY) return SDL_FALSE; // 읽는 중이면 어차피 새 내용을 읽음
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        char *data = readFile(path);
+        cJSON *json = data != NULL ? cJSON_Parse(data) : NULL;
+        MEM_FREE(data);
+        recordIOEvent("load", path, start);
+        if(json == NULL){
+            LOG_ERROR(LOG_ASSET, "Failed to reload JSON %s", path);
+            return SDL_FALSE;
+        }
+        cJSON_Delete(asset->json);
+        asset->json = json;
+        return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+// 요청한 에셋 중 준비가 끝난 비율 (로딩 화면용)
+float getAssetProgress(){
+    int total = 0, settled = 0;
+    SDL_AtomicLock(&assetLock);
+    for(int i = 0; i < MAX_ASSETS; i++){
+        if(assets[i].refCount <= 0) continue;
+        total++;
+        if(isAssetSettled(i + 1)) settled++;
+    }
+    SDL_AtomicUnlock(&assetLock);
+    return total > 0 ? (float)settled / total : 1.0f;
+}
+
+// 올라와 있는 에셋 수와 아직 준비되지 않은 에셋 수 (텔레메트리용)
+void getAssetCounts(int *resident, int *pending){
+    *resident = 0;
+    *pending = 0;
+    SDL_AtomicLock(&assetLock);
+    for(int i = 0; i < MAX_ASSETS; i++){
+        if(assets[i].refCount <= 0) continue;
+        if(isAssetSettled(i + 1)) (*resident)++;
+        else (*pending)++;
+    }
+    SDL_AtomicUnlock(&assetLock);
+}
+
+void shutdownAssets(){
+    SDL_AtomicSet(&assetLoaderRunning, 0);
+    if(assetLoader != NULL){
+        SDL_SemPost(assetSemaphore);
+        SDL_WaitThread(assetLoader, NULL);
+        assetLoader = NULL;
+    }
+    if(assetSemaphore != NULL){
+        SDL_DestroySemaphore(assetSemaphore);
+        assetSemaphore = NULL;
+    }
+    if(assetDoneCondition != NULL){
+        SDL_DestroyCond(assetDoneCondition);
+        assetDoneCondition = NULL;
+    }
+    if(assetDoneMutex != NULL){
+        SDL_DestroyMutex(assetDoneMutex);
+        assetDoneMutex = NULL;
+    }
+    for(int i = 0; i < MAX_ASSETS; i++){
+        assets[i].refCount = 0;
+        freeAsset(&assets[i]);
+    }
+}
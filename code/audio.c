@@ -0,0 +1,322 @@
+#include "global.h"
+
+// 효과음 등록부와 저지연 오디오 설정
+// 효과음은 로딩 때 장치 포맷으로 변환해 두고(Mix_LoadWAV가 열린 장치 스펙에 맞춰 변환함) 볼륨도 그때 한 번만 적용
+// 이름은 로딩 때만 해시 테이블로 찾아서 SoundID로 바꿔두고, 게임 중 재생은 SoundID로만 함 (문자열 비교 없음)
+#define SOUND_HASH_SIZE 64 // 2의 거듭제곱, 효과음 수의 2배 이상
+
+int soundHashTable[SOUND_HASH_SIZE]; // 이름 해시 -> effects 인덱스 + 1 (0이면 빈칸), 선형 탐사
+
+// 오디오 장치 설정
+int audioBufferSamples = 512;    // 실행 인자 --audiobuffer=N 으로 변경 (작을수록 지연이 짧지만 끊길 수 있음)
+int audioFrequency = 44100;      // 실제로 열린 장치 주파수
+float audioBufferLatency = 0.0f; // 버퍼 한 개 길이 (ms)
+
+// 재생 요청 -> 믹서가 처음 그 소리를 섞기까지의 지연 측정 (오디오 스레드가 씀)
+SDL_atomic_t pendingSoundTime;   // 아직 믹서가 처리하지 않은 가장 오래된 재생 요청 시각 (0이면 없음)
+SDL_atomic_t soundLatencyLast;   // ms
+
+// 보이스(채널) 관리: 채널마다 어떤 소리를 언제 틀었는지 기록해두고 상한/우선순위로 배정
+SoundID voiceSound[MAX_VOICES];    // 채널에서 재생 중인(또는 마지막으로 재생한) 소리
+Uint32 voiceStartTime[MAX_VOICES];
+int voicesDropped = 0;             // 상한/간격/우선순위 때문에 재생하지 않은 횟수
+int voicesStolen = 0;              // 재생 중인 소리를 끊고 채널을 넘겨준 횟수
+
+// 처음 재생할 때 디코딩하는 소리(OGG/Opus 등)의 PCM 캐시
+int soundCacheBudget = 4 * 1024 * 1024; // 실행 인자 --soundcache=KB 로 변경
+int soundCacheBytes = 0;                // 지금 캐시에 올라간 PCM 크기
+
+SoundID doorBellSound = SOUND_NONE;
+SoundID cashSound = SOUND_NONE;
+SoundID canselSound = SOUND_NONE;
+
+// FNV-1a
+static Uint32 hashSoundName(const char *name){
+    Uint32 hash = 2166136261u;
+    for(; *name; name++){
+        hash ^= (Uint8)*name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 믹서가 한 버퍼를 다 섞을 때마다 오디오 스레드에서 호출됨
+static void audioPostMix(void *data, Uint8 *stream, int length){
+    int requested = SDL_AtomicGet(&pendingSoundTime);
+    if(requested != 0 && SDL_AtomicCAS(&pendingSoundTime, requested, 0)){
+        SDL_AtomicSet(&soundLatencyLast, (int)(SDL_GetTicks() - (Uint32)requested));
+    }
+}
+
+// 오디오 장치 열기, 작은 버퍼가 안 되는 장치면 기본 크기로 다시 시도
+int openAudioDevice(){
+    // 청크 크기는 2의 거듭제곱이어야 함
+    int samples = 256;
+    while(samples < audioBufferSamples && samples < 8192) samples <<= 1;
+
+    if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, samples) < 0){
+        LOG_ERROR(LOG_AUDIO, "Failed to open audio with %d samples: %s", samples, Mix_GetError());
+        samples = 4096;
+        if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, samples) < 0){
+            return -1;
+        }
+    }
+    audioBufferSamples = samples;
+
+    Uint16 format;
+    int channels;
+    Mix_QuerySpec(&audioFrequency, &format, &channels);
+    audioBufferLatency = audioBufferSamples * 1000.0f / audioFrequency;
+    LOG_INFO(LOG_AUDIO, "Audio opened: %d Hz, %d samples buffer (%.1f ms)", audioFrequency, audioBufferSamples, audioBufferLatency);
+
+    for(int i = 0; i < SOUND_HASH_SIZE; i++){
+        soundHashTable[i] = 0;
+    }
+    SDL_AtomicSet(&pendingSoundTime, 0);
+    SDL_AtomicSet(&soundLatencyLast, 0);
+    Mix_SetPostMix(audioPostMix, NULL);
+
+    Mix_AllocateChannels(MAX_VOICES);
+    for(int i = 0; i < MAX_VOICES; i++){
+        voiceSound[i] = SOUND_NONE;
+        voiceStartTime[i] = 0;
+    }
+    return 0;
+}
+
+// 해시 테이블에 이름 등록
+static SoundID registerSoundName(int index){
+    Uint32 slot = hashSoundName(soundManager.effects[index].name) & (SOUND_HASH_SIZE - 1);
+    while(soundHashTable[slot] != 0){
+        slot = (slot + 1) & (SOUND_HASH_SIZE - 1);
+    }
+    soundHashTable[slot] = index + 1;
+    return index + 1;
+}
+
+// 이름으로 SoundID 찾기 (로딩 때만 호출, 없으면 SOUND_NONE)
+SoundID findSound(const char *name){
+    if(name == NULL || name[0] == '\0') return SOUND_NONE;
+
+    Uint32 slot = hashSoundName(name) & (SOUND_HASH_SIZE - 1);
+    while(soundHashTable[slot] != 0){
+        int index = soundHashTable[slot] - 1;
+        if(strcmp(soundManager.effects[index].name, name) == 0){
+            return index + 1;
+        }
+        slot = (slot + 1) & (SOUND_HASH_SIZE - 1);
+    }
+    LOG_WARN(LOG_AUDIO, "Sound effect not found: %s", name);
+    return SOUND_NONE;
+}
+
+// 사운드 효과 로드, 재생할 때 쓸 SoundID 반환
+SoundID loadSoundEffect(const char *filePath, const char *name, int volume){
+    if (soundManager.effectCount >= (int)SDL_arraysize(soundManager.effects)) {
+        LOG_WARN(LOG_AUDIO, "Sound Manager is full!");
+        return SOUND_NONE;
+    }
+
+    Mix_Chunk *chunk = Mix_LoadWAV_RW(openAssetFile(filePath), 1);
+    if (!chunk) {
+        LOG_ERROR(LOG_AUDIO, "Failed to load sound: %s", Mix_GetError());
+        return SOUND_NONE;
+    }
+    Mix_VolumeChunk(chunk, volume); // 재생할 때마다 설정하지 않도록 미리 적용
+    trackExternal(MEM_AUDIO, (int)chunk->alen);
+
+    int index = soundManager.effectCount++;
+    SoundEffect *effect = &soundManager.effects[index];
+    effect->chunk = chunk;
+    strncpy(effect->name, name, sizeof(effect->name) - 1);
+    effect->name[sizeof(effect->name) - 1] = '\0';
+    effect->volume = volume;
+    effect->maxInstances = 4;
+    effect->priority = 1;
+    effect->minInterval = 0;
+    effect->lastPlayTime = 0;
+    effect->path[0] = '\0';
+    effect->lastUseTime = 0;
+
+    return registerSoundName(index);
+}
+
+// 압축된 소리 등록: 지금은 경로만 기억하고 처음 재생할 때 PCM으로 디코딩 (시작할 때 디코딩으로 멈추지 않음)
+SoundID registerCompressedSound(const char *filePath, const char *name, int volume){
+    if (soundManager.effectCount >= (int)SDL_arraysize(soundManager.effects)) {
+        LOG_WARN(LOG_AUDIO, "Sound Manager is full!");
+        return SOUND_NONE;
+    }
+
+    int index = soundManager.effectCount++;
+    SoundEffect *effect = &soundManager.effects[index];
+    effect->chunk = NULL;
+    strncpy(effect->name, name, sizeof(effect->name) - 1);
+    effect->name[sizeof(effect->name) - 1] = '\0';
+    strncpy(effect->path, filePath, sizeof(effect->path) - 1);
+    effect->path[sizeof(effect->path) - 1] = '\0';
+    effect->volume = volume;
+    effect->maxInstances = 4;
+    effect->priority = 1;
+    effect->minInterval = 0;
+    effect->lastPlayTime = 0;
+    effect->lastUseTime = 0;
+
+    return registerSoundName(index);
+}
+
+static SDL_bool isSoundPlaying(SoundID sound){
+    for(int i = 0; i < MAX_VOICES; i++){
+        if(voiceSound[i] == sound && Mix_Playing(i)) return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+// 캐시가 예산을 넘으면 가장 오래 안 쓴 소리부터 PCM 해제 (재생 중인 것은 건너뜀)
+static void trimSoundCache(SoundID keep){
+    while(soundCacheBytes > soundCacheBudget){
+        int oldest = -1;
+        for(int i = 0; i < soundManager.effectCount; i++){
+            SoundEffect *effect = &soundManager.effects[i];
+            if(effect->path[0] == '\0' || effect->chunk == NULL || i + 1 == keep || isSoundPlaying(i + 1)) continue;
+            if(oldest == -1 || effect->lastUseTime < soundManager.effects[oldest].lastUseTime) oldest = i;
+        }
+        if(oldest == -1) return; // 더 뺄 수 있는 게 없음
+
+        SoundEffect *effect = &soundManager.effects[oldest];
+        soundCacheBytes -= effect->chunk->alen;
+        trackExternal(MEM_AUDIO, -(int)effect->chunk->alen);
+        Mix_FreeChunk(effect->chunk);
+        effect->chunk = NULL;
+    }
+}
+
+// 압축된 소리면 필요할 때 디코딩해서 캐시에 올림
+static Mix_Chunk *getSoundChunk(SoundID sound){
+    SoundEffect *effect = &soundManager.effects[sound - 1];
+    effect->lastUseTime = SDL_GetTicks();
+    if(effect->chunk != NULL || effect->path[0] == '\0') return effect->chunk;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    effect->chunk = Mix_LoadWAV_RW(openAssetFile(effect->path), 1); // OGG/Opus도 장치 포맷 PCM으로 디코딩됨
+    recordIOEvent("decode", effect->path, start);
+    if(effect->chunk == NULL){
+        LOG_ERROR(LOG_AUDIO, "Failed to decode sound %s: %s", effect->path, Mix_GetError());
+        effect->path[0] = '\0'; // 매번 다시 시도하지 않도록
+        return NULL;
+    }
+    Mix_VolumeChunk(effect->chunk, effect->volume);
+    soundCacheBytes += effect->chunk->alen;
+    trackExternal(MEM_AUDIO, (int)effect->chunk->alen);
+    trimSoundCache(sound);
+    return effect->chunk;
+}
+
+// 소리별 동시 재생 상한, 우선순위, 최소 재생 간격 설정
+void setSoundVoiceLimit(SoundID sound, int maxInstances, int priority, Uint32 minInterval){
+    if(sound <= SOUND_NONE || sound > soundManager.effectCount) return;
+
+    SoundEffect *effect = &soundManager.effects[sound - 1];
+    effect->maxInstances = maxInstances < 1 ? 1 : maxInstances;
+    effect->priority = priority;
+    effect->minInterval = minInterval;
+}
+
+// 재생할 채널 고르기 (-1이면 재생하지 않음)
+static int allocateVoice(SoundID sound){
+    SoundEffect *effect = &soundManager.effects[sound - 1];
+    int instances = 0;
+    int oldestSame = -1;     // 같은 소리 중 가장 오래된 채널
+    int freeVoice = -1;
+    int victim = -1;         // 우선순위가 같거나 낮은 소리 중 (우선순위 낮은 것, 그중 오래된 것)
+
+    for(int i = 0; i < MAX_VOICES; i++){
+        if(!Mix_Playing(i)){
+            if(freeVoice == -1) freeVoice = i;
+            continue;
+        }
+
+        if(voiceSound[i] == sound){
+            instances++;
+            if(oldestSame == -1 || voiceStartTime[i] < voiceStartTime[oldestSame]) oldestSame = i;
+        }
+
+        int priority = voiceSound[i] != SOUND_NONE ? soundManager.effects[voiceSound[i] - 1].priority : 0;
+        if(priority <= effect->priority){
+            int victimPriority = victim != -1 && voiceSound[victim] != SOUND_NONE ? soundManager.effects[voiceSound[victim] - 1].priority : 0;
+            if(victim == -1 || priority < victimPriority || (priority == victimPriority && voiceStartTime[i] < voiceStartTime[victim])){
+                victim = i;
+            }
+        }
+    }
+
+    // 상한에 걸리면 같은 소리의 가장 오래된 것을 끊고 그 채널을 씀 (연타해도 섞는 개수는 그대로)
+    if(instances >= effect->maxInstances){
+        Mix_HaltChannel(oldestSame);
+        voicesStolen++;
+        return oldestSame;
+    }
+    if(freeVoice != -1) return freeVoice;
+
+    // 빈 채널이 없으면 더 중요하지 않은 소리를 뺏음
+    if(victim != -1){
+        Mix_HaltChannel(victim);
+        voicesStolen++;
+        return victim;
+    }
+    return -1;
+}
+
+// 사운드 효과 재생
+void playSoundEffect(SoundID sound){
+    if(sound <= SOUND_NONE || sound > soundManager.effectCount) return;
+
+    SoundEffect *effect = &soundManager.effects[sound - 1];
+    Uint32 currentTime = SDL_GetTicks();
+    if(effect->lastPlayTime != 0 && currentTime - effect->lastPlayTime < effect->minInterval){
+        voicesDropped++; // 너무 빨리 다시 요청됨
+        return;
+    }
+
+    Mix_Chunk *chunk = getSoundChunk(sound);
+    if(chunk == NULL) return;
+
+    int voice = allocateVoice(sound);
+    if(voice == -1){
+        voicesDropped++; // 모든 채널이 더 중요한 소리로 차 있음
+        return;
+    }
+
+    SDL_AtomicCAS(&pendingSoundTime, 0, (int)(currentTime | 1)); // 처음 요청만 기록 (0은 '없음'이라 피함)
+    Mix_PlayChannel(voice, chunk, 0);  // 반복 없음
+    voiceSound[voice] = sound;
+    voiceStartTime[voice] = currentTime;
+    effect->lastPlayTime = currentTime;
+}
+
+// 게임 로직에서 내는 효과음 (소리가 꺼진 판, 예를 들어 시뮬레이션에서는 아무것도 하지 않음)
+void playGameSound(GameContext *game, SoundID sound){
+    if(game->audioEnabled) playSoundEffect(sound);
+}
+
+// 측정된 재생 지연 (요청 -> 믹싱 + 버퍼 한 개 출력 시간)
+float getSoundLatency(){
+    return SDL_AtomicGet(&soundLatencyLast) + audioBufferLatency;
+}
+
+// SoundManager의 모든 사운드 해제
+void freeSoundEffects(){
+    Mix_SetPostMix(NULL, NULL);
+    for (int i = 0; i < soundManager.effectCount; ++i) {
+        if(soundManager.effects[i].chunk != NULL){
+            trackExternal(MEM_AUDIO, -(int)soundManager.effects[i].chunk->alen);
+            Mix_FreeChunk(soundManager.effects[i].chunk);
+        }
+        soundManager.effects[i].chunk = NULL;
+    }
+    soundManager.effectCount = 0;
+    soundCacheBytes = 0;
+    for(int i = 0; i < SOUND_HASH_SIZE; i++){
+        soundHashTable[i] = 0;
+    }
+}
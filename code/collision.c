@@ -0,0 +1,335 @@
+#include "global.h"
+#include <math.h>
+
+// 플랫폼 충돌 검색용 BVH (bounding volume hierarchy)
+// 맵 로딩이 끝난 뒤 한 번 만들고, 물리 틱마다 플레이어 주변 플랫폼만 골라내는 데 사용
+#define BVH_LEAF_SIZE 4   // 리프 노드 하나에 담을 최대 플랫폼 수
+#define BVH_STACK_SIZE 64 // 순회용 스택 크기 (균형 트리라서 깊이는 log2(N) 수준)
+
+typedef struct PlatformBVHNode{
+    float minX, minY, maxX, maxY; // 노드에 포함된 플랫폼 전체의 바운딩 박스
+    int left, right;              // 자식 노드 인덱스 (리프면 -1)
+    int first, count;             // 리프일 때 platformBVHIndices 안의 범위
+} PlatformBVHNode;
+
+PlatformBVHNode platformBVH[MAX_PLATFORMCOUNT * 2];
+int platformBVHIndices[MAX_PLATFORMCOUNT];
+int platformBVHNodeCount = 0;
+
+static float platformCenter(int index, int axis){
+    return axis == 0 ? platforms[index].x + platforms[index].width * 0.5f
+                     : platforms[index].y + platforms[index].height * 0.5f;
+}
+
+typedef struct BVHSortKey{
+    float center;
+    int index;
+} BVHSortKey;
+
+BVHSortKey bvhSortKeys[MAX_PLATFORMCOUNT]; // 노드 분할용 정렬 공간 (BVH는 메인 스레드에서만 만듦)
+
+static int compareBVHSortKey(const void *a, const void *b){
+    const BVHSortKey *keyA = a, *keyB = b;
+    if(keyA->center != keyB->center) return (keyA->center > keyB->center) - (keyA->center < keyB->center);
+    return keyA->index - keyB->index;
+}
+
+// [first, first + count) 범위의 플랫폼으로 노드를 만들고 긴 축의 중앙값 기준으로 재귀 분할
+static int buildBVHNode(int first, int count){
+    int nodeIndex = platformBVHNodeCount++;
+    PlatformBVHNode *node = &platformBVH[nodeIndex];
+
+    node->minX = node->minY = INFINITY;
+    node->maxX = node->maxY = -INFINITY;
+    for(int i = first; i < first + count; i++){
+        Platform *p = &platforms[platformBVHIndices[i]];
+        if(p->x < node->minX) node->minX = p->x;
+        if(p->y < node->minY) node->minY = p->y;
+        if(p->x + p->width > node->maxX) node->maxX = p->x + p->width;
+        if(p->y + p->height > node->maxY) node->maxY = p->y + p->height;
+    }
+
+    node->left = node->right = -1;
+    node->first = first;
+    node->count = count;
+    if(count <= BVH_LEAF_SIZE) return nodeIndex;
+
+    // 중심점 기준으로 정렬 (핫 리로드 때마다 다시 만들므로 qsort, 같은 중심이면 인덱스 순으로 해서 결과를 고정)
+    int axis = (node->maxX - node->minX) >= (node->maxY - node->minY) ? 0 : 1;
+    for(int i = 0; i < count; i++){
+        bvhSortKeys[i].center = platformCenter(platformBVHIndices[first + i], axis);
+        bvhSortKeys[i].index = platformBVHIndices[first + i];
+    }
+    qsort(bvhSortKeys, count, sizeof(BVHSortKey), compareBVHSortKey);
+    for(int i = 0; i < count; i++){
+        platformBVHIndices[first + i] = bvhSortKeys[i].index;
+    }
+
+    int half = count / 2;
+    int left = buildBVHNode(first, half);
+    int right = buildBVHNode(first + half, count - half);
+
+    node->left = left;
+    node->right = right;
+    node->count = 0;
+    return nodeIndex;
+}
+
+void buildPlatformBVH(){
+    platformBVHNodeCount = 0;
+    if(platformCount <= 0) return;
+
+    for(int i = 0; i < platformCount; i++){
+        platformBVHIndices[i] = i;
+    }
+    buildBVHNode(0, platformCount);
+    LOG_INFO(LOG_MAP, "Platform BVH built: %d platforms (%d polygon pieces), %d nodes", platformCount, polygonPlatformCount, platformBVHNodeCount);
+}
+
+// 주어진 영역과 바운딩 박스가 겹치는 플랫폼마다 visit 호출 (개수 제한 없음, 여러 워커가 동시에 불러도 됨)
+void queryPlatformBVH(float minX, float minY, float maxX, float maxY, PlatformVisitor visit, void *data){
+    int stack[BVH_STACK_SIZE];
+    int stackSize = 0;
+
+    if(platformBVHNodeCount == 0) return;
+    stack[stackSize++] = 0;
+
+    while(stackSize > 0){
+        PlatformBVHNode *node = &platformBVH[stack[--stackSize]];
+        if(node->maxX < minX || node->minX > maxX || node->maxY < minY || node->minY > maxY) continue;
+
+        if(node->left == -1){
+            for(int i = node->first; i < node->first + node->count; i++){
+                Platform *p = &platforms[platformBVHIndices[i]];
+                if(p->x + p->width < minX || p->x > maxX || p->y + p->height < minY || p->y > maxY) continue;
+                visit(platformBVHIndices[i], data);
+            }
+        }
+        else if(stackSize + 2 <= BVH_STACK_SIZE){
+            stack[stackSize++] = node->left;
+            stack[stackSize++] = node->right;
+        }
+        else{
+            // 중앙값 분할이라 깊이는 log2(MAX_PLATFORMCOUNT) + 1 이하, 스택은 깊이 + 1칸이면 충분하므로 여기 오면 트리가 망가진 것
+            SDL_assert(!"platform BVH stack overflow");
+        }
+    }
+}
+
+// 플레이어 박스와 볼록 다각형(또는 선분) 조각의 분리축 검사 (SAT)
+// 겹치면 박스를 밀어낼 최소 이동 벡터(MTV)를 pushX, pushY에 저장
+SDL_bool collideBoxPolygon(float boxX, float boxY, float boxW, float boxH, const Platform *platform, float *pushX, float *pushY){
+    int n = platform->pointCount;
+    if(n < 2) return SDL_FALSE;
+
+    float halfW = boxW * 0.5f;
+    float halfH = boxH * 0.5f;
+    float centerX = boxX + halfW;
+    float centerY = boxY + halfH;
+
+    float polygonCenterX = 0.0f, polygonCenterY = 0.0f;
+    for(int i = 0; i < n; i++){
+        polygonCenterX += platform->polygon[i].x;
+        polygonCenterY += platform->polygon[i].y;
+    }
+    polygonCenterX /= n;
+    polygonCenterY /= n;
+
+    float minOverlap = INFINITY;
+    float axisX = 0.0f, axisY = 0.0f;
+
+    // 검사할 축: 박스의 x, y축 + 다각형의 각 변 법선 (선분은 변이 하나)
+    int edgeCount = (n == 2) ? 1 : n;
+    for(int a = 0; a < edgeCount + 2; a++){
+        float nx, ny;
+        if(a == 0){ nx = 1.0f; ny = 0.0f; }
+        else if(a == 1){ nx = 0.0f; ny = 1.0f; }
+        else{
+            const SDL_Point *p0 = &platform->polygon[a - 2];
+            const SDL_Point *p1 = &platform->polygon[(a - 1) % n];
+            nx = -(float)(p1->y - p0->y);
+            ny = (float)(p1->x - p0->x);
+            float length = sqrtf(nx * nx + ny * ny);
+            if(length == 0.0f) continue;
+            nx /= length;
+            ny /= length;
+        }
+
+        // 박스 투영: 중심 ± 반지름
+        float boxCenter = centerX * nx + centerY * ny;
+        float radius = fabsf(nx) * halfW + fabsf(ny) * halfH;
+
+        // 다각형 투영
+        float polygonMin = INFINITY, polygonMax = -INFINITY;
+        for(int i = 0; i < n; i++){
+            float projection = platform->polygon[i].x * nx + platform->polygon[i].y * ny;
+            if(projection < polygonMin) polygonMin = projection;
+            if(projection > polygonMax) polygonMax = projection;
+        }
+
+        float overlap = fminf(boxCenter + radius, polygonMax) - fmaxf(boxCenter - radius, polygonMin);
+        if(overlap <= 0.0f) return SDL_FALSE; // 분리축 발견, 충돌 없음
+
+        if(overlap < minOverlap){
+            minOverlap = overlap;
+            // 박스가 다각형 바깥쪽으로 밀려나도록 방향 맞추기
+            if(boxCenter < polygonCenterX * nx + polygonCenterY * ny){
+                nx = -nx;
+                ny = -ny;
+            }
+            axisX = nx;
+            axisY = ny;
+        }
+    }
+
+    *pushX = axisX * minOverlap;
+    *pushY = axisY * minOverlap;
+    return SDL_TRUE;
+}
+
+// 외적 (o->a, o->b), 양수면 반시계 방향 꺾임
+static float cross2D(float ox, float oy, float ax, float ay, float bx, float by){
+    return (ax - ox) * (by - oy) - (ay - oy) * (bx - ox);
+}
+
+// 인덱스 목록으로 주어진 다각형이 (반시계 기준) 볼록한지 검사, 일직선 점은 허용
+static SDL_bool isConvexIndexed(const float *px, const float *py, const int *indices, int n){
+    for(int i = 0; i < n; i++){
+        int a = indices[i], b = indices[(i + 1) % n], c = indices[(i + 2) % n];
+        if(cross2D(px[a], py[a], px[b], py[b], px[c], py[c]) < -0.001f) return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool pointInTriangle(float x, float y, float ax, float ay, float bx, float by, float cx, float cy){
+    return cross2D(ax, ay, bx, by, x, y) >= 0 &&
+           cross2D(bx, by, cx, cy, x, y) >= 0 &&
+           cross2D(cx, cy, ax, ay, x, y) >= 0;
+}
+
+// 공유 변이 있으면 두 조각을 합친 결과를 merged에 넣고 크기를 반환 (없으면 0)
+static int mergePieces(const int *a, int na, const int *b, int nb, int *merged){
+    for(int i = 0; i < na; i++){
+        for(int j = 0; j < nb; j++){
+            // a의 변 (a[i] -> a[i+1]) 과 b의 변 (b[j] -> b[j+1]) 이 반대 방향으로 겹치는지
+            if(a[i] != b[(j + 1) % nb] || a[(i + 1) % na] != b[j]) continue;
+
+            int count = 0;
+            for(int k = 1; k <= na; k++){
+                merged[count++] = a[(i + k) % na];
+            }
+            for(int k = 2; k < nb; k++){
+                merged[count++] = b[(j + k) % nb];
+            }
+            return count;
+        }
+    }
+    return 0;
+}
+
+// 오목 다각형을 귀 자르기(ear clipping)로 삼각형 분할한 뒤, 볼록성이 유지되는 한 이웃 조각끼리 합쳐서 등록
+// 점은 이미 월드 좌표(3배 확대 포함)여야 함
+void decomposePolygon(const float *px, const float *py, int n){
+    int order[MAX_SHAPE_POINTS];
+    int pieces[MAX_SHAPE_POINTS][MAX_POLYGON_POINTS];
+    int pieceSize[MAX_SHAPE_POINTS];
+    int pieceCount = 0;
+
+    if(n < 3 || n > MAX_SHAPE_POINTS) return;
+
+    // 반시계 방향으로 정렬 (신발끈 공식으로 방향 판별)
+    float area = 0.0f;
+    for(int i = 0; i < n; i++){
+        int j = (i + 1) % n;
+        area += px[i] * py[j] - px[j] * py[i];
+    }
+    for(int i = 0; i < n; i++){
+        order[i] = area >= 0 ? i : n - 1 - i;
+    }
+
+    // 이미 볼록하면 통째로 등록
+    if(n <= MAX_POLYGON_POINTS && isConvexIndexed(px, py, order, n)){
+        float convexX[MAX_POLYGON_POINTS], convexY[MAX_POLYGON_POINTS];
+        for(int i = 0; i < n; i++){
+            convexX[i] = px[order[i]];
+            convexY[i] = py[order[i]];
+        }
+        addConvexPlatform(convexX, convexY, n);
+        return;
+    }
+
+    // 귀 자르기
+    int remaining = n;
+    int guard = n * n; // 자기 교차 같은 잘못된 다각형에서 무한 루프 방지
+    int i = 0;
+    while(remaining > 3 && guard-- > 0){
+        int prev = order[(i + remaining - 1) % remaining];
+        int curr = order[i % remaining];
+        int next = order[(i + 1) % remaining];
+
+        SDL_bool isEar = cross2D(px[prev], py[prev], px[curr], py[curr], px[next], py[next]) > 0;
+        for(int k = 0; k < remaining && isEar; k++){
+            int other = order[k];
+            if(other == prev || other == curr || other == next) continue;
+            if(pointInTriangle(px[other], py[other], px[prev], py[prev], px[curr], py[curr], px[next], py[next])){
+                isEar = SDL_FALSE;
+            }
+        }
+
+        if(isEar){
+            pieces[pieceCount][0] = prev;
+            pieces[pieceCount][1] = curr;
+            pieces[pieceCount][2] = next;
+            pieceSize[pieceCount++] = 3;
+
+            for(int k = i % remaining; k < remaining - 1; k++){
+                order[k] = order[k + 1];
+            }
+            remaining--;
+            i = 0;
+        }
+        else{
+            i = (i + 1) % remaining;
+        }
+    }
+    if(remaining == 3){
+        pieces[pieceCount][0] = order[0];
+        pieces[pieceCount][1] = order[1];
+        pieces[pieceCount][2] = order[2];
+        pieceSize[pieceCount++] = 3;
+    }
+    else{
+        LOG_WARN(LOG_MAP, "Polygon decomposition failed (self-intersecting?), %d points left", remaining);
+    }
+
+    // 삼각형끼리 합쳐서 조각 수와 내부 변을 줄임 (내부 변에 걸려 옆으로 밀리는 현상 방지)
+    SDL_bool merged = SDL_TRUE;
+    while(merged){
+        merged = SDL_FALSE;
+        for(int a = 0; a < pieceCount && !merged; a++){
+            for(int b = a + 1; b < pieceCount && !merged; b++){
+                if(pieceSize[a] + pieceSize[b] - 2 > MAX_POLYGON_POINTS) continue;
+
+                int candidate[MAX_POLYGON_POINTS * 2];
+                int size = mergePieces(pieces[a], pieceSize[a], pieces[b], pieceSize[b], candidate);
+                if(size == 0 || !isConvexIndexed(px, py, candidate, size)) continue;
+
+                memcpy(pieces[a], candidate, sizeof(int) * size);
+                pieceSize[a] = size;
+                memmove(pieces[b], pieces[pieceCount - 1], sizeof(int) * pieceSize[pieceCount - 1]); // 마지막 조각을 b 자리로 옮김
+                pieceSize[b] = pieceSize[pieceCount - 1];
+                pieceCount--;
+                merged = SDL_TRUE;
+            }
+        }
+    }
+
+    for(int p = 0; p < pieceCount; p++){
+        float convexX[MAX_POLYGON_POINTS], convexY[MAX_POLYGON_POINTS];
+        for(int k = 0; k < pieceSize[p]; k++){
+            convexX[k] = px[pieces[p][k]];
+            convexY[k] = py[pieces[p][k]];
+        }
+        addConvexPlatform(convexX, convexY, pieceSize[p]);
+    }
+}
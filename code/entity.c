@@ -0,0 +1,184 @@
+#include "global.h"
+
+// 엔티티 저장소 (NPC, 소품 등 플레이어 외의 움직이는 것들)
+// 컴포넌트별로 배열을 따로 두는 구조(SoA)라서 시스템마다 필요한 배열만 순서대로 읽음
+// 삭제는 마지막 원소를 빈자리로 옮기는 방식이라 배열에 구멍이 생기지 않음
+// 저장소는 GameContext마다 (WorldState.entities), 맵에서 읽은 배치 지점은 모든 판이 같이 씀
+#define ENTITY_WANDER_SPEED 90.0f // NPC 배회 속도 (픽셀/초)
+
+SDL_Texture *npcSpriteSheet = NULL;
+SDL_FPoint npcSpawnPoints[MAX_NPC_SPAWNS];
+int npcSpawnCount = 0;
+
+// xorshift 난수
+static Uint32 nextRandom(Uint32 *state){
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// 생성용 난수 (판마다 따로, 그 판을 돌리는 스레드 전용)
+static Uint32 entityRandom(GameContext *game){
+    return nextRandom(&game->randomState);
+}
+
+// 엔티티 추가, 인덱스 반환 (가득 차면 -1)
+int spawnEntity(GameContext *game, float x, float y, float w, float h, SDL_Texture *sprite){
+    EntityStore *entities = &game->world.entities;
+    if(entities->count >= MAX_ENTITYCOUNT){
+        LOG_WARN(LOG_CORE, "Maximum entity limit reached.");
+        return -1;
+    }
+
+    int i = entities->count++;
+    entities->x[i] = entities->previousX[i] = x;
+    entities->y[i] = entities->previousY[i] = y;
+    entities->velocityX[i] = 0.0f;
+    entities->velocityY[i] = 0.0f;
+    entities->width[i] = w;
+    entities->height[i] = h;
+    entities->sprite[i] = sprite;
+    entities->direction[i] = 1;
+    entities->isMoving[i] = 0;
+    entities->frame[i] = entityRandom(game) % 8;  // 다 같이 똑같이 움직이지 않도록 프레임을 흩어둠
+    entities->nextFrameTime[i] = 0;
+    entities->wanderTime[i] = 0.0f;
+    entities->randomState[i] = entityRandom(game) | 1; // 0이면 xorshift가 멈춤
+    return i;
+}
+
+// 엔티티 삭제 (마지막 엔티티를 빈자리로 옮김, 인덱스는 안정적이지 않음)
+void removeEntity(GameContext *game, int index){
+    EntityStore *entities = &game->world.entities;
+    if(index < 0 || index >= entities->count) return;
+
+    int last = --entities->count;
+    if(index == last) return;
+
+    entities->x[index] = entities->x[last];
+    entities->y[index] = entities->y[last];
+    entities->previousX[index] = entities->previousX[last];
+    entities->previousY[index] = entities->previousY[last];
+    entities->velocityX[index] = entities->velocityX[last];
+    entities->velocityY[index] = entities->velocityY[last];
+    entities->width[index] = entities->width[last];
+    entities->height[index] = entities->height[last];
+    entities->sprite[index] = entities->sprite[last];
+    entities->direction[index] = entities->direction[last];
+    entities->isMoving[index] = entities->isMoving[last];
+    entities->frame[index] = entities->frame[last];
+    entities->nextFrameTime[index] = entities->nextFrameTime[last];
+    entities->wanderTime[index] = entities->wanderTime[last];
+    entities->randomState[index] = entities->randomState[last];
+}
+
+// 스트레스 테스트용: 사각형 바닥 플랫폼 위 아무 곳에나 배회 NPC를 뿌림
+void spawnWanderingNPCs(GameContext *game, int count, SDL_Texture *sprite){
+    int floors[MAX_PLATFORMCOUNT];
+    int floorCount = 0;
+
+    for(int i = 0; i < platformCount; i++){
+        if(platforms[i].pointCount == 0 && platforms[i].width > platforms[i].height && platforms[i].width >= 144){
+            floors[floorCount++] = i;
+        }
+    }
+    if(floorCount == 0) return;
+
+    for(int n = 0; n < count; n++){
+        Platform *floor = &platforms[floors[entityRandom(game) % floorCount]];
+        float x = floor->x + (float)(entityRandom(game) % (Uint32)(floor->width - 72));
+        if(spawnEntity(game, x, floor->y - 72, 72, 72, sprite) == -1) break;
+    }
+    LOG_INFO(LOG_CORE, "Spawned %d wandering NPCs", game->world.entities.count);
+}
+
+// 잡에 넘기는 인자
+typedef struct EntityStep{
+    EntityStore *entities;
+    float stepTime;
+} EntityStep;
+
+// 배회 AI: 1~4초마다 왼쪽 / 정지 / 오른쪽 중 하나로 바꿈
+static void updateEntityWanderRange(void *data, int begin, int end){
+    EntityStore *entities = ((EntityStep *)data)->entities;
+    float stepTime = ((EntityStep *)data)->stepTime;
+    for(int i = begin; i < end; i++){
+        entities->wanderTime[i] -= stepTime;
+        if(entities->wanderTime[i] <= 0.0f){
+            int choice = (int)(nextRandom(&entities->randomState[i]) % 3) - 1;
+            entities->velocityX[i] = choice * ENTITY_WANDER_SPEED;
+            entities->wanderTime[i] = 1.0f + (nextRandom(&entities->randomState[i]) % 3000) / 1000.0f;
+        }
+    }
+}
+
+// 중력 -> 이동/충돌 (플랫폼과 BVH는 읽기만 하므로 엔티티끼리 독립적)
+static void updateEntityMovementRange(void *data, int begin, int end){
+    EntityStore *entities = ((EntityStep *)data)->entities;
+    float stepTime = ((EntityStep *)data)->stepTime;
+    for(int i = begin; i < end; i++){
+        entities->previousX[i] = entities->x[i];
+        entities->previousY[i] = entities->y[i];
+        entities->velocityY[i] += gravity * stepTime;
+
+        int hits = moveBox(&entities->x[i], &entities->y[i], entities->width[i], entities->height[i],
+                           &entities->velocityX[i], &entities->velocityY[i], stepTime);
+        if(hits & BOX_HIT_WALL){
+            entities->velocityX[i] = -entities->velocityX[i]; // 벽에 막히면 돌아섬
+        }
+
+        if(entities->velocityX[i] != 0.0f){
+            entities->direction[i] = entities->velocityX[i] < 0 ? -1 : 1;
+            entities->isMoving[i] = 1;
+        }
+        else{
+            entities->isMoving[i] = 0;
+        }
+    }
+}
+
+// 물리 틱마다: 배회 AI -> 이동 (컴포넌트 배열을 앞에서부터 순서대로 훑음, 덩어리별로 워커에 분배)
+void updateEntityPhysics(GameContext *game, float stepTime){
+    EntityStep step = { &game->world.entities, stepTime };
+    parallelFor("entityWander", 0, step.entities->count, 1024, updateEntityWanderRange, &step);
+    parallelFor("entityMovement", 0, step.entities->count, 128, updateEntityMovementRange, &step);
+}
+
+// 프레임 애니메이션 (플레이어 updateFrame과 같은 딜레이 사용)
+void updateEntityFrames(GameContext *game){
+    EntityStore *entities = &game->world.entities;
+    Uint32 currentTime = game->clock.time;
+    for(int i = 0; i < entities->count; i++){
+        if(currentTime >= entities->nextFrameTime[i]){
+            entities->frame[i] = (entities->frame[i] + 1) % 8;
+            entities->nextFrameTime[i] = currentTime + (entities->isMoving[i] ? movingFrameDelay : idleFrameDelay);
+        }
+    }
+}
+
+// 카메라 안에 들어온 엔티티만 그림
+void renderEntities(GameContext *game, SDL_Renderer *renderer){
+    EntityStore *entities = &game->world.entities;
+    const SDL_Rect *camera = &game->camera.rect;
+    float viewLeft = camera->x - 72;
+    float viewRight = camera->x + camera->w;
+
+    for(int i = 0; i < entities->count; i++){
+        float x = entities->previousX[i] + (entities->x[i] - entities->previousX[i]) * game->clock.physicsAlpha;
+        if(x < viewLeft || x > viewRight || entities->sprite[i] == NULL) continue;
+        float y = entities->previousY[i] + (entities->y[i] - entities->previousY[i]) * game->clock.physicsAlpha;
+
+        SDL_Rect srcRect = { 0, 0, 24, 24 };
+        if(entities->isMoving[i]){
+            srcRect.y = entities->direction[i] == -1 ? 24 : 48;
+            srcRect.x = entities->frame[i] * 24;
+        }
+        else{
+            srcRect.x = (entities->direction[i] == -1 ? 0 : 48) + (entities->frame[i] % 2) * 24;
+        }
+
+        SDL_Rect destRect = { (int)x - camera->x, (int)y - camera->y, (int)entities->width[i], (int)entities->height[i] };
+        SDL_RenderCopy(renderer, entities->sprite[i], &srcRect, &destRect);
+    }
+}
@@ -4,22 +4,111 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
-extern float playerX;
-extern float playerY;
-extern SDL_Rect playerRect;
-
-extern int velocityY;
-extern int gravity;
-extern int direction;
-extern int isJumping;
-extern int isMoving;
-
-extern int frame;
+// 로거 (log.c)
+typedef enum LogLevel{
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR
+} LogLevel;
+
+typedef enum LogCategory{
+    LOG_CORE,
+    LOG_MAP,
+    LOG_DIALOGUE,
+    LOG_UI,
+    LOG_AUDIO,
+    LOG_ASSET,
+    LOG_CATEGORY_COUNT
+} LogCategory;
+
+// 이보다 낮은 수준의 로그는 컴파일 때 빠짐 (0 = DEBUG ~ 3 = ERROR), 릴리즈(NDEBUG)는 기본 INFO부터
+// 빠진 로그도 인자는 형식 검사를 받고 사용한 것으로 쳐서, 로그에만 쓰는 변수가 릴리즈에서 경고를 내지 않음
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+extern LogLevel logLevel;
+void initLogger();
+void shutdownLogger();
+void flushLog();
+void setLogLevel(const char *name);
+void logMessage(LogLevel level, LogCategory category, const char *format, ...);
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(category, ...) logMessage(LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) (0 ? logMessage(LOG_LEVEL_DEBUG, category, __VA_ARGS__) : (void)0)
+#endif
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO(category, ...) logMessage(LOG_LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) (0 ? logMessage(LOG_LEVEL_INFO, category, __VA_ARGS__) : (void)0)
+#endif
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARN(category, ...) logMessage(LOG_LEVEL_WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) (0 ? logMessage(LOG_LEVEL_WARN, category, __VA_ARGS__) : (void)0)
+#endif
+#define LOG_ERROR(category, ...) logMessage(LOG_LEVEL_ERROR, category, __VA_ARGS__)
+
+// 할당 추적 (memory.c)
+typedef enum MemoryTag{
+    MEM_CORE,      // 파일 버퍼, 팩
+    MEM_MAP,       // 타일 데이터
+    MEM_JSON,      // cJSON (맵, 대화)
+    MEM_TEXT,      // 상호작용 텍스트, SE 이름
+    MEM_AUDIO,     // 디코딩된 소리 (SDL_mixer가 가짐)
+    MEM_TEXTURE,   // 텍스처 (스프라이트, 타일셋, 애니메이션 시트)
+    MEM_UI,        // 글자 렌더링에 만드는 임시 텍스처
+    MEM_TAG_COUNT
+} MemoryTag;
+
+void initMemoryTracking();
+void *trackedMalloc(MemoryTag tag, size_t size, const char *file, int line);
+void *trackedCalloc(MemoryTag tag, size_t count, size_t size, const char *file, int line);
+char *trackedStrdup(MemoryTag tag, const char *text, const char *file, int line);
+void trackedFree(void *data);
+void trackExternal(MemoryTag tag, int bytes);
+void endMemoryFrame();
+int getFrameAllocationCount();
+int getMemoryLiveBytes(MemoryTag tag);
+void dumpMemoryUsage();
+SDL_bool reportMemoryLeaks();
+
+#define MEM_ALLOC(tag, size) trackedMalloc(tag, size, __FILE__, __LINE__)
+#define MEM_CALLOC(tag, count, size) trackedCalloc(tag, count, size, __FILE__, __LINE__)
+#define MEM_STRDUP(tag, text) trackedStrdup(tag, text, __FILE__, __LINE__)
+#define MEM_FREE(data) trackedFree(data)
+
+// 한 판의 게임 상태 (아래 '게임 컨텍스트' 참고), 갱신/렌더링 함수는 전부 이것을 첫 인자로 받음
+typedef struct GameContext GameContext;
+
+extern float gravity;
 extern int idleFrameDelay;
 extern int movingFrameDelay;
-extern int lastFrameTime;
-extern int eKeyPressed;
-extern char *propertyText;
+
+// 에셋 로더 (asset.c)
+typedef int AssetHandle;  // 에셋 배열 인덱스 + 1
+#define ASSET_NONE 0
+
+typedef enum AssetType{
+    ASSET_TEXTURE,  // 이미지 -> 로더가 디코딩, 메인 스레드가 텍스처 생성
+    ASSET_JSON      // JSON -> 로더가 읽고 파싱
+} AssetType;
+
+typedef enum AssetState{
+    ASSET_EMPTY = 0,  // 빈칸
+    ASSET_QUEUED,     // 로더 큐에서 대기
+    ASSET_LOADING,    // 로더가 읽는 중
+    ASSET_DECODED,    // 디코딩 완료, 텍스처 업로드 대기
+    ASSET_READY,      // 사용 가능
+    ASSET_FAILED      // 실패
+} AssetState;
 
 typedef struct Map{ // tileData.c 와 연결됨
     int mapWidth;
@@ -29,29 +118,62 @@ typedef struct Map{ // tileData.c 와 연결됨
     unsigned int *tileData;
     cJSON *mapJson;
     cJSON *layers;
+    AssetHandle asset;  // mapJson을 가진 에셋 (핫 리로드 후에는 ASSET_NONE, mapJson을 맵이 직접 가짐)
+    char path[128];     // 맵 파일 경로
+    char music[64];   // 맵 속성 music: 이 맵에 들어가면 스트리밍할 배경음악 경로 (없으면 빈 문자열)
+    int worldX;         // 월드에서 이 맵의 왼쪽 끝 (3배 확대 전, buildWorld에서 정함)
 } Map;
 
+#define MAP_STRIDE 984  // 맵을 가로로 이어 붙이는 기본 간격 (24x24 기준, 이보다 넓은 맵은 제 폭만큼)
+
 extern Map maps[100];
 extern int currentMapCount;
-
-typedef struct Platform{ // tileData.c 와 연결됨
-    float x, y, width, height;
-    SDL_Point polygon[100];  // 다각형 플랫폼의 점들
-    int pointCount;
+extern int droppedWorldObjects; // tileData.c, 상한을 넘어 버리거나 잘린 플랫폼 / 다각형 / 상호작용 / NPC 배치 지점 수
+extern char mapDirectory[128]; // 맵 JSON 폴더 (기본 tile)
+
+#define MAX_PLATFORMCOUNT 8192 // 다각형은 볼록 조각 여러 개로 쪼개져 들어가므로 넉넉하게 (스트레스 월드 100맵 x 발판 40개도 들어가도록)
+#define MAX_POLYGON_POINTS 16  // 볼록 조각 하나의 최대 꼭짓점 수
+#define MAX_SHAPE_POINTS 100   // 다각형 / 폴리라인 오브젝트 하나의 최대 꼭짓점 수 (볼록 분할 전)
+#define MAX_MOVE_SUBSTEPS 16   // moveBox가 틱 하나를 쪼개는 최대 횟수
+
+// moveBox 충돌 결과 비트
+#define BOX_HIT_FLOOR 1
+#define BOX_HIT_WALL  2
+
+typedef struct Platform{ // tileData.c, collision.c 와 연결됨
+    float x, y, width, height;                // 사각형 플랫폼 영역 (다각형이면 바운딩 박스)
+    SDL_Point polygon[MAX_POLYGON_POINTS];  // 볼록 다각형 조각의 점들 (월드 좌표)
+    int pointCount;                         // 0이면 사각형, 2면 선분(polyline), 3 이상이면 볼록 다각형
+    int mapIndex;                           // 이 플랫폼이 나온 맵 (핫 리로드 때 그 맵 것만 다시 만듦)
 } Platform;
 
-extern Platform platforms[100];
+extern Platform platforms[MAX_PLATFORMCOUNT];
 extern int platformCount;
+extern int polygonPlatformCount; // 다각형 조각 수 (0이면 SAT 처리 생략)
+
+// 상호작용 종류 (로딩 시 이름으로 한 번만 판별)
+typedef enum InteractionType{
+    INTERACTION_NONE = 0,  // 상호작용 아님
+    INTERACTION_TELEPORT,  // 같은 이름의 다른 오브젝트로 이동 (문, 계단, 엘리베이터)
+    INTERACTION_TEXT,      // 속성값 Text 출력
+    INTERACTION_SHOP,      // 상점
+    INTERACTION_EVENT      // 이벤트 시스템 (eventID)
+} InteractionType;
+
+#define MAX_INTERACTIONS 1024 // interactions와 상호작용 인덱스로 접근하는 배열 (트리거 색인, 미리 읽기 등) 크기
 
 typedef struct Interaction{ // tileData.c 와 연결됨
     float x, y, width, height;
     char name[32];
     char *SE;
+    int seID;              // SE 이름을 로딩 때 찾아둔 SoundID (audio.c)
     char *propertyText;
     int eventID;
+    InteractionType type;
+    int mapIndex;          // 이 상호작용이 나온 맵
 } Interaction;
 
-extern Interaction interactions[100];
+extern Interaction interactions[MAX_INTERACTIONS];
 extern int interactionCount;
 
 // 각 상호작용별로 마지막 상호작용 위치를 저장
@@ -61,16 +183,12 @@ typedef struct LastInteraction{
     char name[100];
 } LastInteraction;
 
-LastInteraction lastInteractions[100] = {0};  // 최대 상호작용 개수만큼 배열 할당
-
 typedef struct TextDisplay{
     const char *text;  // 출력할 텍스트
     Uint32 startTime;  // 텍스트가 표시된 시작 시간
     Uint32 duration;   // 텍스트 표시 지속 시간
 } TextDisplay;
 
-TextDisplay activeTextDisplay = {NULL, 0, 0};
-
 typedef struct ShopItem{
     char name[32];
     int value;     // 구매 제한
@@ -78,39 +196,32 @@ typedef struct ShopItem{
     int selectedItem;
 } Shop;
 
-Shop items[10];    // 최대 10개 적재 가능
-int itemCount = 0; // 현재 상점의 아이템 개수
+#define MAX_SHOP_ITEMS 10 // 최대 10개 적재 가능
 
-SDL_bool isShopVisible = SDL_FALSE;  // 상점 UI 상태
-Shop shop = {0};                     // 상점 데이터 구조체
+extern Shop shopCatalog[MAX_SHOP_ITEMS]; // 맵에서 읽은 상점 아이템 (판마다 UIState.items로 복사해서 재고를 따로 셈)
+extern int shopCatalogCount;
 
 typedef struct Inventory{
     char name[32];  // 소지 아이템 이름
     int quantity;   // 소지 아이템 개수
 } Inventory;
 
-extern float cameraX;
-extern SDL_Rect camera;
+#define MAX_INVENTORY_ITEMS 16
+#define MAX_EVENT_ID 64 // 진행 플래그를 남기는 eventID 범위 (resource/eventID/*.json)
 
 extern SDL_Texture* spriteSheet;
+extern SDL_Texture *npcSpriteSheet; // entity.c
 
 extern SDL_Window *window;
 extern SDL_Renderer *renderer;
 extern SDL_Texture *tilesetTexture;
 
-extern int playerGold;
+// 고정 물리 틱 (저사양에서는 30~60Hz로 낮춰도 스윕 충돌 덕분에 뚫고 지나가지 않음)
+#define MAX_PHYSICS_STEPS 8     // 한 프레임에 돌릴 수 있는 최대 물리 틱 수 (긴 프레임 폭주 방지)
+extern int physicsTickRate;     // 초당 물리 틱 수
 
-// 띵동대쉬 초당 16연타 이벤트 변수 (구조체로 하기 귀찮음;;)
 SDL_Color BasicColor = {255, 255, 255, 255}; // 흰색 텍스트
 SDL_Color YelloColor = {255, 255, 0, 255};   // 노란색 텍스트
-SDL_Color textEventColor;
-int fontSize = 24;
-char buffer[64];
-SDL_bool isMiniGameActive = SDL_FALSE;
-Uint32 miniGameStartTime = 0;
-int spaceBarCount = 0;
-Uint32 effectStartTime = 0; // 텍스트 효과 시작 시간
-SDL_bool isEffectActive = SDL_FALSE;
 
 typedef struct tileAnimation {
     int eventID;           // 애니메이션과 관련된 eventID
@@ -119,16 +230,15 @@ typedef struct tileAnimation {
     int currentFrame;      // 현재 프레임
     Uint32 frameDuration;  // 프레임 지속 시간
     Uint32 lastFrameTime;  // 마지막 프레임 갱신 시간
-    SDL_Texture **frames;  // 프레임 이미지 배열
+    SDL_Texture *sheet;    // 가로로 프레임이 이어진 스프라이트 시트 (24x24 프레임)
+    AssetHandle sheetAsset;
     SDL_bool isActive;     // 활성화 여부
     SDL_bool isFreezed;    // 일시정지 여부
     SDL_bool isFinished;   // 완료 여부
+    SDL_bool isFrameDue;   // 프레임 타이머가 울려서 다음 프레임으로 넘길 차례
+    int frameTimer;        // 프레임 타이머 ID (timer.c)
 } tileAnimation;
 
-// 애니메이션 배열
-tileAnimation animations[10];
-int animationCount = 0;
-
 typedef struct DialogueText {
     char name[32];          // 이름
     int ID;                 // 텍스트 ID
@@ -140,41 +250,492 @@ typedef struct DialogueText {
     char options[4][128];   // 선택지 텍스트 (최대 4개의 선택지)
     int nextIds[4];         // 선택 후 이동할 다음 대화 ID (최대 4개)
     char SE[16];
+    int seID;               // SE의 SoundID (로딩 때 찾아둠)
 } DialogueText;
 
-Uint32 textTime = 0;
-DialogueText dialogues[10];             // 대화 목록
-SDL_bool isTextComplete = SDL_FALSE;   // 텍스트 출력 완료 여부
-SDL_bool isDialogueActive = SDL_FALSE; // 텍스트 활성화 여부
-int selectedOption = 0;                // 초기 선택지 인덱스
-int currentLine = 0;                   // 현재 출력할 줄 인덱스
 
 typedef struct soundEffect {
     Mix_Chunk *chunk;   // SDL_Mixer에서 사용할 사운드 데이터
     char name[32];      // 사운드 이름 (재생 시 키로 사용)
     int volume;         // 사운드 볼륨 (0~128)
+    int maxInstances;   // 동시에 재생할 수 있는 최대 개수
+    int priority;       // 채널이 모자랄 때 이 값이 낮은 소리부터 뺏김
+    Uint32 minInterval; // 같은 소리를 다시 재생하기까지 최소 간격 (ms)
+    Uint32 lastPlayTime;
+    char path[128];     // 처음 재생할 때 디코딩하는 소리의 파일 경로 (미리 로드한 소리는 빈 문자열)
+    Uint32 lastUseTime; // 캐시에서 뺄 순서 (LRU)
 } SoundEffect;
 
 typedef struct {
-    SoundEffect effects[16];  // 최대 32개의 SoundEffect 관리
+    SoundEffect effects[16];  // 최대 16개의 SoundEffect 관리
     int effectCount;          // 현재 로드된 사운드 효과 개수
 } SoundManager;
 
 // SoundManager 초기화
 SoundManager soundManager = { .effectCount = 0 };
 
-SDL_bool running = SDL_TRUE;
+// 효과음 (audio.c)
+typedef int SoundID;  // effects 인덱스 + 1
+#define SOUND_NONE 0  // 0으로 초기화된 구조체는 '소리 없음'
+
+extern SoundID doorBellSound;
+extern SoundID cashSound;
+extern SoundID canselSound;
+extern int audioBufferSamples;
+extern int voicesDropped;
+extern int voicesStolen;
+extern int soundCacheBudget;
+extern int soundCacheBytes;
+
+#define MAX_VOICES 16 // 믹서 채널 수 (동시에 섞는 소리의 상한)
+
+int openAudioDevice();
+SoundID findSound(const char *name);
+SoundID loadSoundEffect(const char *filePath, const char *name, int volume);
+void playSoundEffect(SoundID sound);
+void setSoundVoiceLimit(SoundID sound, int maxInstances, int priority, Uint32 minInterval);
+SoundID registerCompressedSound(const char *filePath, const char *name, int volume);
+void playGameSound(GameContext *game, SoundID sound);
+
+// 배경음악 스트리밍 (music.c)
+void updateMusic(GameContext *game);
+void shutdownMusic();
+float getSoundLatency();
+void freeSoundEffects();
+
+SDL_bool running = SDL_TRUE; // 창을 닫으면 SDL_FALSE
+
+// 잡 시스템 (job.c)
+typedef void (*JobFunction)(void *data, int begin, int end); // [begin, end) 범위 처리
+
+typedef struct JobTiming{
+    const char *name;   // 잡 이름
+    int worker;         // 실행한 워커 번호 (0 = 메인 스레드)
+    int count;          // 처리한 인덱스 수
+    Uint64 start, end;  // SDL_GetPerformanceCounter 값
+} JobTiming;
+
+void initJobSystem(int workerCount);
+void shutdownJobSystem();
+void submitJob(const char *name, JobFunction function, void *data, int begin, int end, SDL_atomic_t *counter);
+void waitForJobCounter(SDL_atomic_t *counter);
+void parallelFor(const char *name, int begin, int end, int grainSize, JobFunction function, void *data);
+extern SDL_atomic_t jobTimingEnabled;
+extern int jobWorkerCount;
+Uint32 getJobTimingCount(int worker);
+SDL_bool getJobTiming(int worker, Uint32 index, JobTiming *timing);
+
+// 타이머 휠 (timer.c)
+typedef void (*TimerCallback)(GameContext *game, void *data);
+
+#define IDLE_MAX_WAIT 1000 // 가만히 있을 때 한 번에 잠드는 최대 시간 (ms)
+#define TIMER_POOL_SIZE 256
+#define TIMER_LEVEL0_BITS 8
+#define TIMER_LEVEL_BITS 6
+#define TIMER_LEVEL0_SLOTS (1 << TIMER_LEVEL0_BITS)
+#define TIMER_LEVEL_SLOTS (1 << TIMER_LEVEL_BITS)
+
+typedef struct TimerNode{
+    Uint32 expireTime;       // 마감 시각 (GameClock.time 기준)
+    TimerCallback callback;
+    void *data;
+    int next, prev;          // 칸 안의 이중 연결 리스트 (-1이면 끝)
+    int slot;                // 들어있는 칸 (전체 칸 배열 기준, -1이면 비어있음)
+    Uint16 generation;       // 재사용된 노드에 옛날 ID로 취소하지 않도록
+} TimerNode;
+
+typedef struct TimerWheel{
+    TimerNode pool[TIMER_POOL_SIZE];
+    int freeList;
+    int slots[TIMER_LEVEL0_SLOTS + 2 * TIMER_LEVEL_SLOTS]; // 칸마다 첫 노드 (-1이면 비어있음)
+    Uint32 currentTime;      // 휠이 처리를 마친 시각
+    int redrawTimer;         // 예약된 다시 그리기 타이머 (하나만 유지)
+    Uint32 redrawExpireTime;
+} TimerWheel;
+
+void initTimers(GameContext *game, Uint32 currentTime);
+int addTimer(GameContext *game, Uint32 delay, TimerCallback callback, void *data);
+void cancelTimer(GameContext *game, int timerID);
+void advanceTimers(GameContext *game, Uint32 currentTime);
+Uint32 getNextTimerDelay(GameContext *game);
+void requestRedraw(GameContext *game, Uint32 delay);
+void showText(GameContext *game, const char *text, Uint32 duration);
+void finishMiniGame(GameContext *game, void *data);
+SDL_bool addInventoryItem(GameContext *game, const char *name, int quantity);
+void markEventFlag(GameContext *game, int eventID);
+void markDialogueNode(GameContext *game, int eventID, int node);
+void activateAnimation(GameContext *game, tileAnimation *animation);
+SDL_bool isCameraSettled(GameContext *game);
+
+// 입력 (input.c)
+#define INPUT_BUFFER_SIZE 256 // 2의 거듭제곱
+
+typedef struct InputEvent{
+    Uint32 timestamp;       // SDL 이벤트 타임스탬프 (ms)
+    SDL_Scancode scancode;
+    Uint8 pressed;          // 1 = 눌림, 0 = 뗌
+} InputEvent;
+
+typedef struct InputState{
+    InputEvent buffer[INPUT_BUFFER_SIZE];
+    Uint32 writeIndex;      // 다음에 쓸 위치 (누적)
+    Uint32 frameBegin;      // 이번 프레임에 처리할 이벤트 범위 [begin, end)
+    Uint32 frameEnd;
+    Uint32 droppedEvents;
+    Uint8 keyDown[SDL_NUM_SCANCODES]; // 이벤트로 추적한 현재 키 상태
+    Uint32 pendingTimestamp; // 아직 화면에 반영되지 않은 가장 오래된 입력 시각 (0이면 없음)
+
+    // 입력 지연 (키 입력 -> 화면 출력) 측정, 화면에 그리는 메인 게임만
+    Uint32 latencyLast;
+    Uint32 latencyMax;
+    float latencyAverage;    // 지수 이동 평균 (ms)
+} InputState;
+
+void recordInputEvent(GameContext *game, const SDL_Event *event);
+void updateInputFrame(GameContext *game);
+int getKeyPressCount(GameContext *game, SDL_Scancode scancode);
+int getKeyPressCountBetween(GameContext *game, SDL_Scancode scancode, Uint32 from, Uint32 to);
+SDL_bool wasKeyPressed(GameContext *game, SDL_Scancode scancode);
+SDL_bool isKeyDown(GameContext *game, SDL_Scancode scancode);
+void markInputPresented(GameContext *game);
+
+// 엔티티 (entity.c)
+// 컴포넌트별로 배열을 따로 두는 구조(SoA)라서 시스템마다 필요한 배열만 순서대로 읽음
+#define MAX_ENTITYCOUNT 4096
+#define MAX_NPC_SPAWNS 256
+
+typedef struct EntityStore{
+    int count;
+
+    // 위치와 속도
+    float x[MAX_ENTITYCOUNT];
+    float y[MAX_ENTITYCOUNT];
+    float previousX[MAX_ENTITYCOUNT];   // 직전 물리 틱 좌표 (보간용)
+    float previousY[MAX_ENTITYCOUNT];
+    float velocityX[MAX_ENTITYCOUNT];
+    float velocityY[MAX_ENTITYCOUNT];
+
+    // 충돌체 크기
+    float width[MAX_ENTITYCOUNT];
+    float height[MAX_ENTITYCOUNT];
+
+    // 스프라이트와 애니메이션 (시트 구성은 플레이어와 같음: 0줄 대기, 1줄 왼쪽, 2줄 오른쪽)
+    SDL_Texture *sprite[MAX_ENTITYCOUNT];
+    Sint8 direction[MAX_ENTITYCOUNT];
+    Uint8 isMoving[MAX_ENTITYCOUNT];
+    Uint8 frame[MAX_ENTITYCOUNT];
+    Uint32 nextFrameTime[MAX_ENTITYCOUNT];
+
+    // 배회 AI (다음 방향 전환까지 남은 시간 초, 엔티티별 난수 상태)
+    float wanderTime[MAX_ENTITYCOUNT];
+    Uint32 randomState[MAX_ENTITYCOUNT]; // 병렬 갱신해도 결과가 같도록 엔티티마다 따로 둠
+} EntityStore;
+
+extern SDL_FPoint npcSpawnPoints[MAX_NPC_SPAWNS]; // 맵의 npc 오브젝트 (판을 시작할 때 여기에 NPC를 만듦)
+extern int npcSpawnCount;
+
+// 트리거 (trigger.c)
+#define MAX_ACTIVE_TRIGGERS 8   // 동시에 겹칠 수 있는 최대 상호작용 수
+#define MAX_TRIGGER_EVENTS 32   // 한 프레임에 쌓일 수 있는 최대 이벤트 수
+
+typedef enum TriggerEventType{
+    TRIGGER_ENTER,
+    TRIGGER_EXIT
+} TriggerEventType;
+
+typedef struct TriggerEvent{
+    TriggerEventType type;
+    int interactionIndex;
+} TriggerEvent;
+
+// 게임 컨텍스트
+// 한 판의 게임에서 바뀌는 상태는 전부 여기에 있고, 갱신/렌더링 함수는 받은 컨텍스트만 고침
+// 맵, 플랫폼, 상호작용, BVH, 트리거 색인, 상점 목록, NPC 배치 지점 같은 월드 데이터는 로딩 후 읽기만 하므로 전역에 하나만 두고 같이 씀
+// 렌더러와 텍스처, 오디오 장치, 에셋 로더, 잡 시스템, 로거처럼 프로세스에 하나뿐인 것도 전역
+// 그래서 컨텍스트를 여러 개 만들어 스레드마다 하나씩 돌려도 서로 건드리지 않음 (화면과 소리는 메인 게임만)
+typedef struct PlayerState{
+    float x, y;                  // 물리 좌표 (렌더링 rect와 분리)
+    float previousX, previousY;  // 직전 물리 틱 좌표 (보간용)
+    float velocityX, velocityY;  // 픽셀/초
+    int direction;
+    int isJumping;
+    int isMoving;
+    int frame;
+    int frameTimer;              // 프레임 타이머 ID
+    int frameTimerMoving;        // 타이머를 걸 때의 이동 상태
+    SDL_Rect rect;               // 렌더링할 플레이어 rect
+    int gold;
+    Inventory inventory[MAX_INVENTORY_ITEMS]; // 상점에서 산 아이템
+    int inventoryCount;
+} PlayerState;
+
+typedef struct CameraState{
+    float x;        // 카메라 좌표 (분리용)
+    SDL_Rect rect;  // 카메라 정보
+} CameraState;
+
+typedef struct UIState{
+    TextDisplay activeTextDisplay;
+    int textDisplayTimer;         // 텍스트 숨기기 타이머 ID
+
+    // 상점
+    SDL_bool isShopVisible;
+    Shop shop;                    // 선택 상태
+    Shop items[MAX_SHOP_ITEMS];
+    int itemCount;
+
+    // 대화
+    DialogueText dialogues[10];
+    SDL_bool isDialogueActive;
+    SDL_bool isTextComplete;      // 텍스트 출력 완료 여부
+    int selectedOption;
+    int currentLine;              // 현재 출력할 줄 인덱스
+    Uint32 textTime;
+    int currentDialogueEvent;     // 지금 dialogues에 올라간 대화의 eventID (0이면 없음)
+
+    // 띵동대쉬 초당 16연타 이벤트
+    SDL_bool isMiniGameActive;
+    Uint32 miniGameStartTime;
+    int spaceBarCount;
+    SDL_bool isEffectActive;
+    Uint32 effectStartTime;       // 텍스트 효과 시작 시간
+    int fontSize;
+    SDL_Color textEventColor;
+    char miniGameText[64];
+} UIState;
+
+typedef struct PrefetchState{ // 이벤트 에셋 미리 읽기 (prefetch.c)
+    AssetHandle sheet[MAX_INTERACTIONS];     // 상호작용별로 미리 요청한 에셋 (없으면 ASSET_NONE)
+    AssetHandle dialogue[MAX_INTERACTIONS];
+    SDL_bool isRequested[MAX_INTERACTIONS];
+    int hits;      // 눌렀을 때 이미 준비됨
+    int late;      // 요청은 했지만 아직 읽는 중
+    int misses;    // 반경 밖에서 눌림 (요청 전)
+    int requests;
+} PrefetchState;
+
+typedef struct WorldState{ // 월드에서 판마다 바뀌는 부분
+    EntityStore entities;
+    tileAnimation animations[10];
+    int animationCount;
+    LastInteraction lastInteractions[MAX_INTERACTIONS]; // 각 상호작용별로 마지막 상호작용 위치
+
+    int activeTriggers[MAX_ACTIVE_TRIGGERS]; // 현재 플레이어와 겹친 상호작용 (인덱스 오름차순)
+    int activeTriggerCount;
+    TriggerEvent triggerEvents[MAX_TRIGGER_EVENTS];
+    int triggerEventCount;
+    int promptInteraction;        // E 키 안내를 띄울 상호작용 (없으면 -1)
+
+    int pendingEventInteraction;  // 에셋을 기다리는 이벤트 상호작용 (없으면 -1)
+    AssetHandle pendingEventSheet;
+    AssetHandle pendingEventDialogue;
+    PrefetchState prefetch;
+    int musicMap;                 // 배경음악을 고른 맵 (-1이면 아직, 메인 게임만)
+
+    // 진행 플래그 (세이브에 남음)
+    Uint32 eventFlags[MAX_EVENT_ID / 32];  // 시작한 적 있는 이벤트 (eventID 비트)
+    Uint16 dialogueFlags[MAX_EVENT_ID];    // 이벤트별로 본 대화 노드 (노드 번호 비트)
+} WorldState;
+
+typedef struct GameClock{
+    Uint32 time;                  // 지금 시각 (ms, 메인 게임은 SDL_GetTicks, 시뮬레이션은 가상 시각)
+    Uint32 lastTime;              // 지난 프레임 시각
+    float physicsAccumulator;     // 아직 시뮬레이션하지 않은 시간 (초)
+    float physicsAlpha;           // 렌더링 보간 비율 (0~1)
+} GameClock;
+
+struct GameContext{
+    PlayerState player;
+    CameraState camera;
+    UIState ui;
+    WorldState world;
+    TimerWheel timers;
+    InputState input;
+    GameClock clock;
+    Uint32 randomState;           // xorshift 난수 (NPC 배치 등)
+    SDL_bool audioEnabled;        // 효과음 재생 여부 (메인 게임만)
+    SDL_bool quitRequested;       // 대화에서 게임 종료를 골랐음
+};
+
+void initGameContext(GameContext *game, Uint32 currentTime);
 
 void addPlatform(SDL_Rect platform);
+void addPolygonPlatform(const float *pointsX, const float *pointsY, int pointCount, SDL_bool isPolyline);
+void addConvexPlatform(const float *pointsX, const float *pointsY, int pointCount);
+void decomposePolygon(const float *px, const float *py, int n);
+void buildPlatformBVH();
+typedef void (*PlatformVisitor)(int platformIndex, void *data);
+void queryPlatformBVH(float minX, float minY, float maxX, float maxY, PlatformVisitor visit, void *data);
+SDL_bool collideBoxPolygon(float boxX, float boxY, float boxW, float boxH, const Platform *platform, float *pushX, float *pushY);
+void updatePhysics(GameContext *game, float stepTime);
+void updateAnimations(GameContext *game);
+int moveBox(float *x, float *y, float w, float h, float *vx, float *vy, float stepTime);
+int spawnEntity(GameContext *game, float x, float y, float w, float h, SDL_Texture *sprite);
+void removeEntity(GameContext *game, int index);
+void spawnWanderingNPCs(GameContext *game, int count, SDL_Texture *sprite);
+void updateEntityPhysics(GameContext *game, float stepTime);
+void updateEntityFrames(GameContext *game);
+void renderEntities(GameContext *game, SDL_Renderer *renderer);
 char* readFile(const char* filename);
 int getItemPrice(const char *itemName);
-void checkInteractions(SDL_Rect *playerRect);
+void checkInteractions(GameContext *game);
 void freeAnimations(tileAnimation *animations, int count);
-void freeAnimationFrames(SDL_Texture **frames, int frameCount);
+void freeInteractions();
+void freeMapData(Map maps[], int count);
+void closeCachedFonts();
 void initializeAllDialogues(DialogueText *dialogues, int count);
 void addInteraction(SDL_Rect interactionZone, const char* name);
+InteractionType classifyInteraction(const char *name);
+void buildTriggerIndex();
+void resetTriggers(GameContext *game);
+void updateTriggers(GameContext *game);
+void processTriggerEvents(GameContext *game);
 void showErrorAndExit(const char* title, const char* errorMessage);
-int loadAnimationFrames(int eventID, SDL_Texture ***frames, SDL_Renderer *renderer);
+void parseNPCDialogue(DialogueText *dialogues, cJSON *root);
+SDL_bool updatePendingEvent(GameContext *game);
+void waitForPendingEvent(GameContext *game);
+
+// 한 프레임 진행 (main.c), 리플레이와 시뮬레이션, 벤치마크도 같은 함수로 돌림
+typedef enum EventStartMode{
+    EVENT_START_WHEN_READY, // 에셋이 준비된 프레임에 시작 (실제 게임)
+    EVENT_START_HOLD,       // 이번 프레임에는 시작하지 않음
+    EVENT_START_NOW         // 에셋을 그 자리에서 받고 바로 시작
+} EventStartMode;
+void startGame(GameContext *game, Uint32 currentTime, int stressNPCCount);
+SDL_bool updateGameFrame(GameContext *game, Uint32 currentTime, EventStartMode eventStart);
+
+void initAssets();
+AssetHandle requestAsset(const char *path, AssetType type);
+AssetState getAssetState(AssetHandle handle);
+SDL_bool isAssetSettled(AssetHandle handle);
+SDL_Texture *getAssetTexture(AssetHandle handle);
+cJSON *getAssetJson(AssetHandle handle);
+void releaseAsset(AssetHandle handle);
+void processAssetUploads(int maxUploads);
+void waitForAssetLoader(AssetHandle handle, Uint32 timeout);
+float getAssetProgress();
+void getAssetCounts(int *resident, int *pending);
+void shutdownAssets();
+void renderLoadingScreen(SDL_Renderer *renderer, float progress);
+
+// 맵 파싱 (tileData.c)
+extern int currentParsingMap;     // 지금 파싱 중인 맵 인덱스 (플랫폼/상호작용에 기록)
+extern SDL_bool isReloadingMap;   // 핫 리로드 중이면 NPC 배치를 건너뜀 (살아있는 NPC 유지)
+SDL_bool parseMapHeader(Map *map);
+void parseObjectGroups(Map *map, int xOffset, int yOffset);
+unsigned int *parseTileData(Map *map);
+SDL_bool buildWorld(Map maps[], int mapCount);
+int findMapAt(float x);
+
+// 핫 리로드 (hotReload.c)
+extern SDL_bool hotReloadEnabled; // 실행 인자 --hotreload
+void initHotReload();
+void pollHotReload(GameContext *game);
+void shutdownHotReload();
+SDL_bool reloadAssetJson(const char *path);
+void resetPrefetch(GameContext *game);
+void cancelPendingEvent(GameContext *game);
+
+// 이벤트 에셋 미리 읽기 (prefetch.c)
+extern float prefetchRadius;
+void updatePrefetch(GameContext *game);
+void recordPrefetchResult(GameContext *game, int index);
+
+// 에셋 팩 (pack.c)
+int openPack(const char *path);
+void closePack();
+SDL_bool isPackOpen();
+int findPackEntry(const char *path);
+int getPackEntryCount();
+const char *getPackEntryPath(int index);
+SDL_RWops *openAssetFile(const char *path);
+
+// 프레임 프로파일러 (profiler.c)
+typedef enum ProfileStage{
+    PROFILE_INPUT,
+    PROFILE_ANIMATION,
+    PROFILE_PHYSICS,
+    PROFILE_CAMERA,
+    PROFILE_TILES,
+    PROFILE_TEXT,
+    PROFILE_PRESENT,
+    PROFILE_ASSETS,     // 이벤트 에셋, 텍스처 업로드, 음악 전환
+    PROFILE_STAGE_COUNT
+} ProfileStage;
+
+extern SDL_bool profilerEnabled;
+extern SDL_bool profilerOverlayVisible;
+extern SDL_bool profileScopesActive;  // 구간 측정 여부 (프로파일러나 히치 감지기가 켜져 있으면)
+void initProfiler();
+void recordProfileScope(ProfileStage stage, Uint64 start);
+void endProfileFrame();
+float getProfileStageTime(ProfileStage stage);
+const char *getProfileStageName(ProfileStage stage);
+void renderProfilerOverlay(SDL_Renderer *renderer, TTF_Font *font);
+void setProfilerEnabled(SDL_bool enabled);
+int exportProfileTrace(const char *path);
+
+// 꺼져 있으면 전역 변수 하나 비교만 하고 끝남
+#define PROFILE_BEGIN(stage) Uint64 profileStart_##stage = profileScopesActive ? SDL_GetPerformanceCounter() : 0
+#define PROFILE_END(stage) do{ if(profileScopesActive) recordProfileScope(stage, profileStart_##stage); }while(0)
+
+// 히치 감지 (hitch.c)
+extern float hitchBudget;  // 실행 인자 --hitchbudget=ms (0이면 끔)
+void initHitchDetector();
+void beginHitchFrame();
+void endHitchFrame();
+void recordIOEvent(const char *kind, const char *path, Uint64 start);
+extern int hitchCount;
+
+// 라이브 텔레메트리 (telemetry.c, 블록 형식은 telemetryFormat.h)
+extern SDL_bool telemetryEnabled;     // 실행 인자 --telemetry
+extern char telemetrySocketPath[108]; // 실행 인자 --telemetrysocket[=경로]
+extern float fps;                     // main.c
+void initTelemetry();
+void updateTelemetry(GameContext *game);
+void shutdownTelemetry();
+
+// 헤드리스 빠른 감기 시뮬레이션 (simulate.c)
+extern SDL_bool simulateEnabled;     // 실행 인자 --simulate[=입력 스크립트]
+extern char simulateScript[256];
+extern int simulateTickLimit;        // 실행 인자 --simticks=N
+extern int simulateThreads;          // 실행 인자 --simthreads=N (1보다 크면 컨텍스트 N개를 동시에)
+typedef struct SimResult{
+    Uint64 ticks;
+    double seconds;
+    int interactionsReached;
+    int nodesReached;
+    float playerX, playerY;
+    Uint32 randomState;
+} SimResult;
+int runSimulation(const char *scriptPath, int tickLimit, SimResult *result);
+int runParallelSimulations(const char *scriptPath, int tickLimit, int threadCount);
+
+// 입력 녹화와 결정적 리플레이 (replay.c)
+extern char replayRecordPath[256];   // 실행 인자 --record=파일
+extern char replayPath[256];         // 실행 인자 --replay=파일
+extern char replayGoldenPath[256];   // 실행 인자 --golden=파일
+extern SDL_bool replayWriteGolden;   // 실행 인자 --writegolden
+extern char replayReportPath[256];   // 실행 인자 --replayreport=파일
+void startReplayRecording(GameContext *game, int npcCount);
+void recordReplayFrame(GameContext *game, Uint32 currentTime, SDL_bool eventStarted);
+void stopReplayRecording();
+int runReplay(GameContext *game, SDL_Renderer *renderer, Map maps[], int mapCount, TTF_Font *font);
+
+// 세이브 (save.c)
+extern char savePath[256];           // 실행 인자 --save=파일
+extern int autosaveInterval;         // 실행 인자 --autosave=초 (0이면 끔)
+extern SDL_bool savesEnabled;        // 실행 인자 --nosave면 SDL_FALSE (녹화, 재생도 끔)
+extern int saveCount;
+extern int savesSkipped;             // 이전 세이브를 쓰는 중이라 건너뛴 자동 저장
+void initSaveSystem();
+void shutdownSaveSystem();
+SDL_bool requestSave(GameContext *game, SDL_bool waitForWriter);
+SDL_bool loadGame(GameContext *game);
+void startAutosave(GameContext *game);
+
+#define ASSET_UPLOADS_PER_FRAME 2 // 한 프레임에 만들 최대 텍스처 수 (GPU 업로드로 프레임이 튀지 않도록)
+#define ASSET_WAIT_TIMEOUT 10     // 에셋을 그 자리에서 기다릴 때 한 번에 잠드는 최대 시간 (ms)
 void renderText(SDL_Renderer *renderer, const char *text, int x, int y, TTF_Font *font, SDL_Color color);
 
 #endif // GLOBALS.H
\ No newline at end of file
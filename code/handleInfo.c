@@ -1,185 +1,225 @@
 #include "global.h"
 
-void handleInput(const Uint8* state, float deltaTime, TTF_Font *font){
+// 키 상태는 SDL 키보드 배열 대신 입력 버퍼에서 읽음 (시뮬레이션에서도 같은 코드로 돌도록)
+void handleInput(GameContext *game){
     const float baseSpeed = 300.0f;  // 기본 속도 (픽셀/초)
-    float playerSpeed = baseSpeed * deltaTime;  // 델타 타임을 반영한 속도 계산
+    PlayerState *player = &game->player;
 
-    if(state[SDL_SCANCODE_LEFT] || state[SDL_SCANCODE_A]){ // 좌측 이동
-        playerX -= playerSpeed;
-        direction = -1;
-        isMoving = 1;
+    // 좌표는 직접 옮기지 않고 속도만 정함 (실제 이동과 충돌은 updatePhysics에서 처리)
+    if(isKeyDown(game, SDL_SCANCODE_LEFT) || isKeyDown(game, SDL_SCANCODE_A)){ // 좌측 이동
+        player->velocityX = -baseSpeed;
+        player->direction = -1;
+        player->isMoving = 1;
     }
-    else if(state[SDL_SCANCODE_RIGHT] || state[SDL_SCANCODE_D]){ // 우측 이동
-        playerX += playerSpeed;
-        direction = 1;
-        isMoving = 1;
+    else if(isKeyDown(game, SDL_SCANCODE_RIGHT) || isKeyDown(game, SDL_SCANCODE_D)){ // 우측 이동
+        player->velocityX = baseSpeed;
+        player->direction = 1;
+        player->isMoving = 1;
     }
     else{ // 정지
-        isMoving = 0;
+        player->velocityX = 0.0f;
+        player->isMoving = 0;
     }
     /*
-    if(state[SDL_SCANCODE_SPACE] && !isJumping){ // 점프
-        velocityY = -15;
-        isJumping = 1;
+    if(isKeyDown(game, SDL_SCANCODE_SPACE) && !player->isJumping){ // 점프
+        player->velocityY = -1800.0f;
+        player->isJumping = 1;
     }
     */
-    if(state[SDL_SCANCODE_E]){
-        if(!eKeyPressed){ // E 키가 처음 눌린 경우
-            checkInteractions(&playerRect);
-            eKeyPressed = 1; // E 키가 눌린 상태로 설정
-        }
-    }
-    else{
-        eKeyPressed = 0; // E 키가 떼어졌을 경우 상태 초기화
+    if(wasKeyPressed(game, SDL_SCANCODE_E)){ // E 키가 이번 프레임에 눌린 경우
+        checkInteractions(game);
     }
 }
 
-void handleTextInteraction(const Interaction *interaction){
+static void hideTextCallback(GameContext *game, void *data){
+    game->ui.activeTextDisplay.text = NULL;  // 시간이 지나면 텍스트 숨기기
+    game->ui.textDisplayTimer = -1;
+}
+
+// 텍스트를 duration(ms) 동안 표시 (이전 텍스트의 타이머는 취소)
+void showText(GameContext *game, const char *text, Uint32 duration){
+    UIState *ui = &game->ui;
+    ui->activeTextDisplay.text = text;
+    ui->activeTextDisplay.startTime = game->clock.time;  // 표시 시작 시간 기록
+    ui->activeTextDisplay.duration = duration;
+
+    cancelTimer(game, ui->textDisplayTimer);
+    ui->textDisplayTimer = addTimer(game, duration, hideTextCallback, NULL);
+}
+
+void handleTextInteraction(GameContext *game, const Interaction *interaction){
     if(interaction->propertyText != NULL){
-        activeTextDisplay.text = interaction->propertyText;  // 텍스트 복사
-        activeTextDisplay.startTime = SDL_GetTicks();        // 표시 시작 시간 기록
-        activeTextDisplay.duration = 3000;                   // 3초 동안 표시
+        showText(game, interaction->propertyText, 3000);  // 3초 동안 표시
+    }
+}
+
+// 소지품에 추가 (같은 이름이면 개수만 늘림), 칸이 없으면 SDL_FALSE
+SDL_bool addInventoryItem(GameContext *game, const char *name, int quantity){
+    PlayerState *player = &game->player;
+    for(int i = 0; i < player->inventoryCount; i++){
+        if(strcmp(player->inventory[i].name, name) == 0){
+            player->inventory[i].quantity += quantity;
+            return SDL_TRUE;
+        }
     }
+    if(player->inventoryCount >= MAX_INVENTORY_ITEMS) return SDL_FALSE;
+    Inventory *item = &player->inventory[player->inventoryCount++];
+    snprintf(item->name, sizeof(item->name), "%s", name);
+    item->quantity = quantity;
+    return SDL_TRUE;
 }
 
-void handleShopInput(Shop *shop, int *playerGold){
-    static Uint8 previousState[SDL_NUM_SCANCODES] = {0};  // 이전 키 상태 저장
-    const Uint8 *state = SDL_GetKeyboardState(NULL);      // 현재 키 상태 가져오기
+void handleShopInput(GameContext *game){
+    UIState *ui = &game->ui;
+    Shop *shop = &ui->shop;
+    Shop *items = ui->items;
+    int itemCount = ui->itemCount;
+    int *playerGold = &game->player.gold;
 
     // UP 키 눌림 감지
-    if(state[SDL_SCANCODE_UP] && !previousState[SDL_SCANCODE_UP]){
+    if(wasKeyPressed(game, SDL_SCANCODE_UP)){
         shop->selectedItem = (shop->selectedItem - 1 + itemCount) % itemCount;
-        printf("Selected item: %s\n", items[shop->selectedItem].name);
+        LOG_DEBUG(LOG_UI, "Selected item: %s", items[shop->selectedItem].name);
     }
 
     // DOWN 키 눌림 감지
-    if(state[SDL_SCANCODE_DOWN] && !previousState[SDL_SCANCODE_DOWN]){
+    if(wasKeyPressed(game, SDL_SCANCODE_DOWN)){
         shop->selectedItem = (shop->selectedItem + 1) % itemCount;
-        printf("Selected item: %s\n", items[shop->selectedItem].name);
+        LOG_DEBUG(LOG_UI, "Selected item: %s", items[shop->selectedItem].name);
     }
 
     // Z 키 눌림 감지
-    if(state[SDL_SCANCODE_Z] && !previousState[SDL_SCANCODE_Z]){
+    if(wasKeyPressed(game, SDL_SCANCODE_Z)){
         int price = getItemPrice(items[shop->selectedItem].name);
-        if(*playerGold >= price && items[shop->selectedItem].stock > 0){
+        if(*playerGold >= price && items[shop->selectedItem].stock > 0 && addInventoryItem(game, items[shop->selectedItem].name, 1)){
             *playerGold -= price;
             items[shop->selectedItem].stock--;
-            printf("Purchased %s\n", items[shop->selectedItem].name);
-            playSoundEffect("cash");
+            LOG_DEBUG(LOG_UI, "Purchased %s", items[shop->selectedItem].name);
+            playGameSound(game, cashSound);
         }
         else{
-            playSoundEffect("cansel");
-            printf("Not enough gold or item out of stock!\n");
+            playGameSound(game, canselSound);
+            LOG_DEBUG(LOG_UI, "Not enough gold or item out of stock!");
         }
     }
 
     // ESC 키 눌림 감지
-    if(state[SDL_SCANCODE_ESCAPE] && !previousState[SDL_SCANCODE_ESCAPE]){
-        isShopVisible = SDL_FALSE;
-        playSoundEffect("cansel");
-        printf("Shop closed!\n");
+    if(wasKeyPressed(game, SDL_SCANCODE_ESCAPE)){
+        ui->isShopVisible = SDL_FALSE;
+        playGameSound(game, canselSound);
+        LOG_DEBUG(LOG_UI, "Shop closed!");
     }
-
-    // 현재 키 상태를 이전 키 상태로 복사
-    memcpy(previousState, state, SDL_NUM_SCANCODES);
 }
 
 // 띵동대쉬 초당 16연타 이벤트!
-void startDingDongDashMiniGame(){
-    isMiniGameActive = SDL_TRUE;
-    miniGameStartTime = SDL_GetTicks();
-    spaceBarCount = 0;
+void startDingDongDashMiniGame(GameContext *game){
+    game->ui.isMiniGameActive = SDL_TRUE;
+    game->ui.miniGameStartTime = game->clock.time;
+    game->ui.spaceBarCount = 0;
+    addTimer(game, 5000, finishMiniGame, NULL); // 5초 뒤 종료
 }
 
-void handleChoiceInput(DialogueText *dialogue, int *selectedOption){
-    static Uint8 previousState[SDL_NUM_SCANCODES] = {0};  // 이전 키 상태 저장
-    const Uint8 *state = SDL_GetKeyboardState(NULL);      // 현재 키 상태 가져오기
+void handleChoiceInput(GameContext *game){
+    UIState *ui = &game->ui;
+    DialogueText *dialogues = ui->dialogues;
+    tileAnimation *animations = game->world.animations;
+    DialogueText *dialogue = &dialogues[dialogues->currentID];
+    int *selectedOption = &ui->selectedOption;
     int optionCount = dialogue->optionCount;              // 현재 대화의 선택지 개수
 
     // UP 키 눌림 감지
-    if(state[SDL_SCANCODE_UP] && !previousState[SDL_SCANCODE_UP] && optionCount != 0){
+    if(wasKeyPressed(game, SDL_SCANCODE_UP) && optionCount != 0){
         *selectedOption = (*selectedOption - 1 + optionCount) % optionCount;
-        printf("Choosing Option: %d\n", *selectedOption);
+        LOG_DEBUG(LOG_DIALOGUE, "Choosing Option: %d", *selectedOption);
     }
 
     // DOWN 키 눌림 감지
-    if(state[SDL_SCANCODE_DOWN] && !previousState[SDL_SCANCODE_DOWN] && optionCount != 0){
+    if(wasKeyPressed(game, SDL_SCANCODE_DOWN) && optionCount != 0){
         *selectedOption = (*selectedOption + 1) % optionCount;
-        printf("Choosing Option: %d\n", *selectedOption);
+        LOG_DEBUG(LOG_DIALOGUE, "Choosing Option: %d", *selectedOption);
     }
 
     // Z 키 눌림 감지
-    if(state[SDL_SCANCODE_Z] && !previousState[SDL_SCANCODE_Z]){
+    if(wasKeyPressed(game, SDL_SCANCODE_Z)){
         int nextId = dialogue->nextIds[*selectedOption];
 
         // 디버깅 존
-        printf("Selected option: %s\n", dialogue->options[*selectedOption]);
-        printf("All nextIds for current dialogue:\n");
+        LOG_DEBUG(LOG_DIALOGUE, "Selected option: %s", dialogue->options[*selectedOption]);
+        LOG_DEBUG(LOG_DIALOGUE, "All nextIds for current dialogue:");
         for(int i = 0; i < dialogue->optionCount; i++){
-            printf("Option %d: %s -> nextId: %d\n", i, dialogue->options[i], dialogue->nextIds[i]);
+            LOG_DEBUG(LOG_DIALOGUE, "Option %d: %s -> nextId: %d", i, dialogue->options[i], dialogue->nextIds[i]);
         }
         // 디버깅 존 끝
 
         if(nextId == -1){
             // 대화가 종료될때 SE 재생
-            if(strlen(dialogues[dialogues->currentID].SE) > 0){
-                playSoundEffect(dialogues[dialogues->currentID].SE);
+            if(dialogues[dialogues->currentID].seID != SOUND_NONE){
+                playGameSound(game, dialogues[dialogues->currentID].seID);
             }
             
             // 대화 종료
-            isDialogueActive = SDL_FALSE;
+            ui->isDialogueActive = SDL_FALSE;
             animations->isActive = SDL_FALSE;
             animations->isFreezed = SDL_FALSE;
             animations->isFinished = SDL_TRUE;
             initializeAllDialogues(dialogues, 5);
+            ui->currentDialogueEvent = 0;
             freeAnimations(animations, 10);
-            freeAnimationFrames(animations->frames, animations->frameCount);
 
 
-            printf("Dialogue ended.\n");
+            LOG_DEBUG(LOG_DIALOGUE, "Dialogue ended.");
         }
-        else if(nextId == -2) running = SDL_FALSE;
+        else if(nextId == -2) game->quitRequested = SDL_TRUE;
         else{
             // 다음 대화를 구조체에 로드
             dialogues->currentID = nextId;
+            markDialogueNode(game, ui->currentDialogueEvent, nextId);
             DialogueText *debugDialogue = &dialogues[nextId];
 
-            printf("Dialogue id changed to %d\n", dialogues->currentID);
+            LOG_DEBUG(LOG_DIALOGUE, "Dialogue id changed to %d", dialogues->currentID);
             for(short t = 0; t <= debugDialogue->textLineCount; t++){
-                printf("Dialogue Text in [%d]\n: %s\n", t, debugDialogue->text[t]);
+                LOG_DEBUG(LOG_DIALOGUE, "Dialogue Text in [%d]: %s", t, debugDialogue->text[t]);
             }
         }
-    }
-    // 현재 키 상태를 이전 키 상태로 복사
-    memcpy(previousState, state, SDL_NUM_SCANCODES);
+    }}
+
+// 진행 플래그 (세이브에 남음)
+void markEventFlag(GameContext *game, int eventID){
+    if(eventID <= 0 || eventID >= MAX_EVENT_ID) return;
+    game->world.eventFlags[eventID / 32] |= 1u << (eventID % 32);
+}
+
+void markDialogueNode(GameContext *game, int eventID, int node){
+    if(eventID <= 0 || eventID >= MAX_EVENT_ID || node < 0 || node >= 16) return;
+    game->world.dialogueFlags[eventID] |= (Uint16)(1u << node);
 }
 
 // 이벤트 구분
-void handleEvent(int eventID){
+void handleEvent(GameContext *game, int eventID){
     switch(eventID){
         case 1:
-            startDingDongDashMiniGame();
+            startDingDongDashMiniGame(game);
             break;
         case 2:
-            startDingDongDashMiniGame();
+            startDingDongDashMiniGame(game);
             break;
         case 3:
-            startDingDongDashMiniGame();
+            startDingDongDashMiniGame(game);
             break;
         case 4:
-            for(int a = 0; a < animationCount; a++){
-                animations[a].isActive = SDL_TRUE;
+            for(int a = 0; a < game->world.animationCount; a++){
+                activateAnimation(game, &game->world.animations[a]);
             }
-            isDialogueActive = SDL_TRUE;
+            game->ui.isDialogueActive = SDL_TRUE;
             break;
         case 5:
-            isDialogueActive = SDL_TRUE;
+            game->ui.isDialogueActive = SDL_TRUE;
             break;
         case 6:
-            isDialogueActive = SDL_TRUE;
+            game->ui.isDialogueActive = SDL_TRUE;
             break;
         case 7:
-            isDialogueActive = SDL_TRUE;
+            game->ui.isDialogueActive = SDL_TRUE;
             break;
     }
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "global.h"
+#include <time.h>
+
+// 히치(순간 멈춤) 감지
+// 최근 HITCH_WINDOW 프레임의 단계별 시간, 할당 수, 파일 읽기/디코딩/업로드(I/O) 기록을 항상 들고 있다가
+// 한 프레임의 작업 시간이 hitchBudget을 넘으면 그 구간을 hitch_날짜_시각_프레임.txt로 저장
+// 원인으로 가장 오래 걸린 단계와 그 프레임에 메인 스레드에서 일어난 가장 긴 I/O를 적음
+// 평소 비용은 프레임당 카운터 몇 번 읽는 정도 (보고서는 히치가 났을 때만, HITCH_REPORT_INTERVAL마다 최대 한 번)
+#define HITCH_WINDOW 120
+#define HITCH_IO_EVENTS 64           // 보관할 I/O 기록 수 (2의 거듭제곱)
+#define HITCH_REPORT_INTERVAL 5000   // 보고서 사이 최소 간격 (ms)
+
+typedef struct HitchFrame{
+    Uint32 frame;
+    float workTime;                       // 입력 처리부터 화면 출력까지 (대기 시간 제외, ms)
+    float stageTime[PROFILE_STAGE_COUNT];
+    int allocations;
+    int ioEvents;
+} HitchFrame;
+
+typedef struct IOEvent{
+    char kind[8];       // load, upload, decode, music
+    char path[96];
+    Uint32 frame;
+    float time;         // ms
+    SDL_bool onMainThread;
+} IOEvent;
+
+float hitchBudget = 2000.0f / 120.0f; // 목표 프레임(120FPS)의 두 배
+
+HitchFrame hitchFrames[HITCH_WINDOW];
+SDL_atomic_t hitchFrameIndex;         // 지금 진행 중인 프레임 번호 (로더 스레드도 읽음)
+Uint64 hitchFrameStart = 0;
+Uint32 lastHitchReport = 0;
+int hitchCount = 0;
+
+IOEvent ioEvents[HITCH_IO_EVENTS];
+SDL_atomic_t ioEventCount;
+SDL_SpinLock ioEventLock;
+int frameIOEvents = 0;                // 이번 프레임에 들어온 I/O 수 (ioEventLock)
+SDL_threadID hitchMainThread;
+
+void initHitchDetector(){
+    hitchMainThread = SDL_ThreadID();
+    SDL_AtomicSet(&hitchFrameIndex, 0);
+    SDL_AtomicSet(&ioEventCount, 0);
+    if(hitchBudget > 0.0f){
+        LOG_INFO(LOG_CORE, "Hitch detector: budget %.1f ms", hitchBudget);
+    }
+}
+
+// 파일 읽기, 디코딩, 텍스처 업로드가 끝났을 때 호출 (아무 스레드에서나)
+void recordIOEvent(const char *kind, const char *path, Uint64 start){
+    if(hitchBudget <= 0.0f) return;
+    float time = (float)((SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
+
+    SDL_AtomicLock(&ioEventLock);
+    IOEvent *event = &ioEvents[SDL_AtomicGet(&ioEventCount) & (HITCH_IO_EVENTS - 1)];
+    strncpy(event->kind, kind, sizeof(event->kind) - 1);
+    event->kind[sizeof(event->kind) - 1] = '\0';
+    strncpy(event->path, path, sizeof(event->path) - 1);
+    event->path[sizeof(event->path) - 1] = '\0';
+    event->frame = (Uint32)SDL_AtomicGet(&hitchFrameIndex);
+    event->time = time;
+    event->onMainThread = SDL_ThreadID() == hitchMainThread;
+    SDL_AtomicIncRef(&ioEventCount);
+    frameIOEvents++;
+    SDL_AtomicUnlock(&ioEventLock);
+}
+
+// 이벤트 대기가 끝나고 프레임 작업을 시작할 때
+void beginHitchFrame(){
+    if(hitchBudget <= 0.0f) return;
+    hitchFrameStart = SDL_GetPerformanceCounter();
+}
+
+static void writeHitchReport(const HitchFrame *hitch){
+    char path[64];
+    time_t now = time(NULL);
+    strftime(path, sizeof(path), "hitch_%Y%m%d_%H%M%S", localtime(&now));
+    snprintf(path + strlen(path), sizeof(path) - strlen(path), "_%u.txt", hitch->frame);
+
+    FILE *file = fopen(path, "w");
+    if(file == NULL){
+        LOG_WARN(LOG_CORE, "Failed to write hitch report %s", path);
+        return;
+    }
+
+    // 가장 오래 걸린 단계 (단계에 안 잡힌 시간이 더 길면 그것)
+    int worstStage = 0;
+    float stageSum = 0.0f;
+    for(int i = 0; i < PROFILE_STAGE_COUNT; i++){
+        stageSum += hitch->stageTime[i];
+        if(hitch->stageTime[i] > hitch->stageTime[worstStage]) worstStage = i;
+    }
+    float untracked = hitch->workTime - stageSum;
+
+    // 그 프레임의 가장 긴 I/O (메인 스레드 것을 먼저)
+    const IOEvent *worstIO = NULL;
+    int ioTotal = SDL_AtomicGet(&ioEventCount);
+    for(int i = ioTotal > HITCH_IO_EVENTS ? ioTotal - HITCH_IO_EVENTS : 0; i < ioTotal; i++){
+        const IOEvent *event = &ioEvents[i & (HITCH_IO_EVENTS - 1)];
+        if(event->frame != hitch->frame) continue;
+        if(worstIO == NULL || (event->onMainThread && !worstIO->onMainThread) ||
+           (event->onMainThread == worstIO->onMainThread && event->time > worstIO->time)){
+            worstIO = event;
+        }
+    }
+
+    fprintf(file, "Hitch at frame %u: %.2f ms (budget %.2f ms)\n", hitch->frame, hitch->workTime, hitchBudget);
+    if(untracked > hitch->stageTime[worstStage]){
+        fprintf(file, "Slowest stage: untracked (%.2f ms outside profiled stages)\n", untracked);
+    }
+    else{
+        fprintf(file, "Slowest stage: %s (%.2f ms)\n", getProfileStageName(worstStage), hitch->stageTime[worstStage]);
+    }
+    if(worstIO != NULL){
+        fprintf(file, "Likely asset: %s %s (%.2f ms, %s)\n", worstIO->kind, worstIO->path, worstIO->time,
+                worstIO->onMainThread ? "main thread" : "loader thread");
+    }
+    else{
+        fprintf(file, "Likely asset: none (no I/O in this frame)\n");
+    }
+    fprintf(file, "Allocations in frame: %d\n\n", hitch->allocations);
+
+    // 최근 프레임 (오래된 것부터)
+    fprintf(file, "%8s %8s", "frame", "work");
+    for(int i = 0; i < PROFILE_STAGE_COUNT; i++) fprintf(file, " %9s", getProfileStageName(i));
+    fprintf(file, " %7s %4s\n", "allocs", "io");
+    for(int f = 0; f < HITCH_WINDOW; f++){
+        const HitchFrame *frame = &hitchFrames[(hitch->frame + 1 + f) % HITCH_WINDOW];
+        if(frame->workTime == 0.0f && frame->frame == 0) continue; // 아직 안 채워진 칸
+        fprintf(file, "%8u %8.2f", frame->frame, frame->workTime);
+        for(int i = 0; i < PROFILE_STAGE_COUNT; i++) fprintf(file, " %9.2f", frame->stageTime[i]);
+        fprintf(file, " %7d %4d%s\n", frame->allocations, frame->ioEvents, frame == hitch ? "  <- hitch" : "");
+    }
+
+    fprintf(file, "\nI/O events (oldest first):\n");
+    for(int i = ioTotal > HITCH_IO_EVENTS ? ioTotal - HITCH_IO_EVENTS : 0; i < ioTotal; i++){
+        const IOEvent *event = &ioEvents[i & (HITCH_IO_EVENTS - 1)];
+        fprintf(file, "  frame %8u %-6s %8.2f ms %-6s %s\n", event->frame, event->kind, event->time,
+                event->onMainThread ? "main" : "loader", event->path);
+    }
+    fclose(file);
+
+    LOG_WARN(LOG_CORE, "Hitch %.2f ms at frame %u (%s), report: %s", hitch->workTime, hitch->frame,
+             worstIO != NULL ? worstIO->path : getProfileStageName(worstStage), path);
+}
+
+// 프레임 작업이 끝났을 때 (endProfileFrame, endMemoryFrame 다음)
+void endHitchFrame(){
+    if(hitchBudget <= 0.0f) return;
+
+    Uint32 frameIndex = (Uint32)SDL_AtomicGet(&hitchFrameIndex);
+    HitchFrame *frame = &hitchFrames[frameIndex % HITCH_WINDOW];
+    frame->frame = frameIndex;
+    frame->workTime = (float)((SDL_GetPerformanceCounter() - hitchFrameStart) * 1000.0 / SDL_GetPerformanceFrequency());
+    for(int i = 0; i < PROFILE_STAGE_COUNT; i++){
+        frame->stageTime[i] = getProfileStageTime(i);
+    }
+    frame->allocations = getFrameAllocationCount();
+    SDL_AtomicLock(&ioEventLock);
+    frame->ioEvents = frameIOEvents;
+    frameIOEvents = 0;
+    SDL_AtomicUnlock(&ioEventLock);
+
+    if(frame->workTime > hitchBudget){
+        hitchCount++;
+        Uint32 now = SDL_GetTicks();
+        if(lastHitchReport == 0 || now - lastHitchReport >= HITCH_REPORT_INTERVAL){
+            writeHitchReport(frame);
+            lastHitchReport = now;
+        }
+    }
+    SDL_AtomicSet(&hitchFrameIndex, (int)(frameIndex + 1));
+}
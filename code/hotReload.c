@@ -0,0 +1,205 @@
+#include "global.h"
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+// 맵/대화 핫 리로드 (개발용, 실행 인자 --hotreload)
+// tile/*.json, resource/eventID/*.json 폴더를 inotify로 지켜보다가 파일이 다시 저장되면
+// 그 맵 하나만 (타일 데이터, 그 맵의 플랫폼과 상호작용) 다시 만들거나 그 대화만 다시 읽음
+// 교체는 pollHotReload 안에서 한 번에 일어나므로 물리/렌더는 항상 옛날 것이나 새 것 중 하나만 봄
+// 팩(data.pak)을 쓰는 중이면 팩의 내용이 먼저 읽히므로 동작하지 않음
+// 맵은 모든 판이 같이 쓰고, 인덱스를 들고 있는 판 상태(트리거, 기다리는 이벤트, 대화)는 pollHotReload에 넘긴 판만 정리함
+SDL_bool hotReloadEnabled = SDL_FALSE;
+
+#ifdef __linux__
+int hotReloadFd = -1;
+int tileWatch = -1;
+int eventWatch = -1;
+#endif
+
+void initHotReload(){
+    if(!hotReloadEnabled) return;
+    if(isPackOpen()){
+        LOG_WARN(LOG_MAP, "Hot reload disabled: assets are served from the pack");
+        hotReloadEnabled = SDL_FALSE;
+        return;
+    }
+#ifdef __linux__
+    hotReloadFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(hotReloadFd == -1){
+        LOG_WARN(LOG_MAP, "Hot reload disabled: inotify_init1 failed (%s)", strerror(errno));
+        hotReloadEnabled = SDL_FALSE;
+        return;
+    }
+    // 에디터는 보통 새 파일에 쓰고 이름을 바꾸므로 IN_MOVED_TO도 같이 봄
+    tileWatch = inotify_add_watch(hotReloadFd, mapDirectory, IN_CLOSE_WRITE | IN_MOVED_TO);
+    eventWatch = inotify_add_watch(hotReloadFd, "resource/eventID", IN_CLOSE_WRITE | IN_MOVED_TO);
+    LOG_INFO(LOG_MAP, "Hot reload watching %s/ and resource/eventID/", mapDirectory);
+#else
+    LOG_WARN(LOG_MAP, "Hot reload is only supported on Linux");
+    hotReloadEnabled = SDL_FALSE;
+#endif
+}
+
+// 맵 하나 다시 만들기, 새 파일을 못 읽으면 예전 맵 유지
+static void reloadMap(GameContext *game, int index){
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    char *data = readFile(maps[index].path);
+    cJSON *json = data != NULL ? cJSON_Parse(data) : NULL;
+    MEM_FREE(data);
+    if(json == NULL){
+        LOG_WARN(LOG_MAP, "Hot reload: failed to parse %s, keeping old map", maps[index].path);
+        return;
+    }
+
+    // 새 맵을 먼저 다 만들어 보고 성공했을 때만 교체
+    Map newMap = maps[index];
+    newMap.mapJson = json;
+    newMap.tileData = NULL;
+    if(!parseMapHeader(&newMap) || parseTileData(&newMap) == NULL){
+        LOG_WARN(LOG_MAP, "Hot reload: invalid map %s, keeping old map", maps[index].path);
+        MEM_FREE(newMap.tileData);
+        cJSON_Delete(json);
+        return;
+    }
+
+    // 이 맵에서 나온 플랫폼 제거 (순서 유지하며 당김)
+    int kept = 0;
+    polygonPlatformCount = 0;
+    for(int i = 0; i < platformCount; i++){
+        if(platforms[i].mapIndex == index) continue;
+        platforms[kept++] = platforms[i];
+        if(platforms[i].pointCount > 0) polygonPlatformCount++;
+    }
+    int removedPlatforms = platformCount - kept;
+    platformCount = kept;
+
+    // 이 맵에서 나온 상호작용 제거, 비운 뒷자리는 0으로 (파싱이 interactionCount 자리에 먼저 씀)
+    kept = 0;
+    for(int i = 0; i < interactionCount; i++){
+        if(interactions[i].mapIndex == index){
+            MEM_FREE(interactions[i].propertyText);
+            MEM_FREE(interactions[i].SE);
+            continue;
+        }
+        interactions[kept++] = interactions[i];
+    }
+    int removedInteractions = interactionCount - kept;
+    memset(&interactions[kept], 0, sizeof(Interaction) * (interactionCount - kept));
+    interactionCount = kept;
+
+    // 상호작용 인덱스가 바뀌므로 인덱스를 들고 있는 것들 정리
+    cancelPendingEvent(game);
+    resetPrefetch(game);
+
+    int oldPlatformCount = platformCount;
+    int oldInteractionCount = interactionCount;
+    currentParsingMap = index;
+    isReloadingMap = SDL_TRUE; // NPC는 이미 살아 움직이고 있으므로 다시 배치하지 않음
+    parseObjectGroups(&newMap, newMap.worldX, 0);
+    isReloadingMap = SDL_FALSE;
+
+    // 예전 맵 해제 후 교체 (다시 읽은 JSON은 에셋이 아니라 맵이 가짐)
+    MEM_FREE(maps[index].tileData);
+    if(maps[index].asset != ASSET_NONE){
+        releaseAsset(maps[index].asset);
+    }
+    else{
+        cJSON_Delete(maps[index].mapJson);
+    }
+    newMap.asset = ASSET_NONE;
+    maps[index] = newMap;
+
+    buildPlatformBVH();
+    buildTriggerIndex();
+    resetTriggers(game);
+
+    // 상점 가격이 바뀌었으면 진행 중인 판에도 반영 (재고는 유지)
+    for(int i = 0; i < game->ui.itemCount; i++){
+        for(int c = 0; c < shopCatalogCount; c++){
+            if(strcmp(game->ui.items[i].name, shopCatalog[c].name) == 0) game->ui.items[i].value = shopCatalog[c].value;
+        }
+    }
+
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    LOG_INFO(LOG_MAP, "Hot reload: %s in %.2f ms (platforms %d -> %d, interactions %d -> %d)",
+           maps[index].path, elapsed, removedPlatforms, platformCount - oldPlatformCount,
+           removedInteractions, interactionCount - oldInteractionCount);
+}
+
+// 대화 JSON 다시 읽기, 지금 보고 있는 대화면 같은 위치에서 이어짐
+static void reloadDialogue(GameContext *game, const char *path, int eventID){
+    UIState *ui = &game->ui;
+    Uint64 start = SDL_GetPerformanceCounter();
+    if(!reloadAssetJson(path)){
+        return; // 올라와 있지 않으면 다음에 요청할 때 새 파일을 읽음
+    }
+
+    if(eventID == ui->currentDialogueEvent && ui->isDialogueActive){
+        char filePath[64];
+        snprintf(filePath, sizeof(filePath), "resource/eventID/%d.json", eventID);
+        AssetHandle handle = requestAsset(filePath, ASSET_JSON);
+        cJSON *json = getAssetJson(handle);
+        if(json != NULL){
+            int currentID = ui->dialogues->currentID;
+            initializeAllDialogues(ui->dialogues, 10);
+            parseNPCDialogue(ui->dialogues, json);
+            ui->dialogues->currentID = currentID;
+            ui->currentLine = 0;
+            ui->isTextComplete = SDL_FALSE;
+        }
+        releaseAsset(handle);
+    }
+
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    LOG_INFO(LOG_MAP, "Hot reload: %s in %.2f ms", path, elapsed);
+}
+
+static SDL_bool hasJsonExtension(const char *name){
+    size_t length = strlen(name);
+    return length > 5 && strcmp(name + length - 5, ".json") == 0;
+}
+
+// 프레임 사이에 호출: 바뀐 파일이 있으면 반영
+void pollHotReload(GameContext *game){
+#ifdef __linux__
+    if(!hotReloadEnabled || hotReloadFd == -1) return;
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t length;
+    while((length = read(hotReloadFd, buffer, sizeof(buffer))) > 0){
+        for(char *cursor = buffer; cursor < buffer + length; ){
+            struct inotify_event *event = (struct inotify_event *)cursor;
+            cursor += sizeof(struct inotify_event) + event->len;
+            if(event->len == 0 || !hasJsonExtension(event->name)) continue;
+
+            if(event->wd == tileWatch){
+                for(int i = 0; i < currentMapCount; i++){
+                    // 경로 구분자만 다를 수 있으므로 파일 이름으로 비교
+                    const char *name = maps[i].path + strlen(maps[i].path) - strlen(event->name);
+                    if(name >= maps[i].path && strcmp(name, event->name) == 0 &&
+                       (name == maps[i].path || name[-1] == '/' || name[-1] == '\\')){
+                        reloadMap(game, i);
+                        break;
+                    }
+                }
+            }
+            else if(event->wd == eventWatch){
+                char path[128];
+                snprintf(path, sizeof(path), "resource/eventID/%s", event->name);
+                reloadDialogue(game, path, atoi(event->name));
+            }
+        }
+    }
+#endif
+}
+
+void shutdownHotReload(){
+#ifdef __linux__
+    if(hotReloadFd != -1) close(hotReloadFd);
+    hotReloadFd = -1;
+#endif
+}
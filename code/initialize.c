@@ -17,6 +17,7 @@ void initializeDialogueText(DialogueText *dialogue) {
         memset(dialogue->text[i], 0, sizeof(dialogue->text[i]));
     }
     dialogue->textLineCount = 0;
+    dialogue->seID = SOUND_NONE;
 
     // 선택지 초기화
     dialogue->optionCount = 0;
@@ -35,32 +36,76 @@ void initializeAllDialogues(DialogueText *dialogues, int count){
     }
 }
 
-// 애니메이션 프레임 메모리 해제 예제
-void freeAnimations(tileAnimation *animations, int count){
+// 상호작용이 가진 문자열 해제
+void freeInteractions(){
+    for(int i = 0; i < (int)SDL_arraysize(interactions); i++){
+        MEM_FREE(interactions[i].propertyText);
+        MEM_FREE(interactions[i].SE);
+        interactions[i].propertyText = NULL;
+        interactions[i].SE = NULL;
+    }
+    interactionCount = 0;
+}
+
+// 맵 타일 데이터 해제 (맵 JSON은 에셋이나 핫 리로드 쪽에서 해제)
+void freeMapData(Map maps[], int count){
     for(int i = 0; i < count; i++){
-        if(animations[i].frames != NULL){
-            free(animations[i].frames); // 동적 메모리 해제
-            animations[i].frames = NULL;
-        }
+        MEM_FREE(maps[i].tileData);
+        maps[i].tileData = NULL;
     }
 }
 
-void freeAnimationFrames(SDL_Texture **frames, int frameCount){
-    if (frames) {
-        for (int i = 0; i < frameCount; i++) {
-            if (frames[i]) {
-                SDL_DestroyTexture(frames[i]); // 텍스처 해제
-            }
-        }
-        free(frames); // 프레임 배열 메모리 해제
+// 애니메이션 시트 반납
+void freeAnimations(tileAnimation *animations, int count){
+    for(int i = 0; i < count; i++){
+        releaseAsset(animations[i].sheetAsset);
+        animations[i].sheetAsset = ASSET_NONE;
+        animations[i].sheet = NULL;
     }
 }
 
-// SoundManager의 모든 사운드 해제
-void freeSoundEffects(){
-    for (int i = 0; i < soundManager.effectCount; ++i) {
-        Mix_FreeChunk(soundManager.effects[i].chunk);
-        soundManager.effects[i].chunk = NULL;
+// 판 하나의 상태 초기화 (맵과 상점 목록, NPC 배치 지점을 다 읽은 뒤에 호출)
+void initGameContext(GameContext *game, Uint32 currentTime){
+    memset(game, 0, sizeof(GameContext));
+
+    // 플레이어 좌표 (물리엔진과 렌더링(SDL_Rect) 분리용)
+    PlayerState *player = &game->player;
+    player->x = player->previousX = 12000.0f;
+    player->y = player->previousY = 360.0f;
+    player->rect = (SDL_Rect){ 0, 0, 72, 72 };
+    player->direction = 1;
+    player->frameTimer = -1;
+    player->gold = 10000;
+
+    game->camera.x = 11500.0f;
+    game->camera.rect = (SDL_Rect){ 0, 0, 800, 600 };
+
+    // UI (상점 재고는 판마다 따로 셈)
+    UIState *ui = &game->ui;
+    ui->textDisplayTimer = -1;
+    ui->fontSize = 24;
+    memcpy(ui->items, shopCatalog, sizeof(Shop) * shopCatalogCount);
+    ui->itemCount = shopCatalogCount;
+
+    WorldState *world = &game->world;
+    for(int i = 0; i < (int)SDL_arraysize(world->animations); i++){
+        world->animations[i].frameTimer = -1;
     }
-    soundManager.effectCount = 0;
-}
\ No newline at end of file
+    world->promptInteraction = -1;
+    world->pendingEventInteraction = -1;
+    world->pendingEventSheet = ASSET_NONE;
+    world->pendingEventDialogue = ASSET_NONE;
+    world->musicMap = -1;
+
+    initTimers(game, currentTime);
+    game->clock.time = currentTime;
+    game->clock.lastTime = currentTime;
+    game->clock.physicsAlpha = 1.0f;
+    game->randomState = 0x9E3779B9u;
+    game->audioEnabled = SDL_TRUE;
+
+    // 맵에 배치된 NPC
+    for(int i = 0; i < npcSpawnCount; i++){
+        spawnEntity(game, npcSpawnPoints[i].x, npcSpawnPoints[i].y, 72, 72, npcSpriteSheet);
+    }
+}
@@ -0,0 +1,81 @@
+#include "global.h"
+
+// 이벤트 기반 입력
+// SDL_KEYDOWN / SDL_KEYUP 이벤트를 타임스탬프와 함께 링 버퍼에 쌓아두고, 프레임마다 그 프레임 몫을 잘라서 조회
+// 키 상태를 프레임마다 비교하는 방식과 달리 프레임 사이에 두 번 눌러도 두 번으로 셈
+// 버퍼와 키 상태는 GameContext마다 (InputState, global.h)
+
+// SDL_PollEvent 루프에서 호출
+void recordInputEvent(GameContext *game, const SDL_Event *event){
+    InputState *state = &game->input;
+    if(event->type != SDL_KEYDOWN && event->type != SDL_KEYUP) return;
+    if(event->type == SDL_KEYDOWN && event->key.repeat) return; // 키 반복은 새 입력이 아님
+
+    // 아직 처리되지 않은 이벤트로 버퍼가 가득 차면 새 이벤트는 버리고 개수만 셈
+    if(state->writeIndex - state->frameEnd >= INPUT_BUFFER_SIZE){
+        state->droppedEvents++;
+        return;
+    }
+
+    InputEvent *input = &state->buffer[state->writeIndex & (INPUT_BUFFER_SIZE - 1)];
+    input->timestamp = event->key.timestamp;
+    input->scancode = event->key.keysym.scancode;
+    input->pressed = event->type == SDL_KEYDOWN;
+    state->writeIndex++;
+}
+
+// 프레임 시작 시 한 번 호출: 지난 프레임 이후 쌓인 이벤트를 이번 프레임 몫으로 확정
+void updateInputFrame(GameContext *game){
+    InputState *state = &game->input;
+    state->frameBegin = state->frameEnd;
+    state->frameEnd = state->writeIndex;
+
+    for(Uint32 i = state->frameBegin; i != state->frameEnd; i++){
+        InputEvent *input = &state->buffer[i & (INPUT_BUFFER_SIZE - 1)];
+        if(input->scancode < SDL_NUM_SCANCODES){
+            state->keyDown[input->scancode] = input->pressed;
+        }
+        if(input->pressed && state->pendingTimestamp == 0){
+            state->pendingTimestamp = input->timestamp ? input->timestamp : 1;
+        }
+    }
+}
+
+// 이번 프레임에 [from, to) 시간 안에 눌린 횟수
+int getKeyPressCountBetween(GameContext *game, SDL_Scancode scancode, Uint32 from, Uint32 to){
+    InputState *state = &game->input;
+    int count = 0;
+    for(Uint32 i = state->frameBegin; i != state->frameEnd; i++){
+        InputEvent *input = &state->buffer[i & (INPUT_BUFFER_SIZE - 1)];
+        if(input->pressed && input->scancode == scancode && input->timestamp >= from && input->timestamp < to){
+            count++;
+        }
+    }
+    return count;
+}
+
+// 이번 프레임에 눌린 횟수 (프레임 사이 연타도 정확히 셈)
+int getKeyPressCount(GameContext *game, SDL_Scancode scancode){
+    return getKeyPressCountBetween(game, scancode, 0, 0xFFFFFFFFu);
+}
+
+// 이번 프레임에 새로 눌렸는지 (엣지)
+SDL_bool wasKeyPressed(GameContext *game, SDL_Scancode scancode){
+    return getKeyPressCount(game, scancode) > 0;
+}
+
+SDL_bool isKeyDown(GameContext *game, SDL_Scancode scancode){
+    return scancode < SDL_NUM_SCANCODES && game->input.keyDown[scancode];
+}
+
+// SDL_RenderPresent 직후 호출: 입력이 화면에 나가기까지 걸린 시간 기록
+void markInputPresented(GameContext *game){
+    if(game->input.pendingTimestamp == 0) return;
+
+    InputState *state = &game->input;
+    Uint32 latency = SDL_GetTicks() - state->pendingTimestamp;
+    state->latencyLast = latency;
+    if(latency > state->latencyMax) state->latencyMax = latency;
+    state->latencyAverage = state->latencyAverage == 0.0f ? latency : state->latencyAverage * 0.9f + latency * 0.1f;
+    state->pendingTimestamp = 0;
+}
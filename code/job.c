@@ -0,0 +1,258 @@
+#include "global.h"
+
+// 작업 훔치기(work-stealing) 잡 시스템
+// 코어마다 워커 스레드 하나씩 두고, 각자 자기 큐 아래쪽에서 꺼내 쓰다가 비면 다른 큐 위쪽에서 훔쳐옴
+// 메인 스레드는 0번 워커로 취급하고, 카운터를 기다리는 동안 놀지 않고 같이 작업을 처리함
+// parallelFor는 인덱스 범위를 서로 겹치지 않게 나눠 주므로, 인덱스별 작업이 독립적이면 결과는 항상 같음
+#define MAX_JOB_WORKERS 16   // 메인 스레드 포함 최대 워커 수
+#define JOB_QUEUE_SIZE 256   // 워커당 큐 크기 (2의 거듭제곱)
+#define JOB_TIMING_SIZE 1024 // 워커당 보관할 잡 측정 기록 수
+#define JOB_WAIT_SPINS 64    // 카운터를 기다릴 때 양보하기 전까지 pause로 도는 횟수
+
+#ifndef SDL_CPUPauseInstruction
+#define SDL_CPUPauseInstruction() SDL_CompilerBarrier() // SDL 2.24 이전에는 없음
+#endif
+
+typedef struct Job{
+    JobFunction function;
+    void *data;
+    int begin, end;         // 처리할 인덱스 범위 [begin, end)
+    SDL_atomic_t *counter;  // 끝나면 1 감소 (0이 되면 의존하는 쪽이 진행)
+    const char *name;       // 프로파일링용 이름
+} Job;
+
+typedef struct JobQueue{
+    Job jobs[JOB_QUEUE_SIZE];
+    int top;                // 훔쳐가는 쪽 (오래된 잡)
+    int bottom;             // 주인이 넣고 빼는 쪽 (최근 잡)
+    SDL_SpinLock lock;
+} JobQueue;
+
+JobQueue jobQueues[MAX_JOB_WORKERS];
+SDL_Thread *jobThreads[MAX_JOB_WORKERS];
+int jobWorkerCount = 1;             // 메인 스레드 포함
+SDL_atomic_t jobSystemRunning;
+SDL_sem *jobSemaphore = NULL;       // 잡이 들어오면 자고 있는 워커를 깨움
+static _Thread_local int jobWorkerIndex = 0;
+static _Thread_local SDL_bool isJobThread = SDL_FALSE; // 메인 스레드나 워커 (다른 스레드에서 돌리는 시뮬레이션은 큐를 쓰지 않음)
+
+// 잡별 시간 측정 (워커마다 자기 링 버퍼에만 씀)
+// 프로파일러가 내보내는 동안 같이 읽으므로 워커별 스핀락으로 보호 (평소에는 주인만 잡아서 경합 없음)
+SDL_atomic_t jobTimingEnabled; // 메인 스레드가 켜고 워커가 읽음
+JobTiming jobTimings[MAX_JOB_WORKERS][JOB_TIMING_SIZE];
+Uint32 jobTimingCount[MAX_JOB_WORKERS]; // 누적 기록 수 (링 버퍼 위치는 % JOB_TIMING_SIZE)
+SDL_SpinLock jobTimingLocks[MAX_JOB_WORKERS];
+
+Uint32 getJobTimingCount(int worker){
+    if(worker < 0 || worker >= jobWorkerCount) return 0;
+    SDL_AtomicLock(&jobTimingLocks[worker]);
+    Uint32 count = jobTimingCount[worker];
+    SDL_AtomicUnlock(&jobTimingLocks[worker]);
+    return count;
+}
+
+// index번째(누적) 기록을 timing에 복사, 이미 덮어써졌거나 아직 없으면 SDL_FALSE
+SDL_bool getJobTiming(int worker, Uint32 index, JobTiming *timing){
+    if(worker < 0 || worker >= jobWorkerCount) return SDL_FALSE;
+    SDL_bool found = SDL_FALSE;
+    SDL_AtomicLock(&jobTimingLocks[worker]);
+    if(index < jobTimingCount[worker] && jobTimingCount[worker] - index <= JOB_TIMING_SIZE){
+        *timing = jobTimings[worker][index % JOB_TIMING_SIZE];
+        found = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&jobTimingLocks[worker]);
+    return found;
+}
+
+static SDL_bool pushJob(int worker, const Job *job){
+    JobQueue *queue = &jobQueues[worker];
+    SDL_bool pushed = SDL_FALSE;
+
+    SDL_AtomicLock(&queue->lock);
+    if(queue->bottom - queue->top < JOB_QUEUE_SIZE){
+        queue->jobs[queue->bottom & (JOB_QUEUE_SIZE - 1)] = *job;
+        queue->bottom++;
+        pushed = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return pushed;
+}
+
+// 주인: 가장 최근에 넣은 잡부터 (캐시에 남아있을 확률이 높음)
+static SDL_bool popJob(int worker, Job *job){
+    JobQueue *queue = &jobQueues[worker];
+    SDL_bool popped = SDL_FALSE;
+
+    SDL_AtomicLock(&queue->lock);
+    if(queue->bottom > queue->top){
+        queue->bottom--;
+        *job = queue->jobs[queue->bottom & (JOB_QUEUE_SIZE - 1)];
+        popped = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return popped;
+}
+
+// 도둑: 가장 오래된 잡부터 (보통 더 큰 덩어리)
+static SDL_bool stealJob(int victim, Job *job){
+    JobQueue *queue = &jobQueues[victim];
+    SDL_bool stolen = SDL_FALSE;
+
+    if(!SDL_AtomicTryLock(&queue->lock)) return SDL_FALSE; // 바쁘면 다른 큐를 노림
+    if(queue->bottom > queue->top){
+        *job = queue->jobs[queue->top & (JOB_QUEUE_SIZE - 1)];
+        queue->top++;
+        stolen = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return stolen;
+}
+
+static void executeJob(const Job *job){
+    int worker = jobWorkerIndex;
+    SDL_bool timed = SDL_AtomicGet(&jobTimingEnabled) && isJobThread; // 측정 링 버퍼는 워커마다 하나뿐
+    Uint64 start = timed ? SDL_GetPerformanceCounter() : 0;
+
+    job->function(job->data, job->begin, job->end);
+
+    if(timed){
+        Uint64 end = SDL_GetPerformanceCounter();
+        SDL_AtomicLock(&jobTimingLocks[worker]);
+        JobTiming *timing = &jobTimings[worker][jobTimingCount[worker] % JOB_TIMING_SIZE];
+        timing->name = job->name;
+        timing->worker = worker;
+        timing->count = job->end - job->begin;
+        timing->start = start;
+        timing->end = end;
+        jobTimingCount[worker]++;
+        SDL_AtomicUnlock(&jobTimingLocks[worker]);
+    }
+
+    if(job->counter != NULL){
+        SDL_AtomicAdd(job->counter, -1);
+    }
+}
+
+// 잡 하나 처리 시도 (내 큐 -> 다른 워커 큐 순서), 처리했으면 SDL_TRUE
+static SDL_bool runOneJob(){
+    Job job;
+    int self = jobWorkerIndex;
+
+    if(popJob(self, &job)){
+        executeJob(&job);
+        return SDL_TRUE;
+    }
+    for(int i = 1; i < jobWorkerCount; i++){
+        if(stealJob((self + i) % jobWorkerCount, &job)){
+            executeJob(&job);
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+static int jobWorkerThread(void *data){
+    jobWorkerIndex = (int)(intptr_t)data;
+    isJobThread = SDL_TRUE;
+
+    while(SDL_AtomicGet(&jobSystemRunning)){
+        if(!runOneJob()){
+            SDL_SemWaitTimeout(jobSemaphore, 10); // 할 일이 없으면 잠깐 잠 (신호를 놓쳐도 10ms 안에 다시 확인)
+        }
+    }
+    return 0;
+}
+
+// 코어 수만큼 워커 생성 (workerCount가 0이면 자동, 1이면 메인 스레드 혼자)
+void initJobSystem(int workerCount){
+    if(workerCount <= 0) workerCount = SDL_GetCPUCount();
+    if(workerCount > MAX_JOB_WORKERS) workerCount = MAX_JOB_WORKERS;
+    if(workerCount < 1) workerCount = 1;
+
+    memset(jobQueues, 0, sizeof(jobQueues));
+    jobSemaphore = SDL_CreateSemaphore(0);
+    SDL_AtomicSet(&jobSystemRunning, 1);
+    jobWorkerIndex = 0;
+    jobWorkerCount = 1;
+    isJobThread = SDL_TRUE;
+
+    for(int i = 1; i < workerCount; i++){
+        jobThreads[i] = SDL_CreateThread(jobWorkerThread, "JobWorker", (void *)(intptr_t)i);
+        if(jobThreads[i] == NULL){
+            LOG_ERROR(LOG_CORE, "Failed to create job worker %d: %s", i, SDL_GetError());
+            break;
+        }
+        jobWorkerCount++;
+    }
+    LOG_INFO(LOG_CORE, "Job system started with %d workers", jobWorkerCount);
+}
+
+void shutdownJobSystem(){
+    SDL_AtomicSet(&jobSystemRunning, 0);
+    for(int i = 1; i < jobWorkerCount; i++){
+        SDL_SemPost(jobSemaphore);
+    }
+    for(int i = 1; i < jobWorkerCount; i++){
+        SDL_WaitThread(jobThreads[i], NULL);
+        jobThreads[i] = NULL;
+    }
+    jobWorkerCount = 1;
+    if(jobSemaphore != NULL){
+        SDL_DestroySemaphore(jobSemaphore);
+        jobSemaphore = NULL;
+    }
+}
+
+// 잡 등록, counter는 미리 잡 개수만큼 올려둔 상태여야 함 (큐가 가득 차면 그 자리에서 실행)
+void submitJob(const char *name, JobFunction function, void *data, int begin, int end, SDL_atomic_t *counter){
+    Job job = { function, data, begin, end, counter, name };
+
+    if(jobWorkerCount <= 1 || !pushJob(jobWorkerIndex, &job)){
+        executeJob(&job);
+        return;
+    }
+    SDL_SemPost(jobSemaphore);
+}
+
+// 카운터가 0이 될 때까지 기다림, 그동안 다른 잡을 대신 처리
+void waitForJobCounter(SDL_atomic_t *counter){
+    int idleSpins = 0;
+    while(SDL_AtomicGet(counter) > 0){
+        if(runOneJob()){
+            idleSpins = 0;
+            continue;
+        }
+        // 남은 잡이 다른 워커에서 실행 중: 잠깐은 pause로 돌고 (곧 끝나는 경우가 대부분), 길어지면 코어를 양보
+        if(++idleSpins < JOB_WAIT_SPINS){
+            SDL_CPUPauseInstruction();
+        }
+        else{
+            SDL_Delay(0);
+        }
+    }
+}
+
+// [begin, end) 범위를 grainSize 단위로 쪼개서 병렬 처리하고 전부 끝나면 반환
+void parallelFor(const char *name, int begin, int end, int grainSize, JobFunction function, void *data){
+    int total = end - begin;
+    if(total <= 0) return;
+    if(grainSize < 1) grainSize = 1;
+
+    // 작거나 워커가 없으면 쪼개는 비용이 더 큼, 잡 시스템 밖의 스레드는 그 자리에서 처리
+    if(total <= grainSize || jobWorkerCount <= 1 || !isJobThread){
+        Job job = { function, data, begin, end, NULL, name };
+        executeJob(&job);
+        return;
+    }
+
+    SDL_atomic_t counter;
+    int chunkCount = (total + grainSize - 1) / grainSize;
+    SDL_AtomicSet(&counter, chunkCount);
+
+    for(int chunk = 0; chunk < chunkCount; chunk++){
+        int chunkBegin = begin + chunk * grainSize;
+        int chunkEnd = chunkBegin + grainSize < end ? chunkBegin + grainSize : end;
+        submitJob(name, function, data, chunkBegin, chunkEnd, &counter);
+    }
+    waitForJobCounter(&counter);
+}
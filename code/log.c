@@ -0,0 +1,208 @@
+#include "global.h"
+#include <stdarg.h>
+#include <signal.h>
+#ifdef _WIN32
+#include <io.h>
+#define LOG_WRITE _write
+#else
+#include <unistd.h>
+#define LOG_WRITE write
+#endif
+
+// 비동기 로거
+// 호출한 스레드에서 링 버퍼 칸 하나를 잡아 거기에 바로 포맷하고, 콘솔 출력은 로거 스레드가 모아서 처리
+// 칸 잡기는 칸마다 순번(sequence)을 두는 잠금 없는 큐 (여러 스레드가 동시에 써도 됨, 읽는 쪽은 로거 스레드 하나)
+// 버퍼가 가득 차면 기다리지 않고 버림 (버린 수는 다음 출력 때 알림)
+// 정상 종료, exit(), 크래시 시그널 때 남은 로그를 모두 내보냄
+// 줄은 쓰는 쪽에서 머리말과 줄바꿈까지 다 포맷해 두므로, 시그널 핸들러는 write만으로 내보낼 수 있음
+#define LOG_RING_SIZE 4096      // 2의 거듭제곱 (로딩 때 한꺼번에 쏟아지는 로그도 담을 수 있게)
+#define LOG_LINE_LENGTH 280     // 머리말 + 본문 240자 + 줄바꿈
+
+typedef struct LogEntry{
+    SDL_atomic_t sequence;      // 칸 상태 (쓸 수 있음: 위치, 읽을 수 있음: 위치 + 1)
+    LogLevel level;
+    int length;
+    char line[LOG_LINE_LENGTH]; // "[  시간.ms] 수준 분류 본문\n"
+} LogEntry;
+
+static const char *logLevelNames[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+static const char *logCategoryNames[LOG_CATEGORY_COUNT] = { "core", "map", "dialogue", "ui", "audio", "asset" };
+
+LogLevel logLevel = (LogLevel)LOG_MIN_LEVEL;  // 실행 인자 --loglevel=debug|info|warn|error
+
+LogEntry logRing[LOG_RING_SIZE];
+SDL_atomic_t logWriteIndex;     // 쓰는 쪽이 다음에 잡을 위치
+Uint32 logReadIndex = 0;        // 로거 스레드 (또는 flushLog)만 씀
+SDL_atomic_t logDropped;
+SDL_SpinLock logDrainLock;
+SDL_sem *logSemaphore = NULL;
+SDL_Thread *logThread = NULL;
+SDL_atomic_t logRunning;
+
+// 읽을 수 있는 칸을 전부 내보냄
+static void drainLog(){
+    SDL_AtomicLock(&logDrainLock);
+    int written = 0;
+    for(;;){
+        LogEntry *entry = &logRing[logReadIndex & (LOG_RING_SIZE - 1)];
+        if(SDL_AtomicGet(&entry->sequence) != (int)(logReadIndex + 1)) break;
+
+        fwrite(entry->line, 1, entry->length, entry->level >= LOG_LEVEL_WARN ? stderr : stdout);
+        SDL_AtomicSet(&entry->sequence, (int)(logReadIndex + LOG_RING_SIZE)); // 한 바퀴 뒤에 다시 쓸 수 있음
+        logReadIndex++;
+        written++;
+    }
+    int dropped = SDL_AtomicSet(&logDropped, 0);
+    if(dropped > 0){
+        fprintf(stderr, "[log] %d messages dropped (ring buffer full)\n", dropped);
+    }
+    if(written > 0){
+        fflush(stdout);
+    }
+    SDL_AtomicUnlock(&logDrainLock);
+}
+
+static int logThreadMain(void *data){
+    while(SDL_AtomicGet(&logRunning)){
+        SDL_SemWaitTimeout(logSemaphore, 50); // 깨워주지 않아도 50ms마다는 비움
+        drainLog();
+    }
+    drainLog();
+    return 0;
+}
+
+// 남은 로그를 지금 바로 내보냄 (종료, 크래시 때)
+void flushLog(){
+    drainLog();
+    fflush(stderr);
+}
+
+static void writeCrashText(const char *text, size_t length){
+    while(length > 0){
+        int written = (int)LOG_WRITE(2, text, (unsigned)length);
+        if(written <= 0) return;
+        text += written;
+        length -= written;
+    }
+}
+
+// 시그널 핸들러 안에서는 write 같은 async-signal-safe 함수만 씀 (stdio와 잠금은 다른 스레드가 잡고 있을 수 있음)
+// 로거 스레드가 비우는 중이었으면 몇 줄이 두 번 나올 수 있지만 빠지지는 않음
+static void logCrashHandler(int signalNumber){
+    char header[64] = "[log] fatal signal ";
+    size_t length = strlen(header);
+    char digits[12];
+    int digitCount = 0;
+    unsigned value = (unsigned)signalNumber;
+    do{
+        digits[digitCount++] = (char)('0' + value % 10);
+        value /= 10;
+    } while(value > 0 && digitCount < (int)sizeof(digits));
+    while(digitCount > 0) header[length++] = digits[--digitCount];
+    const char tail[] = ", flushing log\n";
+    memcpy(header + length, tail, sizeof(tail) - 1);
+    writeCrashText(header, length + sizeof(tail) - 1);
+
+    Uint32 index = logReadIndex;
+    for(int i = 0; i < LOG_RING_SIZE; i++, index++){
+        LogEntry *entry = &logRing[index & (LOG_RING_SIZE - 1)];
+        if(SDL_AtomicGet(&entry->sequence) != (int)(index + 1)) break;
+        writeCrashText(entry->line, entry->length);
+    }
+
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
+}
+
+// main에서 가장 먼저 호출
+void initLogger(){
+    for(int i = 0; i < LOG_RING_SIZE; i++){
+        SDL_AtomicSet(&logRing[i].sequence, i);
+    }
+    SDL_AtomicSet(&logWriteIndex, 0);
+    SDL_AtomicSet(&logDropped, 0);
+    SDL_AtomicSet(&logRunning, 1);
+    logSemaphore = SDL_CreateSemaphore(0);
+    logThread = SDL_CreateThread(logThreadMain, "Logger", NULL);
+    if(logThread == NULL){
+        fprintf(stderr, "Failed to create logger thread, logging synchronously: %s\n", SDL_GetError());
+    }
+
+    atexit(flushLog); // showErrorAndExit 등에서 exit()로 끝날 때
+    signal(SIGSEGV, logCrashHandler);
+    signal(SIGABRT, logCrashHandler);
+    signal(SIGFPE, logCrashHandler);
+    signal(SIGILL, logCrashHandler);
+}
+
+void shutdownLogger(){
+    SDL_AtomicSet(&logRunning, 0);
+    if(logThread != NULL){
+        SDL_SemPost(logSemaphore);
+        SDL_WaitThread(logThread, NULL);
+        logThread = NULL;
+    }
+    flushLog();
+    if(logSemaphore != NULL){
+        SDL_DestroySemaphore(logSemaphore);
+        logSemaphore = NULL;
+    }
+}
+
+// LOG_* 매크로가 부름: 링 버퍼에 포맷해 넣음 (출력은 로거 스레드에서)
+void logMessage(LogLevel level, LogCategory category, const char *format, ...){
+    if(level < logLevel) return;
+
+    // 빈 칸 잡기
+    Uint32 position = (Uint32)SDL_AtomicGet(&logWriteIndex);
+    LogEntry *entry;
+    for(;;){
+        entry = &logRing[position & (LOG_RING_SIZE - 1)];
+        int difference = SDL_AtomicGet(&entry->sequence) - (int)position;
+        if(difference == 0){
+            if(SDL_AtomicCAS(&logWriteIndex, (int)position, (int)(position + 1))) break;
+        }
+        else if(difference < 0){
+            SDL_AtomicAdd(&logDropped, 1); // 가득 참 (로거가 아직 못 비움)
+            return;
+        }
+        position = (Uint32)SDL_AtomicGet(&logWriteIndex);
+    }
+
+    Uint32 time = SDL_GetTicks();
+    int prefix = snprintf(entry->line, sizeof(entry->line), "[%6u.%03u] %-5s %-8s ",
+                          time / 1000, time % 1000, logLevelNames[level], logCategoryNames[category]);
+    if(prefix < 0) prefix = 0;
+    if(prefix > (int)sizeof(entry->line) - 2) prefix = (int)sizeof(entry->line) - 2;
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(entry->line + prefix, sizeof(entry->line) - 1 - prefix, format, arguments); // 줄바꿈 자리 남김
+    va_end(arguments);
+
+    // 끝의 줄바꿈은 하나로 맞춤
+    size_t length = strlen(entry->line);
+    if(length > 0 && entry->line[length - 1] == '\n') length--;
+    entry->line[length++] = '\n';
+    entry->line[length] = '\0';
+    entry->level = level;
+    entry->length = (int)length;
+
+    SDL_AtomicSet(&entry->sequence, (int)(position + 1)); // 읽어도 됨
+    if(logThread == NULL){
+        drainLog();
+    }
+    else if(level >= LOG_LEVEL_WARN || (position & (LOG_RING_SIZE / 4 - 1)) == 0){
+        SDL_SemPost(logSemaphore); // 경고 이상이거나 버퍼가 1/4씩 찰 때마다 바로 깨움
+    }
+}
+
+// 실행 인자 --loglevel= 값 해석
+void setLogLevel(const char *name){
+    for(int i = 0; i < (int)SDL_arraysize(logLevelNames); i++){
+        if(SDL_strcasecmp(name, logLevelNames[i]) == 0){
+            logLevel = (LogLevel)(i > LOG_MIN_LEVEL ? i : LOG_MIN_LEVEL); // 컴파일 때 뺀 수준은 켤 수 없음
+            return;
+        }
+    }
+    LOG_WARN(LOG_CORE, "Unknown log level: %s", name);
+}
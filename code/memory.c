@@ -0,0 +1,205 @@
+#include "global.h"
+#include <stddef.h>
+#include <cJSON.h>
+
+// 할당 추적
+// MEM_ALLOC/MEM_STRDUP/MEM_FREE로 할당하면 블록 앞에 헤더를 붙여 분야(MemoryTag)별로 살아있는 바이트, 최고치, 프레임당 할당 수를 셈
+// 살아있는 블록은 연결 리스트로 이어 두고 종료 때 남은 것을 할당한 위치(파일:줄)별로 누수 보고
+// cJSON은 훅으로 연결해서 MEM_JSON으로, SDL 쪽이 가진 메모리(텍스처, 디코딩된 소리)는 trackExternal로 크기만 셈
+// F5로 현재 사용량 출력
+#define MEMORY_MAGIC 0x4D454D31u  // "MEM1", 추적 안 된 포인터를 MEM_FREE 했는지 확인용
+
+typedef struct MemoryHeader{
+    struct MemoryHeader *previous, *next;
+    const char *file;
+    int line;
+    MemoryTag tag;
+    size_t size;
+    Uint32 magic;
+} MemoryHeader;
+
+// 헤더 뒤의 사용자 영역도 malloc과 같은 정렬이 되도록
+typedef union MemoryBlock{
+    MemoryHeader header;
+    max_align_t align;
+} MemoryBlock;
+
+typedef struct MemoryStats{
+    SDL_atomic_t liveBytes;
+    SDL_atomic_t peakBytes;
+    SDL_atomic_t liveCount;
+    SDL_atomic_t totalCount;  // 누적 할당 수
+    SDL_atomic_t frameCount;  // 이번 프레임 할당 수
+    int lastFrameCount;       // 지난 프레임 할당 수 (메인 스레드)
+} MemoryStats;
+
+static const char *memoryTagNames[MEM_TAG_COUNT] = { "core", "map", "json", "text", "audio", "texture", "ui" };
+
+MemoryStats memoryStats[MEM_TAG_COUNT];
+MemoryHeader *memoryList = NULL;  // 살아있는 블록 (memoryLock)
+SDL_SpinLock memoryLock;
+
+static void countAllocation(MemoryTag tag, int bytes){
+    MemoryStats *stats = &memoryStats[tag];
+    int live = SDL_AtomicAdd(&stats->liveBytes, bytes) + bytes;
+    int peak = SDL_AtomicGet(&stats->peakBytes);
+    while(live > peak && !SDL_AtomicCAS(&stats->peakBytes, peak, live)){
+        peak = SDL_AtomicGet(&stats->peakBytes);
+    }
+    SDL_AtomicIncRef(&stats->liveCount);
+    SDL_AtomicIncRef(&stats->totalCount);
+    SDL_AtomicIncRef(&stats->frameCount);
+}
+
+static void countFree(MemoryTag tag, int bytes){
+    SDL_AtomicAdd(&memoryStats[tag].liveBytes, -bytes);
+    SDL_AtomicAdd(&memoryStats[tag].liveCount, -1);
+}
+
+void *trackedMalloc(MemoryTag tag, size_t size, const char *file, int line){
+    MemoryBlock *block = malloc(sizeof(MemoryBlock) + size);
+    if(block == NULL) return NULL;
+
+    MemoryHeader *header = &block->header;
+    header->file = file;
+    header->line = line;
+    header->tag = tag;
+    header->size = size;
+    header->magic = MEMORY_MAGIC;
+    header->previous = NULL;
+
+    SDL_AtomicLock(&memoryLock);
+    header->next = memoryList;
+    if(memoryList != NULL) memoryList->previous = header;
+    memoryList = header;
+    SDL_AtomicUnlock(&memoryLock);
+
+    countAllocation(tag, (int)size);
+    return block + 1;
+}
+
+void *trackedCalloc(MemoryTag tag, size_t count, size_t size, const char *file, int line){
+    void *data = trackedMalloc(tag, count * size, file, line);
+    if(data != NULL) memset(data, 0, count * size);
+    return data;
+}
+
+char *trackedStrdup(MemoryTag tag, const char *text, const char *file, int line){
+    size_t length = strlen(text) + 1;
+    char *copy = trackedMalloc(tag, length, file, line);
+    if(copy != NULL) memcpy(copy, text, length);
+    return copy;
+}
+
+void trackedFree(void *data){
+    if(data == NULL) return;
+
+    MemoryHeader *header = &((MemoryBlock *)data - 1)->header;
+    if(header->magic != MEMORY_MAGIC){
+        LOG_ERROR(LOG_CORE, "MEM_FREE on untracked or already freed pointer %p", data);
+        return;
+    }
+    header->magic = 0; // 두 번 해제하면 위에서 걸림
+
+    SDL_AtomicLock(&memoryLock);
+    if(header->previous != NULL) header->previous->next = header->next;
+    else memoryList = header->next;
+    if(header->next != NULL) header->next->previous = header->previous;
+    SDL_AtomicUnlock(&memoryLock);
+
+    countFree(header->tag, (int)header->size);
+    free((MemoryBlock *)data - 1);
+}
+
+// SDL이 가진 메모리 크기 반영 (만들 때 +, 해제할 때 -)
+void trackExternal(MemoryTag tag, int bytes){
+    if(bytes >= 0) countAllocation(tag, bytes);
+    else countFree(tag, -bytes);
+}
+
+static void *cJSONMalloc(size_t size){
+    return trackedMalloc(MEM_JSON, size, "cJSON", 0);
+}
+
+// main에서 cJSON을 처음 쓰기 전에 호출
+void initMemoryTracking(){
+    cJSON_Hooks hooks = { cJSONMalloc, trackedFree };
+    cJSON_InitHooks(&hooks);
+}
+
+// 프레임 끝에서 호출: 이번 프레임 할당 수를 넘겨둠
+void endMemoryFrame(){
+    for(int i = 0; i < MEM_TAG_COUNT; i++){
+        memoryStats[i].lastFrameCount = SDL_AtomicSet(&memoryStats[i].frameCount, 0);
+    }
+}
+
+// 지난 프레임 전체 할당 수
+int getFrameAllocationCount(){
+    int count = 0;
+    for(int i = 0; i < MEM_TAG_COUNT; i++){
+        count += memoryStats[i].lastFrameCount;
+    }
+    return count;
+}
+
+// 분야별 살아있는 바이트 (텔레메트리용)
+int getMemoryLiveBytes(MemoryTag tag){
+    return SDL_AtomicGet(&memoryStats[tag].liveBytes);
+}
+
+void dumpMemoryUsage(){
+    int totalLive = 0;
+    LOG_INFO(LOG_CORE, "memory     live KB   peak KB   blocks   allocs/frame   total allocs");
+    for(int i = 0; i < MEM_TAG_COUNT; i++){
+        MemoryStats *stats = &memoryStats[i];
+        int live = SDL_AtomicGet(&stats->liveBytes);
+        totalLive += live;
+        LOG_INFO(LOG_CORE, "%-8s %9.1f %9.1f %8d %14d %14d", memoryTagNames[i], live / 1024.0f,
+                 SDL_AtomicGet(&stats->peakBytes) / 1024.0f, SDL_AtomicGet(&stats->liveCount),
+                 stats->lastFrameCount, SDL_AtomicGet(&stats->totalCount));
+    }
+    LOG_INFO(LOG_CORE, "memory total live: %.1f KB", totalLive / 1024.0f);
+}
+
+// 종료 직전에 호출: 해제되지 않은 블록을 할당 위치별로 묶어서 보고, 누수가 없으면 SDL_TRUE
+SDL_bool reportMemoryLeaks(){
+    typedef struct LeakSite{
+        const char *file;
+        int line;
+        MemoryTag tag;
+        int count;
+        size_t bytes;
+    } LeakSite;
+    LeakSite sites[64];
+    int siteCount = 0, leakCount = 0;
+    size_t leakBytes = 0;
+
+    SDL_AtomicLock(&memoryLock);
+    for(MemoryHeader *header = memoryList; header != NULL; header = header->next){
+        leakCount++;
+        leakBytes += header->size;
+
+        int site = 0;
+        while(site < siteCount && !(sites[site].line == header->line && strcmp(sites[site].file, header->file) == 0)) site++;
+        if(site == siteCount){
+            if(siteCount == (int)SDL_arraysize(sites)) continue; // 자리가 없으면 합계에만
+            sites[siteCount] = (LeakSite){ header->file, header->line, header->tag, 0, 0 };
+            siteCount++;
+        }
+        sites[site].count++;
+        sites[site].bytes += header->size;
+    }
+    SDL_AtomicUnlock(&memoryLock);
+
+    if(leakCount == 0){
+        LOG_INFO(LOG_CORE, "No memory leaks");
+        return SDL_TRUE;
+    }
+    LOG_WARN(LOG_CORE, "Memory leaks: %d blocks, %zu bytes", leakCount, leakBytes);
+    for(int i = 0; i < siteCount; i++){
+        LOG_WARN(LOG_CORE, "  %s:%d [%s] %d blocks, %zu bytes", sites[i].file, sites[i].line,
+                 memoryTagNames[sites[i].tag], sites[i].count, sites[i].bytes);
+    }
+    return SDL_FALSE;
+}
@@ -0,0 +1,116 @@
+#include "global.h"
+
+// 맵별 배경음악 스트리밍
+// 맵 속성 music에 적힌 파일을 플레이어가 그 맵에 들어가면 재생
+// 파일 열기와 헤더 해석은 로더 스레드에서 하고, 디코딩은 SDL_mixer가 오디오 콜백마다 조금씩 스트리밍하므로
+// 곡 전체가 메모리에 올라가지 않고 메인 루프도 멈추지 않음
+#define MUSIC_FADE_TIME 500    // 곡 전환 페이드 (ms)
+
+Mix_Music *currentMusic = NULL;
+char currentMusicPath[64] = "";
+
+// 로더 스레드와 주고받는 상태
+SDL_Thread *musicLoader = NULL;
+SDL_atomic_t musicLoadDone;      // 로더가 끝나면 1
+Mix_Music *loadedMusic = NULL;   // 로더 결과 (musicLoadDone이 1일 때만 읽음)
+char loadingMusicPath[64] = "";  // 로더가 열고 있는 경로
+char pendingMusicPath[64] = "";  // 로딩 중에 또 바뀐 경우 다음에 열 경로 (마지막 요청만 유지)
+SDL_bool hasPendingMusic = SDL_FALSE;
+
+static int musicLoaderThread(void *data){
+    Uint64 start = SDL_GetPerformanceCounter();
+    loadedMusic = Mix_LoadMUS_RW(openAssetFile(loadingMusicPath), 1);
+    recordIOEvent("music", loadingMusicPath, start);
+    if(loadedMusic == NULL){
+        LOG_ERROR(LOG_AUDIO, "Failed to load music %s: %s", loadingMusicPath, Mix_GetError());
+    }
+    SDL_AtomicSet(&musicLoadDone, 1);
+    return 0;
+}
+
+static void startMusicLoader(const char *path){
+    strncpy(loadingMusicPath, path, sizeof(loadingMusicPath) - 1);
+    loadingMusicPath[sizeof(loadingMusicPath) - 1] = '\0';
+    loadedMusic = NULL;
+    SDL_AtomicSet(&musicLoadDone, 0);
+
+    musicLoader = SDL_CreateThread(musicLoaderThread, "MusicLoader", NULL);
+    if(musicLoader == NULL){
+        LOG_ERROR(LOG_AUDIO, "Failed to create music loader: %s", SDL_GetError());
+    }
+}
+
+// 배경음악 바꾸기 (빈 문자열이면 페이드 아웃)
+static void requestMusic(const char *path){
+    if(musicLoader != NULL){
+        // 로딩이 끝나면 이어서 처리
+        strncpy(pendingMusicPath, path, sizeof(pendingMusicPath) - 1);
+        pendingMusicPath[sizeof(pendingMusicPath) - 1] = '\0';
+        hasPendingMusic = SDL_TRUE;
+        return;
+    }
+    if(strcmp(path, currentMusicPath) == 0) return;
+
+    if(path[0] == '\0'){
+        Mix_FadeOutMusic(MUSIC_FADE_TIME);
+        currentMusicPath[0] = '\0';
+        return;
+    }
+    startMusicLoader(path);
+}
+
+// 로딩이 끝난 곡을 이전 곡과 바꿔서 재생
+static void swapLoadedMusic(){
+    SDL_WaitThread(musicLoader, NULL);
+    musicLoader = NULL;
+
+    if(loadedMusic != NULL){
+        Mix_HaltMusic();
+        if(currentMusic != NULL){
+            Mix_FreeMusic(currentMusic);
+        }
+        currentMusic = loadedMusic;
+        loadedMusic = NULL;
+        strncpy(currentMusicPath, loadingMusicPath, sizeof(currentMusicPath) - 1);
+        currentMusicPath[sizeof(currentMusicPath) - 1] = '\0';
+        Mix_FadeInMusic(currentMusic, -1, MUSIC_FADE_TIME);
+    }
+
+    if(hasPendingMusic){
+        hasPendingMusic = SDL_FALSE;
+        requestMusic(pendingMusicPath);
+    }
+}
+
+// 프레임마다 호출: 플레이어가 있는 맵이 바뀌면 그 맵의 곡으로 전환
+// 음악 장치는 하나뿐이라 소리를 내는 컨텍스트(메인 게임)만 바꿈
+void updateMusic(GameContext *game){
+    if(!game->audioEnabled) return;
+    int map = findMapAt(game->player.x);
+
+    if(map != game->world.musicMap){
+        game->world.musicMap = map;
+        requestMusic(maps[map].music);
+    }
+
+    if(musicLoader != NULL && SDL_AtomicGet(&musicLoadDone)){
+        swapLoadedMusic();
+    }
+}
+
+void shutdownMusic(){
+    if(musicLoader != NULL){
+        SDL_WaitThread(musicLoader, NULL);
+        musicLoader = NULL;
+        if(loadedMusic != NULL){
+            Mix_FreeMusic(loadedMusic);
+            loadedMusic = NULL;
+        }
+    }
+    Mix_HaltMusic();
+    if(currentMusic != NULL){
+        Mix_FreeMusic(currentMusic);
+        currentMusic = NULL;
+    }
+    currentMusicPath[0] = '\0';
+}
@@ -0,0 +1,220 @@
+#include "global.h"
+#include "packFormat.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 에셋 팩 (tools/packBuilder.c로 만든 단일 파일)
+// 팩 파일을 통째로 메모리에 매핑해 두고 엔트리를 SDL_RWFromConstMem으로 넘김 (복사 없음, 파일 핸들 하나)
+// 팩에 없는 경로는 기존처럼 개별 파일에서 읽음
+const Uint8 *packData = NULL;      // 매핑된 팩 파일
+size_t packSize = 0;
+const PackEntry *packEntries = NULL;
+int packEntryCount = 0;
+void **packUnpacked = NULL;        // 압축된 엔트리를 푼 버퍼 (처음 열 때 만들고 closePack까지 보관)
+SDL_SpinLock packLock;             // packUnpacked 보호 (로더 스레드와 메인 스레드가 같이 씀)
+
+#ifdef _WIN32
+HANDLE packFile = INVALID_HANDLE_VALUE;
+HANDLE packMapping = NULL;
+#else
+int packFile = -1;
+#endif
+
+static void unmapPack(){
+#ifdef _WIN32
+    if(packData != NULL) UnmapViewOfFile(packData);
+    if(packMapping != NULL) CloseHandle(packMapping);
+    if(packFile != INVALID_HANDLE_VALUE) CloseHandle(packFile);
+    packMapping = NULL;
+    packFile = INVALID_HANDLE_VALUE;
+#else
+    if(packData != NULL) munmap((void *)packData, packSize);
+    if(packFile != -1) close(packFile);
+    packFile = -1;
+#endif
+    packData = NULL;
+    packSize = 0;
+}
+
+// 팩 열기, 없거나 형식이 틀리면 -1 (그래도 개별 파일로 계속 동작)
+int openPack(const char *path){
+#ifdef _WIN32
+    packFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if(packFile == INVALID_HANDLE_VALUE) return -1;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(packFile, &fileSize);
+    packSize = (size_t)fileSize.QuadPart;
+    packMapping = CreateFileMappingA(packFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    packData = packMapping != NULL ? MapViewOfFile(packMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+#else
+    packFile = open(path, O_RDONLY);
+    if(packFile == -1) return -1;
+
+    struct stat fileStat;
+    fstat(packFile, &fileStat);
+    packSize = (size_t)fileStat.st_size;
+    packData = mmap(NULL, packSize, PROT_READ, MAP_PRIVATE, packFile, 0);
+    if(packData == MAP_FAILED) packData = NULL;
+#endif
+    if(packData == NULL){
+        LOG_ERROR(LOG_ASSET, "Failed to map pack %s", path);
+        unmapPack();
+        return -1;
+    }
+
+    const PackHeader *header = (const PackHeader *)packData;
+    if(packSize < sizeof(PackHeader) || header->magic != PACK_MAGIC || header->version != PACK_VERSION ||
+       sizeof(PackHeader) + (size_t)header->entryCount * sizeof(PackEntry) > packSize){
+        LOG_ERROR(LOG_ASSET, "Invalid pack file: %s", path);
+        unmapPack();
+        return -1;
+    }
+
+    packEntries = (const PackEntry *)(packData + sizeof(PackHeader));
+    packEntryCount = (int)header->entryCount;
+    for(int i = 0; i < packEntryCount; i++){
+        if((size_t)packEntries[i].offset + packEntries[i].storedSize > packSize){
+            LOG_ERROR(LOG_ASSET, "Pack entry out of range: %s", packEntries[i].path);
+            unmapPack();
+            packEntryCount = 0;
+            return -1;
+        }
+    }
+    packUnpacked = MEM_CALLOC(MEM_CORE, packEntryCount, sizeof(void *));
+    LOG_INFO(LOG_ASSET, "Pack opened: %s (%d entries, %u KB)", path, packEntryCount, (unsigned)(packSize / 1024));
+    return 0;
+}
+
+void closePack(){
+    for(int i = 0; packUnpacked != NULL && i < packEntryCount; i++){
+        MEM_FREE(packUnpacked[i]);
+    }
+    MEM_FREE(packUnpacked);
+    packUnpacked = NULL;
+    packEntries = NULL;
+    packEntryCount = 0;
+    unmapPack();
+}
+
+SDL_bool isPackOpen(){
+    return packData != NULL;
+}
+
+// 경로로 엔트리 찾기 ('\\'는 '/'로 바꿔서 비교), 없으면 -1
+int findPackEntry(const char *path){
+    char key[PACK_PATH_LENGTH];
+    int length = 0;
+    for(; path[length] != '\0' && length < PACK_PATH_LENGTH - 1; length++){
+        key[length] = path[length] == '\\' ? '/' : path[length];
+    }
+    key[length] = '\0';
+
+    int low = 0, high = packEntryCount - 1;
+    while(low <= high){
+        int mid = (low + high) / 2;
+        int result = strcmp(packEntries[mid].path, key);
+        if(result == 0) return mid;
+        if(result < 0) low = mid + 1;
+        else high = mid - 1;
+    }
+    return -1;
+}
+
+int getPackEntryCount(){
+    return packEntryCount;
+}
+
+const char *getPackEntryPath(int index){
+    return index >= 0 && index < packEntryCount ? packEntries[index].path : NULL;
+}
+
+// LZ 압축 풀기, 성공하면 SDL_TRUE
+static SDL_bool unpackLZ(const Uint8 *source, size_t sourceSize, Uint8 *target, size_t targetSize){
+    const Uint8 *in = source, *inEnd = source + sourceSize;
+    Uint8 *out = target, *outEnd = target + targetSize;
+
+    while(in < inEnd){
+        Uint8 token = *in++;
+        size_t literalLength = token >> 4;
+        if(literalLength == 15){
+            Uint8 more;
+            do{
+                if(in >= inEnd) return SDL_FALSE;
+                more = *in++;
+                literalLength += more;
+            }while(more == 255);
+        }
+        if((size_t)(inEnd - in) < literalLength || (size_t)(outEnd - out) < literalLength) return SDL_FALSE;
+        memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+        if(in >= inEnd) break; // 마지막 시퀀스
+
+        if(inEnd - in < 2) return SDL_FALSE;
+        size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        size_t matchLength = (token & 15);
+        if(matchLength == 15){
+            Uint8 more;
+            do{
+                if(in >= inEnd) return SDL_FALSE;
+                more = *in++;
+                matchLength += more;
+            }while(more == 255);
+        }
+        matchLength += PACK_MIN_MATCH;
+        if(offset == 0 || offset > (size_t)(out - target) || (size_t)(outEnd - out) < matchLength) return SDL_FALSE;
+
+        // 겹치는 복사가 있으므로 한 바이트씩
+        const Uint8 *match = out - offset;
+        for(size_t i = 0; i < matchLength; i++){
+            *out++ = *match++;
+        }
+    }
+    return out == outEnd;
+}
+
+// 엔트리 데이터 (압축된 엔트리는 처음 한 번 풀어서 보관), 실패하면 NULL
+static const void *getPackEntryData(int index){
+    const PackEntry *entry = &packEntries[index];
+    if(!(entry->flags & PACK_ENTRY_COMPRESSED)){
+        return packData + entry->offset;
+    }
+
+    SDL_AtomicLock(&packLock);
+    if(packUnpacked[index] == NULL){
+        Uint8 *buffer = MEM_ALLOC(MEM_CORE, entry->size > 0 ? entry->size : 1);
+        if(buffer != NULL && unpackLZ(packData + entry->offset, entry->storedSize, buffer, entry->size)){
+            packUnpacked[index] = buffer;
+        }
+        else{
+            LOG_ERROR(LOG_ASSET, "Failed to unpack %s", entry->path);
+            MEM_FREE(buffer);
+        }
+    }
+    void *data = packUnpacked[index];
+    SDL_AtomicUnlock(&packLock);
+    return data;
+}
+
+// 에셋 파일 열기: 팩에 있으면 매핑된 메모리를, 없으면 개별 파일을 SDL_RWops로
+// IMG_Load_RW, Mix_LoadWAV_RW, TTF_OpenFontRW 등에 freesrc = 1로 넘기면 됨
+SDL_RWops *openAssetFile(const char *path){
+    if(packData != NULL){
+        int index = findPackEntry(path);
+        if(index != -1){
+            const void *data = getPackEntryData(index);
+            if(data != NULL){
+                return SDL_RWFromConstMem(data, (int)packEntries[index].size);
+            }
+        }
+    }
+    return SDL_RWFromFile(path, "rb");
+}
@@ -0,0 +1,99 @@
+#ifndef PACKFORMAT_H
+#define PACKFORMAT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// 에셋 팩 파일 형식 (게임의 pack.c와 tools/packBuilder.c가 같이 씀)
+// [PackHeader][PackEntry x entryCount][데이터...]
+// 엔트리는 경로 순으로 정렬되어 있어서 이분 탐색으로 찾음, 데이터 시작은 PACK_ALIGNMENT 바이트 정렬
+// 숫자는 모두 리틀 엔디언
+#define PACK_MAGIC 0x4B504444u  // "DDPK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 16
+#define PACK_PATH_LENGTH 104    // 엔트리 하나가 128바이트가 되도록
+
+#define PACK_ENTRY_COMPRESSED 1 // 데이터가 LZ 압축되어 있음 (읽을 때 한 번 풀어서 보관)
+
+typedef struct PackHeader{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+} PackHeader;
+
+typedef struct PackEntry{
+    char path[PACK_PATH_LENGTH]; // '/'로 구분한 상대 경로 (예: resource/audio/[SE]cash.wav)
+    uint32_t offset;             // 파일 시작부터 데이터 위치
+    uint32_t size;               // 원본 크기
+    uint32_t storedSize;         // 팩에 저장된 크기 (압축 안 했으면 size와 같음)
+    uint32_t flags;
+    uint32_t reserved[2];
+} PackEntry;
+
+// LZ 압축 형식 (LZ4 블록과 비슷한 단순한 구조)
+// 토큰 1바이트: 상위 4비트 = 리터럴 길이, 하위 4비트 = 일치 길이 - PACK_MIN_MATCH (15면 255 단위 바이트가 이어짐)
+// 토큰 -> [추가 리터럴 길이] -> 리터럴 -> 오프셋 2바이트 -> [추가 일치 길이], 마지막 시퀀스는 리터럴만
+#define PACK_MIN_MATCH 4
+#define PACK_HASH_BITS 12
+
+// 압축은 packBuilder와 세이브 스레드(save.c)가 같이 씀, 풀기는 pack.c의 unpackLZ
+static unsigned char *writePackLength(unsigned char *out, size_t length){
+    while(length >= 255){
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = (unsigned char)length;
+    return out;
+}
+
+// LZ 압축, 압축된 크기 반환 (target은 sourceSize + sourceSize / 255 + 16 이상)
+static size_t packLZ(const unsigned char *source, size_t sourceSize, unsigned char *target){
+    int table[1 << PACK_HASH_BITS]; // 스택에 둬서 여러 스레드에서 불러도 됨
+    const unsigned char *in = source, *end = source + sourceSize, *literal = source;
+    unsigned char *out = target;
+
+    for(int i = 0; i < (1 << PACK_HASH_BITS); i++) table[i] = -1;
+
+    while(in + PACK_MIN_MATCH <= end){
+        unsigned int sequence = in[0] | (in[1] << 8) | (in[2] << 16) | ((unsigned int)in[3] << 24);
+        unsigned int hash = (sequence * 2654435761u) >> (32 - PACK_HASH_BITS);
+        int candidate = table[hash];
+        table[hash] = (int)(in - source);
+
+        if(candidate < 0 || in - (source + candidate) > 65535 || memcmp(source + candidate, in, PACK_MIN_MATCH) != 0){
+            in++;
+            continue;
+        }
+
+        const unsigned char *match = source + candidate;
+        size_t matchLength = PACK_MIN_MATCH;
+        while(in + matchLength < end && match[matchLength] == in[matchLength]) matchLength++;
+
+        size_t literalLength = in - literal;
+        size_t extraMatch = matchLength - PACK_MIN_MATCH;
+        unsigned char *token = out++;
+        *token = (unsigned char)(((literalLength < 15 ? literalLength : 15) << 4) | (extraMatch < 15 ? extraMatch : 15));
+        if(literalLength >= 15) out = writePackLength(out, literalLength - 15);
+        memcpy(out, literal, literalLength);
+        out += literalLength;
+
+        size_t offset = in - match;
+        *out++ = (unsigned char)(offset & 0xFF);
+        *out++ = (unsigned char)(offset >> 8);
+        if(extraMatch >= 15) out = writePackLength(out, extraMatch - 15);
+
+        in += matchLength;
+        literal = in;
+    }
+
+    // 남은 리터럴
+    size_t literalLength = end - literal;
+    *out++ = (unsigned char)((literalLength < 15 ? literalLength : 15) << 4);
+    if(literalLength >= 15) out = writePackLength(out, literalLength - 15);
+    memcpy(out, literal, literalLength);
+    out += literalLength;
+    return out - target;
+}
+
+#endif // PACKFORMAT_H
@@ -0,0 +1,89 @@
+#include "global.h"
+#include <math.h>
+
+// 이벤트 에셋 미리 읽기
+// 이벤트 상호작용(침대, 냉장고, 문 등)에 필요한 애니메이션 시트와 대화 JSON은 로딩 때 eventID로 이미 정해져 있으므로
+// 플레이어가 영역 근처(prefetchRadius)에 오면 로더에 미리 요청해 두고, 멀어지면(반경의 1.5배) 반납
+// E를 눌렀을 때 이미 준비됐으면 적중, 읽는 중이었으면 늦음, 요청조차 안 했으면 놓침으로 셈
+// 요청 상태와 적중 통계는 컨텍스트마다 (WorldState.prefetch), 같은 경로는 에셋 로더가 참조 횟수로 공유
+float prefetchRadius = 600.0f;  // 실행 인자 --prefetchradius=N (픽셀)
+
+static void requestEventAssets(PrefetchState *prefetch, int index){
+    char filePath[64];
+    snprintf(filePath, sizeof(filePath), "resource/eventID/%d.png", interactions[index].eventID);
+    prefetch->sheet[index] = requestAsset(filePath, ASSET_TEXTURE);
+    snprintf(filePath, sizeof(filePath), "resource/eventID/%d.json", interactions[index].eventID);
+    prefetch->dialogue[index] = requestAsset(filePath, ASSET_JSON);
+    prefetch->isRequested[index] = SDL_TRUE;
+    prefetch->requests++;
+}
+
+static void releaseEventAssets(PrefetchState *prefetch, int index){
+    releaseAsset(prefetch->sheet[index]);
+    releaseAsset(prefetch->dialogue[index]);
+    prefetch->sheet[index] = ASSET_NONE;
+    prefetch->dialogue[index] = ASSET_NONE;
+    prefetch->isRequested[index] = SDL_FALSE;
+}
+
+// 플레이어와 상호작용 영역 사이 거리 (겹치면 0)
+static float distanceToInteraction(const PlayerState *player, int index){
+    Interaction *zone = &interactions[index];
+    float dx = 0.0f, dy = 0.0f;
+    if(player->x + player->rect.w < zone->x) dx = zone->x - (player->x + player->rect.w);
+    else if(player->x > zone->x + zone->width) dx = player->x - (zone->x + zone->width);
+    if(player->y + player->rect.h < zone->y) dy = zone->y - (player->y + player->rect.h);
+    else if(player->y > zone->y + zone->height) dy = player->y - (zone->y + zone->height);
+    return sqrtf(dx * dx + dy * dy);
+}
+
+// 프레임마다 호출: 반경 안에 들어온 이벤트 영역은 요청, 멀어진 영역은 반납
+void updatePrefetch(GameContext *game){
+    const PlayerState *player = &game->player;
+    PrefetchState *prefetch = &game->world.prefetch;
+    float keepRadius = prefetchRadius * 1.5f; // 경계에서 요청/반납을 반복하지 않도록
+
+    // 트리거 인덱스(x 시작점 정렬)에서 keepRadius 안쪽 후보만 훑음
+    int low = 0, high = interactionCount;
+    while(low < high){
+        int mid = (low + high) / 2;
+        if(interactions[triggerOrder[mid]].x < player->x + player->rect.w + keepRadius) low = mid + 1;
+        else high = mid;
+    }
+    for(int i = low - 1; i >= 0 && triggerMaxEnd[i] > player->x - keepRadius; i--){
+        int index = triggerOrder[i];
+        if(interactions[index].type != INTERACTION_EVENT || prefetch->isRequested[index]) continue;
+        if(distanceToInteraction(player, index) <= prefetchRadius){
+            requestEventAssets(prefetch, index);
+        }
+    }
+
+    // 요청해 둔 것 중 멀어진 것 반납
+    for(int i = 0; i < interactionCount; i++){
+        if(prefetch->isRequested[i] && distanceToInteraction(player, i) > keepRadius){
+            releaseEventAssets(prefetch, i);
+        }
+    }
+}
+
+// 이벤트 상호작용을 눌렀을 때 호출: 미리 읽기 결과 기록
+void recordPrefetchResult(GameContext *game, int index){
+    PrefetchState *prefetch = &game->world.prefetch;
+    if(!prefetch->isRequested[index]){
+        prefetch->misses++;
+    }
+    else if(isAssetSettled(prefetch->sheet[index]) && isAssetSettled(prefetch->dialogue[index])){
+        prefetch->hits++;
+    }
+    else{
+        prefetch->late++;
+    }
+}
+
+// 미리 읽은 에셋 전부 반납 (핫 리로드로 상호작용 인덱스가 바뀌었을 때나 판을 끝낼 때, 다음 updatePrefetch에서 다시 요청)
+void resetPrefetch(GameContext *game){
+    PrefetchState *prefetch = &game->world.prefetch;
+    for(int i = 0; i < (int)SDL_arraysize(prefetch->isRequested); i++){
+        if(prefetch->isRequested[i]) releaseEventAssets(prefetch, i);
+    }
+}
@@ -0,0 +1,222 @@
+#include "global.h"
+
+// 프레임 프로파일러
+// PROFILE_BEGIN/PROFILE_END로 감싼 구간을 스레드별 링 버퍼에 기록 (자기 버퍼에만 쓰므로 잠금 없음)
+// 메인 스레드 구간은 단계별로 합산해서 최근 PROFILE_HISTORY 프레임을 오버레이로 보여줌 (F3)
+// 기록은 크롬 trace_event JSON으로 내보낼 수 있음 (F4, chrome://tracing 이나 Perfetto에서 열기)
+// 잡 시스템의 잡별 측정(jobTimings)도 같이 켜고 같이 내보냄
+#define PROFILE_MAX_THREADS 8
+#define PROFILE_EVENT_SIZE 8192  // 스레드당 보관할 구간 수 (2의 거듭제곱)
+#define PROFILE_HISTORY 120      // 오버레이 그래프에 보여줄 프레임 수
+
+typedef struct ProfileEvent{
+    ProfileStage stage;
+    Uint32 frame;
+    Uint64 start, end;  // SDL_GetPerformanceCounter 값
+} ProfileEvent;
+
+typedef struct ProfileThread{
+    ProfileEvent events[PROFILE_EVENT_SIZE];
+    Uint32 count;       // 누적 기록 수 (링 버퍼 위치는 & (PROFILE_EVENT_SIZE - 1))
+} ProfileThread;
+
+static const char *profileStageNames[PROFILE_STAGE_COUNT] = {
+    "input", "animation", "physics", "camera", "tiles", "text", "present", "assets"
+};
+static const SDL_Color profileStageColors[PROFILE_STAGE_COUNT] = {
+    {  80, 160, 255, 255 }, { 255, 160,  60, 255 }, { 255,  80,  80, 255 }, { 160, 255, 160, 255 },
+    {  60, 200, 200, 255 }, { 230, 230,  80, 255 }, { 200, 120, 255, 255 }, { 255, 120, 200, 255 }
+};
+
+SDL_bool profilerEnabled = SDL_FALSE;
+SDL_bool profilerOverlayVisible = SDL_FALSE;
+SDL_bool profileScopesActive = SDL_FALSE;
+
+ProfileThread profileThreads[PROFILE_MAX_THREADS];
+SDL_atomic_t profileThreadCount;
+static _Thread_local int profileThreadSlot = -1;  // -2면 슬롯이 모자라서 기록 안 함
+
+Uint64 profileOrigin = 0;            // 추적 파일의 0 시점
+Uint64 profileLastFrameEnd = 0;
+Uint32 profileFrame = 0;
+Uint64 profileStageTicks[PROFILE_STAGE_COUNT];              // 이번 프레임 단계별 합 (메인 스레드)
+float profileFrameHistory[PROFILE_HISTORY];                  // ms
+float profileStageHistory[PROFILE_HISTORY][PROFILE_STAGE_COUNT];
+
+// 메인 스레드에서 가장 먼저 호출 (메인 스레드가 0번 슬롯)
+void initProfiler(){
+    SDL_AtomicSet(&profileThreadCount, 1);
+    profileThreadSlot = 0;
+    profileOrigin = SDL_GetPerformanceCounter();
+    profileLastFrameEnd = profileOrigin;
+    profileScopesActive = profilerEnabled || hitchBudget > 0.0f;
+}
+
+void setProfilerEnabled(SDL_bool enabled){
+    profilerEnabled = enabled;
+    profileScopesActive = enabled || hitchBudget > 0.0f;
+    SDL_AtomicSet(&jobTimingEnabled, enabled);
+    profileLastFrameEnd = SDL_GetPerformanceCounter(); // 꺼져 있던 시간이 한 프레임으로 잡히지 않도록
+}
+
+void recordProfileScope(ProfileStage stage, Uint64 start){
+    Uint64 end = SDL_GetPerformanceCounter();
+    if(profileThreadSlot == -1){
+        int slot = SDL_AtomicAdd(&profileThreadCount, 1);
+        profileThreadSlot = slot < PROFILE_MAX_THREADS ? slot : -2;
+    }
+    if(profileThreadSlot == 0){
+        profileStageTicks[stage] += end - start;
+    }
+    if(profileThreadSlot < 0 || !profilerEnabled) return; // 히치 감지만 켜져 있으면 단계별 합만 냄
+
+    ProfileThread *thread = &profileThreads[profileThreadSlot];
+    ProfileEvent *event = &thread->events[thread->count & (PROFILE_EVENT_SIZE - 1)];
+    event->stage = stage;
+    event->frame = profileFrame;
+    event->start = start;
+    event->end = end;
+    thread->count++;
+}
+
+// 프레임 끝에서 호출: 이번 프레임 단계별 시간을 그래프 기록으로 옮김
+void endProfileFrame(){
+    if(!profileScopesActive) return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    double toMs = 1000.0 / SDL_GetPerformanceFrequency();
+    int slot = profileFrame % PROFILE_HISTORY;
+    profileFrameHistory[slot] = (float)((now - profileLastFrameEnd) * toMs);
+    for(int i = 0; i < PROFILE_STAGE_COUNT; i++){
+        profileStageHistory[slot][i] = (float)(profileStageTicks[i] * toMs);
+        profileStageTicks[i] = 0;
+    }
+    profileLastFrameEnd = now;
+    profileFrame++;
+}
+
+const char *getProfileStageName(ProfileStage stage){
+    return profileStageNames[stage];
+}
+
+// 방금 끝난 프레임의 단계 시간 (ms)
+float getProfileStageTime(ProfileStage stage){
+    if(profileFrame == 0) return 0.0f;
+    return profileStageHistory[(profileFrame - 1) % PROFILE_HISTORY][stage];
+}
+
+// 오버레이: 위쪽은 최근 프레임 시간 그래프 (단계별로 쌓은 막대, 초록 선 = 8.3ms), 아래쪽은 단계별 평균
+void renderProfilerOverlay(SDL_Renderer *renderer, TTF_Font *font){
+    if(!profilerOverlayVisible || !profilerEnabled) return;
+
+    const int graphX = 10, graphY = 10, graphHeight = 100;
+    const float msToPixel = graphHeight / 33.3f; // 30FPS가 꼭대기
+    int frames = profileFrame < PROFILE_HISTORY ? (int)profileFrame : PROFILE_HISTORY;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_Rect background = { graphX - 5, graphY - 5, PROFILE_HISTORY * 2 + 170, graphHeight + 30 + PROFILE_STAGE_COUNT * 18 };
+    SDL_RenderFillRect(renderer, &background);
+
+    float average[PROFILE_STAGE_COUNT] = { 0 };
+    float averageFrame = 0.0f, worstFrame = 0.0f;
+    for(int f = 0; f < frames; f++){
+        // 오래된 프레임부터 왼쪽에
+        int slot = (profileFrame - frames + f) % PROFILE_HISTORY;
+        int x = graphX + f * 2;
+        int bottom = graphY + graphHeight;
+
+        SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255); // 단계 밖 시간 (대기, 기타)
+        SDL_Rect total = { x, bottom - (int)SDL_min(profileFrameHistory[slot] * msToPixel, graphHeight), 2, 0 };
+        total.h = bottom - total.y;
+        SDL_RenderFillRect(renderer, &total);
+
+        for(int i = 0; i < PROFILE_STAGE_COUNT; i++){
+            int height = (int)(profileStageHistory[slot][i] * msToPixel);
+            if(height <= 0) continue;
+            bottom -= height;
+            if(bottom < graphY) break;
+            SDL_SetRenderDrawColor(renderer, profileStageColors[i].r, profileStageColors[i].g, profileStageColors[i].b, 255);
+            SDL_Rect bar = { x, bottom, 2, height };
+            SDL_RenderFillRect(renderer, &bar);
+            average[i] += profileStageHistory[slot][i];
+        }
+        averageFrame += profileFrameHistory[slot];
+        if(profileFrameHistory[slot] > worstFrame) worstFrame = profileFrameHistory[slot];
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+    int targetY = graphY + graphHeight - (int)(8.3f * msToPixel);
+    SDL_RenderDrawLine(renderer, graphX, targetY, graphX + PROFILE_HISTORY * 2, targetY);
+
+    if(frames == 0) return;
+    char line[64];
+    snprintf(line, sizeof(line), "frame %.2f ms (max %.2f)", averageFrame / frames, worstFrame);
+    renderText(renderer, line, graphX, graphY + graphHeight + 4, font, BasicColor);
+
+    // 단계별 평균 막대
+    for(int i = 0; i < PROFILE_STAGE_COUNT; i++){
+        int y = graphY + graphHeight + 26 + i * 18;
+        float ms = average[i] / frames;
+        SDL_SetRenderDrawColor(renderer, profileStageColors[i].r, profileStageColors[i].g, profileStageColors[i].b, 255);
+        SDL_Rect bar = { graphX + 150, y + 4, (int)SDL_min(ms * 40.0f, PROFILE_HISTORY * 2 + 10), 10 };
+        SDL_RenderFillRect(renderer, &bar);
+        snprintf(line, sizeof(line), "%-9s %.2f ms", profileStageNames[i], ms);
+        renderText(renderer, line, graphX, y, font, profileStageColors[i]);
+    }
+}
+
+static void writeTraceEvent(FILE *file, SDL_bool *first, const char *name, int thread, Uint64 start, Uint64 end){
+    double toUs = 1000000.0 / SDL_GetPerformanceFrequency();
+    fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            *first ? "" : ",", name, thread, (start - profileOrigin) * toUs, (end - start) * toUs);
+    *first = SDL_FALSE;
+}
+
+// 링 버퍼에 남아있는 기록을 크롬 trace_event 형식으로 저장, 실패하면 -1
+int exportProfileTrace(const char *path){
+    FILE *file = fopen(path, "w");
+    if(file == NULL){
+        LOG_ERROR(LOG_CORE, "Failed to write profile trace %s", path);
+        return -1;
+    }
+
+    SDL_bool first = SDL_TRUE;
+    int events = 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    int threads = SDL_min(SDL_AtomicGet(&profileThreadCount), PROFILE_MAX_THREADS);
+    for(int t = 0; t < threads; t++){
+        ProfileThread *thread = &profileThreads[t];
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s%d\"}}",
+                first ? "" : ",", t, t == 0 ? "main " : "thread ", t);
+        first = SDL_FALSE;
+
+        Uint32 count = thread->count;
+        for(Uint32 i = count > PROFILE_EVENT_SIZE ? count - PROFILE_EVENT_SIZE : 0; i < count; i++){
+            ProfileEvent *event = &thread->events[i & (PROFILE_EVENT_SIZE - 1)];
+            writeTraceEvent(file, &first, profileStageNames[event->stage], t, event->start, event->end);
+            events++;
+        }
+    }
+
+    // 잡은 워커별 줄로 (0번 워커는 메인 스레드)
+    for(int worker = 0; worker < jobWorkerCount; worker++){
+        int thread = worker == 0 ? 0 : 100 + worker;
+        if(worker > 0){
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"job worker %d\"}}", thread, worker);
+        }
+        // 최근 것부터 거꾸로, 덮어써진 곳에 닿으면 끝
+        for(Uint32 i = getJobTimingCount(worker); i-- > 0; ){
+            JobTiming timing;
+            if(!getJobTiming(worker, i, &timing)) break;
+            if(timing.start < profileOrigin) continue;
+            writeTraceEvent(file, &first, timing.name != NULL ? timing.name : "job", thread, timing.start, timing.end);
+            events++;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    LOG_INFO(LOG_CORE, "Profile trace written: %s (%d events)", path, events);
+    return 0;
+}
@@ -5,7 +5,7 @@
 #include <stdio.h>
 
 SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer) {
-    SDL_Surface* tempSurface = IMG_Load(path);
+    SDL_Surface* tempSurface = IMG_Load_RW(openAssetFile(path), 1);
     if(tempSurface == NULL){
         showErrorAndExit("WHO TOUCH THE IMAGE FILE!?", SDL_GetError());
         return NULL;
@@ -16,7 +16,46 @@ SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer) {
     
     return newTexture;
 }
-// 타일을 렌더링하는 함수
+// 크기별 폰트 캐시 (매 프레임 폰트 파일을 다시 열지 않도록), 종료 때 closeCachedFonts
+#define FONT_CACHE_SIZE 4
+TTF_Font *cachedFonts[FONT_CACHE_SIZE];
+int cachedFontSizes[FONT_CACHE_SIZE];
+
+static TTF_Font *getFontOfSize(int size){
+    int slot = 0;
+    for(; slot < FONT_CACHE_SIZE && cachedFonts[slot] != NULL; slot++){
+        if(cachedFontSizes[slot] == size) return cachedFonts[slot];
+    }
+    if(slot == FONT_CACHE_SIZE){
+        slot = FONT_CACHE_SIZE - 1; // 가득 차면 마지막 칸을 바꿔 씀
+        TTF_CloseFont(cachedFonts[slot]);
+    }
+    cachedFonts[slot] = TTF_OpenFontRW(openAssetFile("resource/The Jamsil.ttf"), 1, size);
+    cachedFontSizes[slot] = size;
+    return cachedFonts[slot];
+}
+
+void closeCachedFonts(){
+    for(int i = 0; i < FONT_CACHE_SIZE; i++){
+        if(cachedFonts[i] != NULL) TTF_CloseFont(cachedFonts[i]);
+        cachedFonts[i] = NULL;
+    }
+}
+
+// 로딩 화면 (폰트도 아직 없을 수 있으므로 진행 막대만)
+void renderLoadingScreen(SDL_Renderer *renderer, float progress){
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    SDL_Rect frameRect = { 200, 290, 400, 20 };
+    SDL_Rect barRect = { 202, 292, (int)(396 * progress), 16 };
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDrawRect(renderer, &frameRect);
+    SDL_RenderFillRect(renderer, &barRect);
+    SDL_RenderPresent(renderer);
+}
+
+// 타일을 렌더링하는 함수 (xOffset, yOffset은 카메라 위치까지 뺀 화면 기준 오프셋)
 void renderTileMap(SDL_Renderer* renderer, Map *map, int xOffset, int yOffset){
     int tilesPerRow = 240 / map->tileWidth; // Tileset00.png의 크기가 변경될 경우 이 값을 수정할것
 
@@ -35,8 +74,8 @@ void renderTileMap(SDL_Renderer* renderer, Map *map, int xOffset, int yOffset){
 
             SDL_Rect srcRect = { tileX, tileY, map->tileWidth, map->tileHeight };
             SDL_Rect destRect = { 
-                x * map->tileWidth * 3 - camera.x + xOffset, 
-                y * map->tileHeight * 3 - camera.y + yOffset, 
+                x * map->tileWidth * 3 + xOffset, 
+                y * map->tileHeight * 3 + yOffset, 
                 map->tileWidth * 3, 
                 map->tileHeight * 3 
             };
@@ -80,39 +119,39 @@ void renderTileMap(SDL_Renderer* renderer, Map *map, int xOffset, int yOffset){
     }
 }
 
-void renderAnimation(SDL_Renderer *renderer, tileAnimation *animation){
-    if(!animation->isFinished){ 
-        SDL_Rect destRect = { (int)animation->x - camera.x - 15, (int)animation->y - camera.y, maps->tileWidth * 3, maps->tileHeight * 3 };
-        SDL_RenderCopy(renderer, animation->frames[animation->currentFrame], NULL, &destRect);
+void renderAnimation(GameContext *game, SDL_Renderer *renderer, tileAnimation *animation){
+    const SDL_Rect *camera = &game->camera.rect;
+    if(!animation->isFinished && animation->sheet != NULL){ 
+        SDL_Rect destRect = { (int)animation->x - camera->x - 15, (int)animation->y - camera->y, maps->tileWidth * 3, maps->tileHeight * 3 };
+        SDL_Rect srcRect = { animation->currentFrame * 24, 0, 24, 24 };
+        SDL_RenderCopy(renderer, animation->sheet, &srcRect, &destRect);
         // printf("Rendering frame %d at position (%d, %d)\n", animation->currentFrame, destRect.x, destRect.y);
     }
 }
 
-void displayText(SDL_Renderer *renderer, TTF_Font *font, int x, int y){
+void displayText(GameContext *game, SDL_Renderer *renderer, TTF_Font *font, int x, int y){
+    const TextDisplay *activeTextDisplay = &game->ui.activeTextDisplay;
     // 텍스트가 없으면 아무것도 표시하지 않음
-    if (activeTextDisplay.text == NULL) return;
-
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - activeTextDisplay.startTime >= activeTextDisplay.duration) {
-        activeTextDisplay.text = NULL;  // 시간이 지나면 텍스트 숨기기
-        return;
-    }
+    // 표시 시간이 지나면 showText가 건 타이머가 text를 NULL로 만듦
+    if (activeTextDisplay->text == NULL) return;
 
     SDL_Color color = {255, 255, 255, 255}; // 흰색 텍스트
-    SDL_Surface *surface = TTF_RenderUTF8_Blended(font, activeTextDisplay.text, color);
+    SDL_Surface *surface = TTF_RenderUTF8_Blended(font, activeTextDisplay->text, color);
     if(surface == NULL){
-        printf("Failed to render text surface: %s\n", TTF_GetError());
+        LOG_ERROR(LOG_UI, "Failed to render text surface: %s", TTF_GetError());
         return;
     }
 
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    trackExternal(MEM_UI, surface->w * surface->h * 4);
     if (texture == NULL) {
-        printf("Failed to create texture from surface: %s\n", SDL_GetError());
+        LOG_ERROR(LOG_UI, "Failed to create texture from surface: %s", SDL_GetError());
+        trackExternal(MEM_UI, -surface->w * surface->h * 4);
         SDL_FreeSurface(surface);
         return;
     }
 
-    if(activeTextDisplay.text == buffer){
+    if(activeTextDisplay->text == game->ui.miniGameText){
         // 띵동대쉬 이벤트 텍스트 출력 위치
         SDL_Rect destRect = {270, 10, surface->w, surface->h};
         SDL_RenderCopy(renderer, texture, NULL, &destRect);
@@ -124,10 +163,14 @@ void displayText(SDL_Renderer *renderer, TTF_Font *font, int x, int y){
 
 
     SDL_DestroyTexture(texture);
+    trackExternal(MEM_UI, -surface->w * surface->h * 4);
     SDL_FreeSurface(surface);
 }
 
-void renderShop(SDL_Renderer *renderer, Shop *shop, TTF_Font *font){
+void renderShop(GameContext *game, SDL_Renderer *renderer, TTF_Font *font){
+    const UIState *ui = &game->ui;
+    const Shop *shop = &ui->shop;
+    const Shop *items = ui->items;
     // 상점 UI 배경
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);  // 어두운 반투명 배경
     SDL_Rect bgRect = {100, 100, 600, 400};  // 상점 UI 크기
@@ -138,11 +181,11 @@ void renderShop(SDL_Renderer *renderer, Shop *shop, TTF_Font *font){
 
     // 현재 골드 표시
     char goldText[64];  // 골드 값을 문자열로 변환할 버퍼
-    sprintf(goldText, "현재 돈: %d", playerGold);  // playerGold 값을 문자열로 변환
+    sprintf(goldText, "현재 돈: %d", game->player.gold);  // 골드 값을 문자열로 변환
     renderText(renderer, goldText, 150, 150, font, YelloColor);  // 변환된 골드 값 표시
 
     // 아이템 목록 렌더링
-    for(int i = 0; i < itemCount; i++){
+    for(int i = 0; i < ui->itemCount; i++){
         int yPos = 200 + i * 40;  // 각 아이템의 y 위치
 
         // 선택된 아이템 강조
@@ -168,13 +211,15 @@ void renderText(SDL_Renderer *renderer, const char *text, int x, int y, TTF_Font
     SDL_Surface *textSurface = TTF_RenderUTF8_Blended(font, text, color);
     SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
     SDL_Rect textRect = {x, y, textSurface->w, textSurface->h};
+    trackExternal(MEM_UI, textSurface->w * textSurface->h * 4);
     SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
+    trackExternal(MEM_UI, -textSurface->w * textSurface->h * 4);
     SDL_FreeSurface(textSurface);
     SDL_DestroyTexture(textTexture);
 }
 
-void renderChoice(SDL_Renderer *renderer, DialogueText *dialogue, int x, int y, int *selectedOption){
-    TTF_Font *choiceFont = TTF_OpenFont("resource\\The Jamsil.ttf", fontSize);
+void renderChoice(GameContext *game, SDL_Renderer *renderer, DialogueText *dialogue, int x, int y, int *selectedOption){
+    TTF_Font *choiceFont = getFontOfSize(game->ui.fontSize);
     SDL_Color normalColor = {255, 255, 255};
     SDL_Color selectedColor = {255, 255, 0};
 
@@ -184,22 +229,17 @@ void renderChoice(SDL_Renderer *renderer, DialogueText *dialogue, int x, int y,
     }
 }
 
-void renderTypingEffect(SDL_Renderer *renderer, TTF_Font *choiceFont ,DialogueText *dialogue, int x, int y, int *selectedOption, Uint32 startTime){
+void renderTypingEffect(GameContext *game, SDL_Renderer *renderer, TTF_Font *choiceFont ,DialogueText *dialogue, int x, int y, int *selectedOption, Uint32 startTime){
+    UIState *ui = &game->ui;
     SDL_Color normalColor = {255, 255, 255};
     SDL_Color selectedColor = {255, 255, 0};
     renderText(renderer, dialogue->name, 110, 70, choiceFont, normalColor);
 
-    // text가 배열인지 단일 문자열인지 확인
-    int lineLength = 0;
-    if(dialogue->text[currentLine] != NULL){
-        lineLength = strlen(dialogue->text[currentLine]);
-    }
-    else{ // text가 단일 문자열일 경우 길이를 계산
-        lineLength = strlen(dialogue->text[0]);
-    }
+    // text는 고정 크기 배열이라 없는 줄은 빈 문자열 (단일 문자열 대사는 0번 줄에 들어 있음)
+    int lineLength = strlen(dialogue->text[ui->currentLine]);
 
     // 한 글자씩 출력
-    Uint32 elapsedTime = SDL_GetTicks() - startTime;
+    Uint32 elapsedTime = game->clock.time - startTime;
     if(elapsedTime < 25){
         elapsedTime = 25;  // 첫 번째 프레임에서는 약간의 지연을 추가
     }
@@ -207,40 +247,44 @@ void renderTypingEffect(SDL_Renderer *renderer, TTF_Font *choiceFont ,DialogueTe
     int charsToShow = elapsedTime / 25;  // 50ms마다 한 글자 출력
     if(charsToShow > lineLength){
         charsToShow = lineLength;  // 텍스트 전부 출력 완료
-        isTextComplete = SDL_TRUE;
+        ui->isTextComplete = SDL_TRUE;
+    }
+    else{
+        requestRedraw(game, 25); // 다음 글자가 나올 때 화면을 다시 그리도록 예약
     }
 
     // 현재까지 출력된 모든 줄 렌더링
-    for(int t = 0; t <= currentLine; t++){
+    for(int t = 0; t <= ui->currentLine; t++){
         char visibleText[256];
 
-        if(t < currentLine){ // 이미 출력 완료된 줄은 전체 텍스트 렌더링
+        if(t < ui->currentLine){ // 이미 출력 완료된 줄은 전체 텍스트 렌더링
             strncpy(visibleText, dialogue->text[t], sizeof(visibleText) - 1);
             visibleText[sizeof(visibleText) - 1] = '\0';
         }
         else{ // 현재 줄은 타이핑 효과 적용
-            strncpy(visibleText, dialogue->text[currentLine], charsToShow);
+            strncpy(visibleText, dialogue->text[ui->currentLine], charsToShow);
             visibleText[charsToShow] = '\0';
         }
         renderText(renderer, visibleText, x, y + (t * 30), choiceFont, normalColor);  // i * 30: 줄 간격
     }
 
     // 텍스트 제한 & 줄 넘기기
-    if(isTextComplete && charsToShow == lineLength){
-        currentLine++;
-        if(currentLine >= dialogue->textLineCount){
-            currentLine--;
-            isTextComplete = SDL_TRUE;
+    if(ui->isTextComplete && charsToShow == lineLength){
+        ui->currentLine++;
+        if(ui->currentLine >= dialogue->textLineCount){
+            ui->currentLine--;
+            ui->isTextComplete = SDL_TRUE;
         }
         else{
-            textTime = SDL_GetTicks();
-            isTextComplete = SDL_FALSE;
+            ui->textTime = game->clock.time;
+            ui->isTextComplete = SDL_FALSE;
+            requestRedraw(game, 25); // 다음 줄 첫 글자 (대화 중에는 월드가 멈춰 있어서 예약하지 않으면 잠든 채로 늦게 나옴)
         }
     }
     // 대화 텍스트가 모두 출력되었으면 선택지를 출력
-    if(isTextComplete && currentLine >= 0 && currentLine < 4){
+    if(ui->isTextComplete && ui->currentLine >= 0 && ui->currentLine < 4){
         for(int i = 0; i < dialogue->optionCount; i++){
-            isTextComplete = SDL_FALSE;
+            ui->isTextComplete = SDL_FALSE;
             SDL_Color color = (i == *selectedOption) ? selectedColor : normalColor;
             renderText(renderer, dialogue->options[i], x, (y + 100) + (i * 30), choiceFont, color);
         }
@@ -249,42 +293,49 @@ void renderTypingEffect(SDL_Renderer *renderer, TTF_Font *choiceFont ,DialogueTe
 
 // 이벤트 전용 텍스트 렌더링 함수
 void renderEventText(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, int fontSize, SDL_Color color) {
-    TTF_Font *scaledFont = TTF_OpenFont("resource\\The Jamsil.ttf", fontSize); // 동적으로 크기 조정
+    TTF_Font *scaledFont = getFontOfSize(fontSize); // 동적으로 크기 조정
     if (!scaledFont) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR(LOG_UI, "Failed to load font: %s", TTF_GetError());
         return;
     }
 
     SDL_Surface *textSurface = TTF_RenderUTF8_Blended(scaledFont, text, color);
     SDL_Texture *textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
     SDL_Rect textRect = {x, y, textSurface->w, textSurface->h};
+    trackExternal(MEM_UI, textSurface->w * textSurface->h * 4);
     SDL_RenderCopy(renderer, textTexture, NULL, &textRect);
 
+    trackExternal(MEM_UI, -textSurface->w * textSurface->h * 4);
     SDL_FreeSurface(textSurface);
     SDL_DestroyTexture(textTexture);
-    TTF_CloseFont(scaledFont);
 }
 
-void render(SDL_Renderer* renderer, Map maps[], int mapCount, const char *activeText, TTF_Font *font){
+void render(GameContext *game, SDL_Renderer* renderer, Map maps[], int mapCount, TTF_Font *font){
+    const PlayerState *player = &game->player;
+    const SDL_Rect *camera = &game->camera.rect;
+    UIState *ui = &game->ui;
+    DialogueText *dialogues = ui->dialogues;
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
+    PROFILE_BEGIN(PROFILE_TILES);
     for(int i = 0; i < mapCount; i++){
-        int xOffset = i * 2952; // 72x72 기준
+        int xOffset = maps[i].worldX * 3; // 72x72 기준
         int yOffset = 0;
-        renderTileMap(renderer, &maps[i], xOffset, yOffset);
+        renderTileMap(renderer, &maps[i], xOffset - camera->x, yOffset - camera->y);
     }
+    PROFILE_END(PROFILE_TILES);
 
     /*
     //디버그 용도 (충돌&상호작용 시각화)
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // 플랫폼 색상 설정 (빨간색)
     for(int i = 0; i < platformCount; i++){
-        SDL_Rect platformRect = {platforms[i].x - camera.x, platforms[i].y - camera.y, platforms[i].width, platforms[i].height};
+        SDL_Rect platformRect = {platforms[i].x - camera->x, platforms[i].y - camera->y, platforms[i].width, platforms[i].height};
         SDL_RenderFillRect(renderer, &platformRect); // 플랫폼 사각형 그리기
     }
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
     for(int i = 0; i < platformCount; i++){
-        SDL_Rect interaction = {interactions[i].x - camera.x, interactions[i].y - camera.y, interactions[i].width, interactions[i].height};
+        SDL_Rect interaction = {interactions[i].x - camera->x, interactions[i].y - camera->y, interactions[i].width, interactions[i].height};
         SDL_RenderFillRect(renderer, &interaction); // 플랫폼 사각형 그리기
     }
     */
@@ -293,44 +344,49 @@ void render(SDL_Renderer* renderer, Map maps[], int mapCount, const char *active
     srcRect.w = 24;  // 원본 스프라이트 너비
     srcRect.h = 24;  // 원본 스프라이트 높이
 
-    if(isMoving){
-        srcRect.y = direction == -1 ? 24 : 48; // 움직일 때
-        srcRect.x = frame * 24;
+    if(player->isMoving){
+        srcRect.y = player->direction == -1 ? 24 : 48; // 움직일 때
+        srcRect.x = player->frame * 24;
     }
     else{
         srcRect.y = 0;  // 가만히 있을 때
-        srcRect.x = (direction == -1 ? 0 : 48) + (frame % 2) * 24;
+        srcRect.x = (player->direction == -1 ? 0 : 48) + (player->frame % 2) * 24;
     }
 
-    // 텍스트 렌더링 (activeText가 NULL이 아닐 경우 출력)
-    if(activeText != NULL){
-        displayText(renderer, font, playerX - camera.x - 12, playerY - camera.y - 24);
+    // 물리 틱 사이의 플레이어 위치 보간
+    float renderX = player->previousX + (player->x - player->previousX) * game->clock.physicsAlpha;
+    float renderY = player->previousY + (player->y - player->previousY) * game->clock.physicsAlpha;
+
+    // 텍스트 렌더링 (표시할 텍스트가 있을 경우 출력)
+    PROFILE_BEGIN(PROFILE_TEXT);
+    if(ui->activeTextDisplay.text != NULL){
+        displayText(game, renderer, font, renderX - camera->x - 12, renderY - camera->y - 24);
     }
 
-    if(isShopVisible == SDL_TRUE){
-        renderShop(renderer, &shop, font);  // 상점 UI를 렌더링
+    if(ui->isShopVisible == SDL_TRUE){
+        renderShop(game, renderer, font);  // 상점 UI를 렌더링
     }
 
-    if(isMiniGameActive == SDL_TRUE){
-        renderEventText(renderer, font, buffer, 270, 10, fontSize, textEventColor);
+    if(ui->isMiniGameActive == SDL_TRUE){
+        renderEventText(renderer, font, ui->miniGameText, 270, 10, ui->fontSize, ui->textEventColor);
     }
 
-    if(isDialogueActive == SDL_TRUE){
-        if(textTime == 0){ // 첫 번째 대화일 때만 startTime 초기화
-            textTime = SDL_GetTicks();  // 타이핑 시작 시간
-            printf("startTime initialized: %u\n", textTime);  // 디버깅: startTime 값 확인
-            if(strlen(dialogues[dialogues->currentID].SE) > 0){
-                playSoundEffect(dialogues[dialogues->currentID].SE);
+    if(ui->isDialogueActive == SDL_TRUE){
+        if(ui->textTime == 0){ // 첫 번째 대화일 때만 startTime 초기화
+            ui->textTime = game->clock.time;  // 타이핑 시작 시간
+            LOG_DEBUG(LOG_UI, "startTime initialized: %u", ui->textTime);  // 디버깅: startTime 값 확인
+            if(dialogues[dialogues->currentID].seID != SOUND_NONE){
+                playGameSound(game, dialogues[dialogues->currentID].seID);
             }
         }
         // 대화가 넘어갔을 때 textTime을 초기화
         else if(dialogues[dialogues->currentID].nextIds[0] != dialogues->previousId){
-            currentLine = 0;
-            textTime = SDL_GetTicks();  // 대화가 시작되거나 nextID가 바뀌면 타이핑 시작 시간 초기화
+            ui->currentLine = 0;
+            ui->textTime = game->clock.time;  // 대화가 시작되거나 nextID가 바뀌면 타이핑 시작 시간 초기화
             dialogues->previousId = dialogues[dialogues->currentID].nextIds[0];  // previousNextId 갱신
-            printf("startTime reinitialized: %u\n", textTime);  // 디버깅: 새로 초기화된 time 값 확인
-            if(strlen(dialogues[dialogues->currentID].SE) > 0 && dialogues[dialogues->currentID].nextIds[0] != -1){
-                playSoundEffect(dialogues[dialogues->currentID].SE);
+            LOG_DEBUG(LOG_UI, "startTime reinitialized: %u", ui->textTime);  // 디버깅: 새로 초기화된 time 값 확인
+            if(dialogues[dialogues->currentID].seID != SOUND_NONE && dialogues[dialogues->currentID].nextIds[0] != -1){
+                playGameSound(game, dialogues[dialogues->currentID].seID);
             }
         }
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
@@ -338,17 +394,32 @@ void render(SDL_Renderer* renderer, Map maps[], int mapCount, const char *active
         SDL_Rect nameRect = {100, 70, 200, 30};
         SDL_RenderFillRect(renderer, &bgRect);
         SDL_RenderFillRect(renderer, &nameRect);
-        renderTypingEffect(renderer, font ,&dialogues[dialogues->currentID], 110, 100, &selectedOption , textTime);
+        renderTypingEffect(game, renderer, font ,&dialogues[dialogues->currentID], 110, 100, &ui->selectedOption , ui->textTime);
     }
+    PROFILE_END(PROFILE_TEXT);
+
+    renderEntities(game, renderer);
 
-    for(int a = 0; a < animationCount; a++){
-        if(animations[a].isActive == SDL_TRUE){
-            renderAnimation(renderer, &animations[a]);
+    for(int a = 0; a < game->world.animationCount; a++){
+        if(game->world.animations[a].isActive == SDL_TRUE){
+            renderAnimation(game, renderer, &game->world.animations[a]);
         }
     }
 
+    // 상호작용 안내 (트리거 진입/이탈 때만 갱신되므로 여기서는 검색하지 않음)
+    int prompt = game->world.promptInteraction;
+    if(prompt != -1 && !ui->isShopVisible && !ui->isMiniGameActive && !ui->isDialogueActive){
+        Interaction *zone = &interactions[prompt];
+        renderText(renderer, "E", zone->x + zone->width / 2 - camera->x - 6, zone->y - camera->y - 30, font, YelloColor);
+    }
+
     // 렌더링할 캐릭터 크기
-    SDL_Rect renderPlayer = { (int)playerX - camera.x, (int)playerY - camera.y, playerRect.w, playerRect.h };
+    SDL_Rect renderPlayer = { (int)renderX - camera->x, (int)renderY - camera->y, player->rect.w, player->rect.h };
     SDL_RenderCopy(renderer, spriteSheet, &srcRect, &renderPlayer);
+    renderProfilerOverlay(renderer, font);
+
+    PROFILE_BEGIN(PROFILE_PRESENT);
     SDL_RenderPresent(renderer);
+    PROFILE_END(PROFILE_PRESENT);
+    markInputPresented(game);
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "global.h"
+
+// 입력 녹화와 결정적 리플레이 (실행 인자 --record=파일, --replay=파일)
+// 녹화: 프레임마다 시각, 그 프레임에 확정된 키 이벤트, 기다리던 이벤트가 시작됐는지를 기록
+// 재생: 기록한 시각과 입력으로 updateGameFrame을 다시 돌리고 소프트웨어 렌더러로 그린 화면을 프레임마다 해시
+//       --golden=파일과 비교해서 처음 달라진 프레임을 보고 (--writegolden이면 대신 새로 씀), 갱신/렌더링 시간도 같이 기록
+// 이벤트 에셋은 로더 스레드 속도에 따라 시작 프레임이 달라지므로 녹화 때 시작된 프레임에 맞춰 그 자리에서 받음
+// 해시는 같은 SDL / SDL_ttf 버전과 같은 리소스에서만 비교 가능 (골든 파일은 그 조합마다 따로 둠)
+// 파일 형식 (리틀 엔디언)
+//   헤더: "DDRP", 버전 u16, 물리 틱 수 u16, 시작 시각 u32, 준비 후 난수 상태 u32, NPC 수 u32,
+//         맵 / 플랫폼 / 상호작용 수 u32 x3, 프레임 수 u32 (녹화를 끝낼 때 채움)
+//   프레임: 시각 u32, 플래그 u8 (bit0: 이벤트 시작), 이벤트 수 u16, 이벤트마다 (타임스탬프 u32, 스캔코드 u16, 눌림 u8)
+#define REPLAY_VERSION 1
+#define REPLAY_FRAME_EVENT_STARTED 0x01
+#define REPLAY_FRAME_COUNT_OFFSET 32 // 헤더에서 프레임 수 위치
+
+char replayRecordPath[256] = "";  // 실행 인자 --record=파일
+char replayPath[256] = "";        // 실행 인자 --replay=파일
+char replayGoldenPath[256] = "";  // 실행 인자 --golden=파일
+SDL_bool replayWriteGolden = SDL_FALSE; // 실행 인자 --writegolden
+char replayReportPath[256] = "";  // 실행 인자 --replayreport=파일 (JSON)
+
+typedef struct ReplayHeader{
+    Uint16 tickRate;
+    Uint32 startTime;
+    Uint32 randomState;
+    Uint32 npcCount;
+    Uint32 mapCount;
+    Uint32 platformCount;
+    Uint32 interactionCount;
+    Uint32 frameCount;
+} ReplayHeader;
+
+static SDL_RWops *replayRecordFile = NULL;
+static Uint32 replayRecordedFrames = 0;
+
+static void writeReplayHeader(SDL_RWops *file, const ReplayHeader *header){
+    SDL_RWwrite(file, "DDRP", 1, 4);
+    SDL_WriteLE16(file, REPLAY_VERSION);
+    SDL_WriteLE16(file, header->tickRate);
+    SDL_WriteLE32(file, header->startTime);
+    SDL_WriteLE32(file, header->randomState);
+    SDL_WriteLE32(file, header->npcCount);
+    SDL_WriteLE32(file, header->mapCount);
+    SDL_WriteLE32(file, header->platformCount);
+    SDL_WriteLE32(file, header->interactionCount);
+    SDL_WriteLE32(file, header->frameCount);
+}
+
+static SDL_bool readReplayHeader(SDL_RWops *file, ReplayHeader *header){
+    char magic[4];
+    if(SDL_RWread(file, magic, 1, 4) != 4 || memcmp(magic, "DDRP", 4) != 0) return SDL_FALSE;
+    if(SDL_ReadLE16(file) != REPLAY_VERSION) return SDL_FALSE;
+    header->tickRate = SDL_ReadLE16(file);
+    header->startTime = SDL_ReadLE32(file);
+    header->randomState = SDL_ReadLE32(file);
+    header->npcCount = SDL_ReadLE32(file);
+    header->mapCount = SDL_ReadLE32(file);
+    header->platformCount = SDL_ReadLE32(file);
+    header->interactionCount = SDL_ReadLE32(file);
+    header->frameCount = SDL_ReadLE32(file);
+    return SDL_TRUE;
+}
+
+// 헤더 뒤에 실제로 들어 있는 온전한 프레임 수 (끝까지 읽은 뒤 프레임 시작 위치로 되돌림)
+// 녹화 중에 꺼지면 헤더의 프레임 수는 0으로 남고 마지막 프레임은 잘려 있을 수 있음
+static Uint32 countReplayFrames(SDL_RWops *file, SDL_bool *truncated){
+    Sint64 start = SDL_RWtell(file);
+    Uint32 frames = 0;
+    Uint8 frameHeader[7]; // 시각 4 + 플래그 1 + 이벤트 수 2
+    Uint8 event[7];       // 시각 4 + 스캔코드 2 + 눌림 1
+    *truncated = SDL_FALSE;
+    for(;;){
+        size_t got = SDL_RWread(file, frameHeader, 1, sizeof(frameHeader));
+        if(got == 0) break;
+        if(got != sizeof(frameHeader)){
+            *truncated = SDL_TRUE;
+            break;
+        }
+        Uint16 eventCount = (Uint16)(frameHeader[5] | (frameHeader[6] << 8));
+        for(Uint16 e = 0; e < eventCount && !*truncated; e++){
+            if(SDL_RWread(file, event, 1, sizeof(event)) != sizeof(event)) *truncated = SDL_TRUE;
+        }
+        if(*truncated) break;
+        frames++;
+    }
+    SDL_RWseek(file, start, RW_SEEK_SET);
+    return frames;
+}
+
+// startGame 직후 호출 (--record가 없으면 아무것도 안 함)
+void startReplayRecording(GameContext *game, int npcCount){
+    if(replayRecordPath[0] == '\0') return;
+    replayRecordFile = SDL_RWFromFile(replayRecordPath, "wb");
+    if(replayRecordFile == NULL){
+        LOG_ERROR(LOG_CORE, "Cannot record replay to %s: %s", replayRecordPath, SDL_GetError());
+        return;
+    }
+    ReplayHeader header = {0};
+    header.tickRate = (Uint16)physicsTickRate;
+    header.startTime = game->clock.time;
+    header.randomState = game->randomState;
+    header.npcCount = (Uint32)npcCount;
+    header.mapCount = (Uint32)currentMapCount;
+    header.platformCount = (Uint32)platformCount;
+    header.interactionCount = (Uint32)interactionCount;
+    writeReplayHeader(replayRecordFile, &header);
+    replayRecordedFrames = 0;
+    LOG_INFO(LOG_CORE, "Recording replay to %s", replayRecordPath);
+}
+
+// updateGameFrame 직후 호출: 이번 프레임 몫의 입력 이벤트와 시각 기록
+void recordReplayFrame(GameContext *game, Uint32 currentTime, SDL_bool eventStarted){
+    if(replayRecordFile == NULL) return;
+    InputState *state = &game->input;
+    SDL_WriteLE32(replayRecordFile, currentTime);
+    SDL_WriteU8(replayRecordFile, eventStarted ? REPLAY_FRAME_EVENT_STARTED : 0);
+    SDL_WriteLE16(replayRecordFile, (Uint16)(state->frameEnd - state->frameBegin));
+    for(Uint32 i = state->frameBegin; i != state->frameEnd; i++){
+        InputEvent *input = &state->buffer[i & (INPUT_BUFFER_SIZE - 1)];
+        SDL_WriteLE32(replayRecordFile, input->timestamp);
+        SDL_WriteLE16(replayRecordFile, (Uint16)input->scancode);
+        SDL_WriteU8(replayRecordFile, input->pressed);
+    }
+    replayRecordedFrames++;
+}
+
+// 종료할 때 호출: 헤더의 프레임 수를 채우고 닫음
+void stopReplayRecording(){
+    if(replayRecordFile == NULL) return;
+    SDL_RWseek(replayRecordFile, REPLAY_FRAME_COUNT_OFFSET, RW_SEEK_SET);
+    SDL_WriteLE32(replayRecordFile, replayRecordedFrames);
+    SDL_RWclose(replayRecordFile);
+    replayRecordFile = NULL;
+    LOG_INFO(LOG_CORE, "Replay recorded: %u frames", replayRecordedFrames);
+}
+
+// 화면 전체 픽셀의 64비트 FNV-1a 해시
+static Uint64 hashFrame(SDL_Renderer *renderer, Uint32 *pixels, int width, int height){
+    if(SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, width * 4) != 0){
+        return 0;
+    }
+    Uint64 hash = 0xCBF29CE484222325ull;
+    const Uint8 *bytes = (const Uint8 *)pixels;
+    size_t size = (size_t)width * height * 4;
+    for(size_t i = 0; i < size; i++){
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static int compareReplayTime(const void *a, const void *b){
+    Uint64 x = *(const Uint64 *)a, y = *(const Uint64 *)b;
+    return x < y ? -1 : x > y;
+}
+
+typedef struct ReplayTimeStats{
+    double min, median, mean, p95, max; // ns
+} ReplayTimeStats;
+
+// 정렬하므로 times 순서는 바뀜
+static ReplayTimeStats summarizeReplayTimes(Uint64 *times, Uint32 count){
+    ReplayTimeStats stats = {0};
+    if(count == 0) return stats;
+    qsort(times, count, sizeof(Uint64), compareReplayTime);
+    double toNs = 1e9 / (double)SDL_GetPerformanceFrequency();
+    double total = 0.0;
+    for(Uint32 i = 0; i < count; i++) total += (double)times[i];
+    stats.min = times[0] * toNs;
+    stats.median = times[count / 2] * toNs;
+    stats.mean = total / count * toNs;
+    stats.p95 = times[(Uint32)((count - 1) * 0.95)] * toNs;
+    stats.max = times[count - 1] * toNs;
+    return stats;
+}
+
+static cJSON *replayStatsToJson(const ReplayTimeStats *stats){
+    cJSON *object = cJSON_CreateObject();
+    cJSON_AddNumberToObject(object, "minNs", stats->min);
+    cJSON_AddNumberToObject(object, "medianNs", stats->median);
+    cJSON_AddNumberToObject(object, "meanNs", stats->mean);
+    cJSON_AddNumberToObject(object, "p95Ns", stats->p95);
+    cJSON_AddNumberToObject(object, "maxNs", stats->max);
+    return object;
+}
+
+static void writeReplayReport(Uint32 frames, int mismatches, int firstMismatch, const ReplayTimeStats *update, const ReplayTimeStats *render){
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "replay", replayPath);
+    cJSON_AddStringToObject(root, "golden", replayGoldenPath);
+    cJSON_AddNumberToObject(root, "frames", frames);
+    cJSON_AddNumberToObject(root, "mismatches", mismatches);
+    cJSON_AddNumberToObject(root, "firstMismatch", firstMismatch);
+    cJSON_AddItemToObject(root, "update", replayStatsToJson(update));
+    cJSON_AddItemToObject(root, "render", replayStatsToJson(render));
+    char *text = cJSON_Print(root);
+    cJSON_Delete(root);
+    FILE *file = fopen(replayReportPath, "w");
+    if(file){
+        fputs(text, file);
+        fputc('\n', file);
+        fclose(file);
+    }
+    else{
+        LOG_ERROR(LOG_CORE, "Cannot write replay report %s", replayReportPath);
+    }
+    cJSON_free(text); // 할당 추적 훅으로 할당됐으므로 free로 풀면 안 됨
+}
+
+// 월드와 렌더러가 준비된 뒤 메인 루프 대신 호출, 골든 해시와 다르거나 파일이 맞지 않으면 1
+int runReplay(GameContext *game, SDL_Renderer *renderer, Map maps[], int mapCount, TTF_Font *font){
+    SDL_RWops *file = SDL_RWFromFile(replayPath, "rb");
+    if(file == NULL){
+        LOG_ERROR(LOG_CORE, "Cannot open replay %s: %s", replayPath, SDL_GetError());
+        return 1;
+    }
+    ReplayHeader header;
+    if(!readReplayHeader(file, &header)){
+        LOG_ERROR(LOG_CORE, "%s is not a replay file (or a different version)", replayPath);
+        SDL_RWclose(file);
+        return 1;
+    }
+    // 프레임이 하나도 없거나 헤더와 수가 다르면 녹화가 끝까지 저장되지 않은 것 (그대로 돌리면 0프레임으로 통과해버림)
+    SDL_bool truncated;
+    Uint32 storedFrames = countReplayFrames(file, &truncated);
+    if(header.frameCount == 0 || storedFrames != header.frameCount || truncated){
+        LOG_ERROR(LOG_CORE, "Replay %s is incomplete: header says %u frames, file has %u%s",
+                  replayPath, header.frameCount, storedFrames, truncated ? " and a cut-off frame" : "");
+        SDL_RWclose(file);
+        return 1;
+    }
+    // 월드가 다르면 같은 입력이어도 다른 곳으로 감
+    if(header.tickRate != physicsTickRate || header.mapCount != (Uint32)currentMapCount ||
+       header.platformCount != (Uint32)platformCount || header.interactionCount != (Uint32)interactionCount){
+        LOG_ERROR(LOG_CORE, "Replay world mismatch: tick rate %u/%d, maps %u/%d, platforms %u/%d, interactions %u/%d",
+                  header.tickRate, physicsTickRate, header.mapCount, currentMapCount,
+                  header.platformCount, platformCount, header.interactionCount, interactionCount);
+        SDL_RWclose(file);
+        return 1;
+    }
+
+    // 골든 파일을 달라고 했는데 못 열면 실패 (검사 없이 통과한 것처럼 보이지 않도록)
+    FILE *golden = NULL;
+    if(replayGoldenPath[0] != '\0'){
+        golden = fopen(replayGoldenPath, replayWriteGolden ? "w" : "r");
+        if(golden == NULL){
+            LOG_ERROR(LOG_CORE, "Cannot open golden file %s", replayGoldenPath);
+            SDL_RWclose(file);
+            return 1;
+        }
+    }
+
+    startGame(game, header.startTime, (int)header.npcCount);
+    if(game->randomState != header.randomState){
+        LOG_ERROR(LOG_CORE, "Replay random state mismatch after setup: %08x / %08x", header.randomState, game->randomState);
+        cancelPendingEvent(game);
+        resetPrefetch(game);
+        freeAnimations(game->world.animations, game->world.animationCount);
+        if(golden) fclose(golden);
+        SDL_RWclose(file);
+        return 1;
+    }
+
+    int width = 0, height = 0;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    Uint32 *pixels = MEM_ALLOC(MEM_CORE, (size_t)width * height * 4);
+    Uint64 *updateTimes = MEM_ALLOC(MEM_CORE, (header.frameCount + 1) * sizeof(Uint64));
+    Uint64 *renderTimes = MEM_ALLOC(MEM_CORE, (header.frameCount + 1) * sizeof(Uint64));
+
+    int mismatches = 0;
+    int firstMismatch = -1;
+    int diverged = 0; // 녹화 때와 다른 프레임에 이벤트가 시작되면 이후 화면은 믿을 수 없음
+    Uint32 frame = 0;
+    for(; frame < header.frameCount && running; frame++){
+        Uint32 time = SDL_ReadLE32(file);
+        Uint8 flags = SDL_ReadU8(file);
+        Uint16 eventCount = SDL_ReadLE16(file);
+        for(Uint16 e = 0; e < eventCount; e++){
+            SDL_Event event;
+            memset(&event, 0, sizeof(event));
+            event.key.timestamp = SDL_ReadLE32(file);
+            event.key.keysym.scancode = (SDL_Scancode)SDL_ReadLE16(file);
+            event.type = SDL_ReadU8(file) ? SDL_KEYDOWN : SDL_KEYUP;
+            recordInputEvent(game, &event);
+        }
+        SDL_Event windowEvent;
+        while(SDL_PollEvent(&windowEvent)){
+            if(windowEvent.type == SDL_QUIT) running = SDL_FALSE; // 실제 키 입력은 섞지 않음
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        updateInputFrame(game);
+        EventStartMode eventStart = (flags & REPLAY_FRAME_EVENT_STARTED) ? EVENT_START_NOW : EVENT_START_HOLD;
+        SDL_bool eventStarted = updateGameFrame(game, time, eventStart);
+        Uint64 updated = SDL_GetPerformanceCounter();
+        render(game, renderer, maps, mapCount, font);
+        Uint64 rendered = SDL_GetPerformanceCounter();
+        updateTimes[frame] = updated - start;
+        renderTimes[frame] = rendered - updated;
+
+        if(eventStarted != ((flags & REPLAY_FRAME_EVENT_STARTED) != 0) && diverged++ == 0){
+            LOG_ERROR(LOG_CORE, "Replay diverged at frame %u: event %s", frame, eventStarted ? "started early" : "did not start");
+        }
+        if(golden != NULL){
+            Uint64 hash = hashFrame(renderer, pixels, width, height);
+            if(replayWriteGolden){
+                fprintf(golden, "%016llx\n", (unsigned long long)hash);
+            }
+            else{
+                unsigned long long expected = 0;
+                if(fscanf(golden, "%llx", &expected) != 1 || expected != hash){
+                    if(mismatches++ == 0){
+                        firstMismatch = (int)frame;
+                        LOG_ERROR(LOG_CORE, "Frame %u hash %016llx does not match golden %016llx (time %u ms)",
+                                  frame, (unsigned long long)hash, expected, time);
+                    }
+                }
+            }
+        }
+    }
+    // 끝까지 돌렸는데 골든 해시가 남아 있으면 녹화와 골든 파일이 짝이 아님
+    SDL_bool goldenHasExtra = SDL_FALSE;
+    if(golden != NULL && !replayWriteGolden && frame == header.frameCount){
+        unsigned long long extra;
+        if(fscanf(golden, "%llx", &extra) == 1){
+            goldenHasExtra = SDL_TRUE;
+            LOG_ERROR(LOG_CORE, "Golden file %s has more hashes than the replay's %u frames", replayGoldenPath, header.frameCount);
+        }
+    }
+    if(golden) fclose(golden);
+    SDL_RWclose(file);
+
+    ReplayTimeStats updateStats = summarizeReplayTimes(updateTimes, frame);
+    ReplayTimeStats renderStats = summarizeReplayTimes(renderTimes, frame);
+    LOG_INFO(LOG_CORE, "Replay: %u / %u frames, update median / p95 / max: %.0f / %.0f / %.0f ns, render: %.0f / %.0f / %.0f ns",
+             frame, header.frameCount, updateStats.median, updateStats.p95, updateStats.max, renderStats.median, renderStats.p95, renderStats.max);
+    if(golden != NULL && !replayWriteGolden){
+        LOG_INFO(LOG_CORE, "Replay golden check: %d mismatched frames%s", mismatches, mismatches == 0 && !goldenHasExtra ? " (pass)" : "");
+    }
+    else if(replayWriteGolden && replayGoldenPath[0] != '\0'){
+        LOG_INFO(LOG_CORE, "Golden hashes written to %s", replayGoldenPath);
+    }
+    if(replayReportPath[0] != '\0'){
+        writeReplayReport(frame, mismatches, firstMismatch, &updateStats, &renderStats);
+    }
+
+    cancelPendingEvent(game);
+    resetPrefetch(game);
+    freeAnimations(game->world.animations, game->world.animationCount);
+    MEM_FREE(pixels);
+    MEM_FREE(updateTimes);
+    MEM_FREE(renderTimes);
+    return (mismatches > 0 || goldenHasExtra || diverged > 0 || frame < header.frameCount) ? 1 : 0;
+}
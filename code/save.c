@@ -0,0 +1,449 @@
+#include "global.h"
+#include "packFormat.h"
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// 세이브 (실행 인자 --save=파일, --autosave=초, --nosave)
+// 메인 스레드는 진행 상태(플레이어, 소지품, 상점 재고, 이벤트 / 대화 플래그, 현재 맵)를 작은 버퍼에 옮겨 적기만 하고
+// LZ 압축, 파일 쓰기, fsync, 이름 바꾸기는 세이브 스레드가 함 (쓰다가 꺼져도 이전 세이브는 남음)
+// 자동 저장은 게임 시계 타이머로 돌고, 이전 세이브를 아직 쓰는 중이면 기다리지 않고 건너뜀
+// 시작할 때 세이브가 있으면 읽어서 이어함 (--newgame이면 무시), F6: 지금 저장, F7: 세이브 다시 읽기
+// 파일 형식 (리틀 엔디언)
+//   헤더: "DDSV", 버전 u16, 플래그 u16 (bit0: LZ 압축), 원본 크기 u32, 저장된 크기 u32, 원본 FNV-1a u32
+//   본문: 맵 번호 u16, 맵 수 u16, 맵 안 x f32, y f32, 방향 i8, 돈 i32, 맵 안 카메라 x f32
+//         소지품 수 u8 + (이름 32바이트, 개수 i32), 상점 아이템 수 u8 + (이름 32바이트, 재고 i32)
+//         플래그 범위 u16 + 이벤트 플래그 u32 x (범위 / 32) + 대화 플래그 u16 x 범위
+#define SAVE_MAGIC 0x56534444u      // "DDSV"
+#define SAVE_VERSION 1
+#define SAVE_HEADER_SIZE 20
+#define SAVE_FLAG_COMPRESSED 1
+#define SAVE_BUFFER_SIZE 4096       // 본문 최대 크기 (지금 항목을 다 채워도 2KB 남짓)
+#define SAVE_STORED_SIZE (SAVE_HEADER_SIZE + SAVE_BUFFER_SIZE + SAVE_BUFFER_SIZE / 255 + 16)
+#define AUTOSAVE_RETRY_DELAY 5000   // 대화, 상점, 미니게임 중이면 끝날 때까지 이만큼씩 미룸 (ms)
+
+char savePath[256] = "save.dat";
+int autosaveInterval = 60;
+SDL_bool savesEnabled = SDL_TRUE;
+int saveCount = 0;
+int savesSkipped = 0;
+
+static SDL_Thread *saveThread = NULL;
+static SDL_sem *saveSemaphore = NULL;
+static SDL_atomic_t saveThreadRunning;
+static SDL_atomic_t saveWriting;   // 1이면 saveRaw를 세이브 스레드가 쓰는 중 (메인 스레드는 건드리지 않음)
+static Uint8 saveRaw[SAVE_BUFFER_SIZE];
+static size_t saveRawSize = 0;
+static Uint8 saveStored[SAVE_STORED_SIZE];
+
+typedef struct SaveBuffer{
+    Uint8 *data;
+    size_t size;
+    size_t capacity;
+    SDL_bool overflow; // 쓰기: 자리가 모자람, 읽기: 파일이 잘림
+} SaveBuffer;
+
+static void putBytes(SaveBuffer *buffer, const void *data, size_t size){
+    if(buffer->size + size > buffer->capacity){
+        buffer->overflow = SDL_TRUE;
+        return;
+    }
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+static void putU8(SaveBuffer *buffer, Uint8 value){
+    putBytes(buffer, &value, 1);
+}
+
+static void putU16(SaveBuffer *buffer, Uint16 value){
+    Uint8 bytes[2] = { (Uint8)value, (Uint8)(value >> 8) };
+    putBytes(buffer, bytes, 2);
+}
+
+static void putU32(SaveBuffer *buffer, Uint32 value){
+    Uint8 bytes[4] = { (Uint8)value, (Uint8)(value >> 8), (Uint8)(value >> 16), (Uint8)(value >> 24) };
+    putBytes(buffer, bytes, 4);
+}
+
+static void putFloat(SaveBuffer *buffer, float value){
+    Uint32 bits;
+    memcpy(&bits, &value, 4);
+    putU32(buffer, bits);
+}
+
+static void putName(SaveBuffer *buffer, const char *name){
+    char field[32] = { 0 };
+    strncpy(field, name, sizeof(field) - 1);
+    putBytes(buffer, field, sizeof(field));
+}
+
+static void getBytes(SaveBuffer *buffer, void *data, size_t size){
+    if(buffer->size + size > buffer->capacity){
+        buffer->overflow = SDL_TRUE;
+        memset(data, 0, size);
+        return;
+    }
+    memcpy(data, buffer->data + buffer->size, size);
+    buffer->size += size;
+}
+
+static Uint8 getU8(SaveBuffer *buffer){
+    Uint8 value;
+    getBytes(buffer, &value, 1);
+    return value;
+}
+
+static Uint16 getU16(SaveBuffer *buffer){
+    Uint8 bytes[2];
+    getBytes(buffer, bytes, 2);
+    return (Uint16)(bytes[0] | (bytes[1] << 8));
+}
+
+static Uint32 getU32(SaveBuffer *buffer){
+    Uint8 bytes[4];
+    getBytes(buffer, bytes, 4);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((Uint32)bytes[3] << 24);
+}
+
+static float getFloat(SaveBuffer *buffer){
+    Uint32 bits = getU32(buffer);
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+static void getName(SaveBuffer *buffer, char *name){
+    getBytes(buffer, name, 32);
+    name[31] = '\0';
+}
+
+static Uint32 hashSaveData(const Uint8 *data, size_t size){
+    Uint32 hash = 2166136261u;
+    for(size_t i = 0; i < size; i++){
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 진행 상태를 본문 형식으로 옮겨 적음 (메인 스레드, 마이크로초 단위)
+static size_t serializeGame(GameContext *game, Uint8 *data, size_t capacity){
+    SaveBuffer buffer = { data, 0, capacity, SDL_FALSE };
+    const PlayerState *player = &game->player;
+    const UIState *ui = &game->ui;
+    const WorldState *world = &game->world;
+
+    // 위치는 맵 기준으로 남겨서 앞쪽 맵 너비가 바뀌어도 같은 방에서 이어함
+    int mapIndex = findMapAt(player->x);
+    float mapX = (float)(maps[mapIndex].worldX * 3);
+    putU16(&buffer, (Uint16)mapIndex);
+    putU16(&buffer, (Uint16)currentMapCount);
+    putFloat(&buffer, player->x - mapX);
+    putFloat(&buffer, player->y);
+    putU8(&buffer, (Uint8)(Sint8)player->direction);
+    putU32(&buffer, (Uint32)player->gold);
+    putFloat(&buffer, game->camera.x - mapX);
+
+    putU8(&buffer, (Uint8)player->inventoryCount);
+    for(int i = 0; i < player->inventoryCount; i++){
+        putName(&buffer, player->inventory[i].name);
+        putU32(&buffer, (Uint32)player->inventory[i].quantity);
+    }
+
+    putU8(&buffer, (Uint8)ui->itemCount);
+    for(int i = 0; i < ui->itemCount; i++){
+        putName(&buffer, ui->items[i].name);
+        putU32(&buffer, (Uint32)ui->items[i].stock);
+    }
+
+    putU16(&buffer, MAX_EVENT_ID);
+    for(int i = 0; i < MAX_EVENT_ID / 32; i++){
+        putU32(&buffer, world->eventFlags[i]);
+    }
+    for(int i = 0; i < MAX_EVENT_ID; i++){
+        putU16(&buffer, world->dialogueFlags[i]);
+    }
+    return buffer.overflow ? 0 : buffer.size;
+}
+
+// 본문을 읽어 지금 판에 덮어씀, 형식이 맞지 않으면 아무것도 바꾸지 않음
+static SDL_bool applySaveData(GameContext *game, const Uint8 *data, size_t size){
+    SaveBuffer buffer = { (Uint8 *)data, 0, size, SDL_FALSE };
+    int mapIndex = getU16(&buffer);
+    int mapCount = getU16(&buffer);
+    float x = getFloat(&buffer);
+    float y = getFloat(&buffer);
+    int direction = (Sint8)getU8(&buffer);
+    int gold = (int)getU32(&buffer);
+    float cameraX = getFloat(&buffer);
+
+    Inventory inventory[MAX_INVENTORY_ITEMS];
+    int inventoryCount = getU8(&buffer);
+    if(inventoryCount > MAX_INVENTORY_ITEMS) return SDL_FALSE;
+    for(int i = 0; i < inventoryCount; i++){
+        getName(&buffer, inventory[i].name);
+        inventory[i].quantity = (int)getU32(&buffer);
+    }
+
+    char itemNames[MAX_SHOP_ITEMS][32];
+    int itemStock[MAX_SHOP_ITEMS];
+    int itemCount = getU8(&buffer);
+    if(itemCount > MAX_SHOP_ITEMS) return SDL_FALSE;
+    for(int i = 0; i < itemCount; i++){
+        getName(&buffer, itemNames[i]);
+        itemStock[i] = (int)getU32(&buffer);
+    }
+
+    Uint32 eventFlags[MAX_EVENT_ID / 32] = { 0 };
+    Uint16 dialogueFlags[MAX_EVENT_ID] = { 0 };
+    int flagRange = getU16(&buffer);
+    for(int i = 0; i < flagRange / 32; i++){
+        Uint32 flags = getU32(&buffer);
+        if(i < MAX_EVENT_ID / 32) eventFlags[i] = flags;
+    }
+    for(int i = 0; i < flagRange; i++){
+        Uint16 flags = getU16(&buffer);
+        if(i < MAX_EVENT_ID) dialogueFlags[i] = flags;
+    }
+    if(buffer.overflow) return SDL_FALSE;
+
+    if(mapIndex >= currentMapCount){
+        LOG_WARN(LOG_CORE, "Save is in map %d but only %d maps are loaded, starting position kept", mapIndex, currentMapCount);
+    }
+    else{
+        if(mapCount != currentMapCount){
+            LOG_WARN(LOG_CORE, "Save was made with %d maps, %d loaded now", mapCount, currentMapCount);
+        }
+        float mapX = (float)(maps[mapIndex].worldX * 3);
+        PlayerState *player = &game->player;
+        player->x = player->previousX = mapX + x;
+        player->y = player->previousY = y;
+        player->velocityX = player->velocityY = 0.0f;
+        player->direction = direction < 0 ? -1 : 1;
+        game->camera.x = mapX + cameraX;
+    }
+
+    game->player.gold = gold;
+    memcpy(game->player.inventory, inventory, sizeof(Inventory) * inventoryCount);
+    game->player.inventoryCount = inventoryCount;
+
+    // 재고는 이름으로 맞춤 (맵에서 상점 목록이 바뀌었으면 새 아이템은 처음 재고로)
+    UIState *ui = &game->ui;
+    for(int i = 0; i < itemCount; i++){
+        for(int j = 0; j < ui->itemCount; j++){
+            if(strcmp(ui->items[j].name, itemNames[i]) == 0){
+                ui->items[j].stock = itemStock[i];
+                break;
+            }
+        }
+    }
+
+    memcpy(game->world.eventFlags, eventFlags, sizeof(eventFlags));
+    memcpy(game->world.dialogueFlags, dialogueFlags, sizeof(dialogueFlags));
+
+    // 트리거는 다음 물리 틱에 새 위치로 다시 계산
+    cancelPendingEvent(game);
+    resetTriggers(game);
+    return SDL_TRUE;
+}
+
+// 세이브 스레드 (스레드가 없으면 메인 스레드): 압축해서 임시 파일에 쓰고 fsync한 뒤 이름 바꾸기
+static void writeSaveFile(){
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint8 *payload = saveStored + SAVE_HEADER_SIZE;
+    size_t storedSize = packLZ(saveRaw, saveRawSize, payload);
+    Uint16 flags = SAVE_FLAG_COMPRESSED;
+    if(storedSize >= saveRawSize){ // 줄어들지 않으면 그대로
+        memcpy(payload, saveRaw, saveRawSize);
+        storedSize = saveRawSize;
+        flags = 0;
+    }
+
+    SaveBuffer header = { saveStored, 0, SAVE_HEADER_SIZE, SDL_FALSE };
+    putU32(&header, SAVE_MAGIC);
+    putU16(&header, SAVE_VERSION);
+    putU16(&header, flags);
+    putU32(&header, (Uint32)saveRawSize);
+    putU32(&header, (Uint32)storedSize);
+    putU32(&header, hashSaveData(saveRaw, saveRawSize));
+
+    char tempPath[sizeof(savePath) + 4];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", savePath);
+    FILE *file = fopen(tempPath, "wb");
+    if(file == NULL){
+        LOG_ERROR(LOG_CORE, "Cannot write save %s", tempPath);
+        return;
+    }
+    size_t total = SAVE_HEADER_SIZE + storedSize;
+    SDL_bool written = fwrite(saveStored, 1, total, file) == total && fflush(file) == 0;
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+    fclose(file);
+    if(!written){
+        LOG_ERROR(LOG_CORE, "Failed to write save %s", tempPath);
+        remove(tempPath);
+        return;
+    }
+#ifdef _WIN32
+    remove(savePath); // 윈도우의 rename은 덮어쓰지 않음
+#endif
+    if(rename(tempPath, savePath) != 0){
+        LOG_ERROR(LOG_CORE, "Failed to replace save %s", savePath);
+        return;
+    }
+    recordIOEvent("save", savePath, start);
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    LOG_INFO(LOG_CORE, "Saved %s: %u -> %u bytes in %.1f ms", savePath, (unsigned)saveRawSize, (unsigned)total, elapsed);
+}
+
+static int saveWriterThread(void *data){
+    while(SDL_AtomicGet(&saveThreadRunning)){
+        if(!SDL_AtomicGet(&saveWriting)){
+            SDL_SemWaitTimeout(saveSemaphore, 100);
+            continue;
+        }
+        writeSaveFile();
+        SDL_AtomicSet(&saveWriting, 0);
+    }
+    return 0;
+}
+
+void initSaveSystem(){
+    SDL_AtomicSet(&saveWriting, 0);
+    SDL_AtomicSet(&saveThreadRunning, 1);
+    saveSemaphore = SDL_CreateSemaphore(0);
+    saveThread = SDL_CreateThread(saveWriterThread, "SaveWriter", NULL);
+    if(saveThread == NULL){
+        LOG_ERROR(LOG_CORE, "Failed to create save writer, saving synchronously: %s", SDL_GetError());
+    }
+}
+
+// 쓰는 중인 세이브를 마저 쓰고 스레드 종료
+void shutdownSaveSystem(){
+    if(saveThread != NULL){
+        while(SDL_AtomicGet(&saveWriting)) SDL_Delay(1);
+        SDL_AtomicSet(&saveThreadRunning, 0);
+        SDL_SemPost(saveSemaphore);
+        SDL_WaitThread(saveThread, NULL);
+        saveThread = NULL;
+    }
+    if(saveSemaphore != NULL){
+        SDL_DestroySemaphore(saveSemaphore);
+        saveSemaphore = NULL;
+    }
+}
+
+// 지금 상태를 세이브 스레드에 넘김, waitForWriter가 아니면 이전 세이브를 쓰는 중일 때 건너뜀
+SDL_bool requestSave(GameContext *game, SDL_bool waitForWriter){
+    if(!savesEnabled) return SDL_FALSE;
+    if(SDL_AtomicGet(&saveWriting)){
+        if(!waitForWriter){
+            savesSkipped++;
+            LOG_DEBUG(LOG_CORE, "Previous save is still being written, skipped");
+            return SDL_FALSE;
+        }
+        while(SDL_AtomicGet(&saveWriting)) SDL_Delay(1);
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    saveRawSize = serializeGame(game, saveRaw, sizeof(saveRaw));
+    if(saveRawSize == 0){
+        LOG_ERROR(LOG_CORE, "Save data does not fit in %d bytes", SAVE_BUFFER_SIZE);
+        return SDL_FALSE;
+    }
+    double elapsed = (double)(SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency();
+    LOG_DEBUG(LOG_CORE, "Save serialized: %u bytes in %.1f us", (unsigned)saveRawSize, elapsed);
+    saveCount++;
+
+    if(saveThread == NULL){
+        writeSaveFile();
+        return SDL_TRUE;
+    }
+    SDL_AtomicSet(&saveWriting, 1);
+    SDL_SemPost(saveSemaphore);
+    return SDL_TRUE;
+}
+
+// 세이브를 읽어 지금 판에 적용, 파일이 없거나 깨졌으면 SDL_FALSE (판은 그대로)
+SDL_bool loadGame(GameContext *game){
+    if(!savesEnabled) return SDL_FALSE;
+    Uint64 start = SDL_GetPerformanceCounter();
+    FILE *file = fopen(savePath, "rb");
+    if(file == NULL) return SDL_FALSE;
+
+    Uint8 headerData[SAVE_HEADER_SIZE];
+    SDL_bool loaded = SDL_FALSE;
+    Uint8 *stored = NULL;
+    Uint8 *raw = NULL;
+    if(fread(headerData, 1, SAVE_HEADER_SIZE, file) == SAVE_HEADER_SIZE){
+        SaveBuffer header = { headerData, 0, SAVE_HEADER_SIZE, SDL_FALSE };
+        Uint32 magic = getU32(&header);
+        Uint16 version = getU16(&header);
+        Uint16 flags = getU16(&header);
+        Uint32 rawSize = getU32(&header);
+        Uint32 storedSize = getU32(&header);
+        Uint32 checksum = getU32(&header);
+
+        if(magic != SAVE_MAGIC || version != SAVE_VERSION){
+            LOG_WARN(LOG_CORE, "%s is not a save file (or a different version)", savePath);
+        }
+        else if(rawSize > SAVE_BUFFER_SIZE || storedSize > SAVE_STORED_SIZE){
+            LOG_WARN(LOG_CORE, "Save %s is too large", savePath);
+        }
+        else{
+            stored = MEM_ALLOC(MEM_CORE, storedSize + 1);
+            raw = MEM_ALLOC(MEM_CORE, rawSize + 1);
+            SDL_bool unpacked = stored != NULL && raw != NULL && fread(stored, 1, storedSize, file) == storedSize;
+            if(unpacked){
+                if(flags & SAVE_FLAG_COMPRESSED){
+                    unpacked = unpackLZ(stored, storedSize, raw, rawSize);
+                }
+                else if(storedSize == rawSize){
+                    memcpy(raw, stored, rawSize);
+                }
+                else{
+                    unpacked = SDL_FALSE;
+                }
+            }
+            if(!unpacked || hashSaveData(raw, rawSize) != checksum){
+                LOG_WARN(LOG_CORE, "Save %s is damaged", savePath);
+            }
+            else{
+                loaded = applySaveData(game, raw, rawSize);
+                if(!loaded) LOG_WARN(LOG_CORE, "Save %s has an unexpected layout", savePath);
+            }
+        }
+    }
+    fclose(file);
+    MEM_FREE(stored);
+    MEM_FREE(raw);
+
+    if(loaded){
+        double elapsed = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        LOG_INFO(LOG_CORE, "Loaded %s in %.2f ms (gold %d, %d items)", savePath, elapsed, game->player.gold, game->player.inventoryCount);
+    }
+    return loaded;
+}
+
+static void autosaveCallback(GameContext *game, void *data){
+    UIState *ui = &game->ui;
+    // 대화, 상점, 미니게임 중간 상태는 세이브에 없으므로 끝난 뒤에 저장
+    if(ui->isDialogueActive || ui->isShopVisible || ui->isMiniGameActive || game->world.pendingEventInteraction != -1){
+        addTimer(game, AUTOSAVE_RETRY_DELAY, autosaveCallback, NULL);
+        return;
+    }
+    requestSave(game, SDL_FALSE);
+    addTimer(game, (Uint32)autosaveInterval * 1000, autosaveCallback, NULL);
+}
+
+// startGame (과 세이브 읽기) 뒤에 호출
+void startAutosave(GameContext *game){
+    if(!savesEnabled || autosaveInterval <= 0) return;
+    addTimer(game, (Uint32)autosaveInterval * 1000, autosaveCallback, NULL);
+}
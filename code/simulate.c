@@ -0,0 +1,491 @@
+#include "global.h"
+
+// 빠른 감기 시뮬레이션 (실행 인자 --simulate[=입력 스크립트], --simticks=N)
+// 창, 렌더러, 오디오 장치 없이 게임 로직만 가상 시계로 쉬지 않고 돌림 (물리 틱 하나 = 프레임 하나)
+// 입력은 스크립트 파일에서 읽고, 스크립트가 없으면 자동 조종으로 안 가본 상호작용을 찾아다니며 대화 선택지를 돌아가며 고름
+// 끝나면 초당 틱 수와 상호작용 / 대화 노드 도달률을 출력
+// --simthreads=N이면 같은 시뮬레이션을 컨텍스트 N개로 스레드마다 동시에 돌리고 결과가 전부 같은지 확인
+// 스크립트 형식: 한 줄에 '시각(ms) down|up|tap 키이름' (예: 1500 tap E), #으로 시작하면 주석
+#define SIM_START_TIME 1000     // 가상 시계 시작 시각 (ms, 0은 '없음'으로 쓰는 곳이 있어서 피함)
+#define SIM_DEFAULT_SECONDS 600 // --simticks가 없을 때 돌릴 게임 시간 (초)
+#define MAX_SIM_INPUTS 4096
+#define MAX_SIM_EVENTS 32
+#define MAX_SIM_NODES 10        // 대화 배열 크기 (UIState.dialogues)
+#define MAX_SIM_THREADS 16
+
+SDL_bool simulateEnabled = SDL_FALSE;
+char simulateScript[256] = "";  // 비어 있으면 자동 조종
+int simulateTickLimit = 0;      // 0이면 SIM_DEFAULT_SECONDS만큼
+int simulateThreads = 1;
+
+typedef struct SimInput{
+    Uint32 time;
+    SDL_Scancode scancode;
+    SDL_bool pressed;
+} SimInput;
+
+typedef struct SimEventCoverage{
+    int eventID;
+    int nodeCount;
+    SDL_bool reached[MAX_SIM_NODES];
+    int optionTaken[MAX_SIM_NODES][4]; // 자동 조종이 고른 횟수 (덜 고른 선택지부터)
+} SimEventCoverage;
+
+typedef struct Simulation{
+    GameContext game;
+
+    SimInput inputs[MAX_SIM_INPUTS];
+    int inputCount;
+    int nextInput;
+
+    // 자동 조종
+    int target;                 // 걸어가는 상호작용 (-1이면 새로 고름)
+    SDL_Scancode heldKey;       // 누르고 있는 이동 키
+    Uint32 nextActionTime;      // UI 키를 다음에 누를 수 있는 시각
+    float progressX;            // 막힘 감지: 마지막으로 움직였을 때의 x와 시각
+    Uint32 progressTime;
+    SDL_bool shopBought;
+    int visits[MAX_INTERACTIONS];            // 상호작용별 E를 누른 횟수
+    SDL_bool blocked[MAX_INTERACTIONS];      // 이번 층에서 걸어서 못 가는 상호작용
+
+    // 도달률
+    SimEventCoverage events[MAX_SIM_EVENTS];
+    int eventCount;
+} Simulation;
+
+static SimEventCoverage *findSimEvent(Simulation *sim, int eventID){
+    for(int i = 0; i < sim->eventCount; i++){
+        if(sim->events[i].eventID == eventID) return &sim->events[i];
+    }
+    return NULL;
+}
+
+// 이벤트 상호작용의 대화 JSON을 미리 읽어 노드 수를 셈 (도달률 분모)
+static void loadSimEvents(Simulation *sim){
+    for(int i = 0; i < interactionCount; i++){
+        if(interactions[i].type != INTERACTION_EVENT || findSimEvent(sim, interactions[i].eventID) != NULL) continue;
+        if(sim->eventCount >= MAX_SIM_EVENTS) break;
+
+        SimEventCoverage *event = &sim->events[sim->eventCount++];
+        event->eventID = interactions[i].eventID;
+
+        char filePath[64];
+        snprintf(filePath, sizeof(filePath), "resource/eventID/%d.json", event->eventID);
+        char *data = readFile(filePath);
+        cJSON *json = data != NULL ? cJSON_Parse(data) : NULL;
+        MEM_FREE(data);
+        int count = cJSON_GetArraySize(cJSON_GetObjectItem(json, "dialogues"));
+        event->nodeCount = count < MAX_SIM_NODES ? count : MAX_SIM_NODES;
+        cJSON_Delete(json);
+    }
+}
+
+static SDL_bool loadSimScript(Simulation *sim, const char *path){
+    char *data = readFile(path);
+    if(data == NULL){
+        LOG_ERROR(LOG_CORE, "Failed to read simulation script %s", path);
+        return SDL_FALSE;
+    }
+
+    char *line = data;
+    for(int lineNumber = 1; line != NULL && *line != '\0'; lineNumber++){
+        char *next = strchr(line, '\n');
+        if(next != NULL) *next++ = '\0';
+
+        unsigned int time;
+        char action[16], key[32];
+        if(line[0] != '#' && sscanf(line, "%u %15s %31s", &time, action, key) == 3){
+            SDL_Scancode scancode = SDL_GetScancodeFromName(key);
+            SDL_bool isTap = strcmp(action, "tap") == 0;
+            if(scancode == SDL_SCANCODE_UNKNOWN){
+                LOG_WARN(LOG_CORE, "%s:%d: unknown key '%s'", path, lineNumber, key);
+            }
+            else if(sim->inputCount + 2 > MAX_SIM_INPUTS){
+                LOG_WARN(LOG_CORE, "%s: more than %d inputs, rest ignored", path, MAX_SIM_INPUTS);
+                break;
+            }
+            else if(isTap || strcmp(action, "down") == 0){
+                sim->inputs[sim->inputCount++] = (SimInput){ SIM_START_TIME + time, scancode, SDL_TRUE };
+                if(isTap) sim->inputs[sim->inputCount++] = (SimInput){ SIM_START_TIME + time, scancode, SDL_FALSE };
+            }
+            else if(strcmp(action, "up") == 0){
+                sim->inputs[sim->inputCount++] = (SimInput){ SIM_START_TIME + time, scancode, SDL_FALSE };
+            }
+            else{
+                LOG_WARN(LOG_CORE, "%s:%d: unknown action '%s'", path, lineNumber, action);
+            }
+        }
+        line = next;
+    }
+    MEM_FREE(data);
+    LOG_INFO(LOG_CORE, "Simulation script %s: %d inputs", path, sim->inputCount);
+    return SDL_TRUE;
+}
+
+// 가상 시각을 찍은 키 이벤트를 입력 버퍼에 넣음 (창에서 들어온 이벤트와 같은 경로)
+static void pushSimKey(Simulation *sim, SDL_Scancode scancode, SDL_bool pressed){
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = pressed ? SDL_KEYDOWN : SDL_KEYUP;
+    event.key.timestamp = sim->game.clock.time;
+    event.key.keysym.scancode = scancode;
+    recordInputEvent(&sim->game, &event);
+}
+
+static void tapSimKey(Simulation *sim, SDL_Scancode scancode){
+    pushSimKey(sim, scancode, SDL_TRUE);
+    pushSimKey(sim, scancode, SDL_FALSE);
+}
+
+static void holdSimKey(Simulation *sim, SDL_Scancode scancode){
+    if(sim->heldKey == scancode) return;
+    if(sim->heldKey != SDL_SCANCODE_UNKNOWN) pushSimKey(sim, sim->heldKey, SDL_FALSE);
+    if(scancode != SDL_SCANCODE_UNKNOWN) pushSimKey(sim, scancode, SDL_TRUE);
+    sim->heldKey = scancode;
+}
+
+static SDL_bool isSimTriggerActive(const GameContext *game, int index){
+    for(int t = 0; t < game->world.activeTriggerCount; t++){
+        if(game->world.activeTriggers[t] == index) return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool hasUnreachedNodes(Simulation *sim, int eventID){
+    SimEventCoverage *event = findSimEvent(sim, eventID);
+    if(event == NULL) return SDL_FALSE;
+    for(int n = 0; n < event->nodeCount; n++){
+        if(!event->reached[n]) return SDL_TRUE;
+    }
+    return SDL_FALSE;
+}
+
+// 다음에 갈 상호작용: 같은 층에서 안 가본 것 -> 안 가본 이동 -> 대화를 다 못 본 이벤트 -> 가장 덜 쓴 이동 순, 같으면 가까운 것
+static int pickSimTarget(Simulation *sim){
+    const PlayerState *player = &sim->game.player;
+    float playerCenter = player->x + player->rect.w / 2;
+    int best = -1;
+    float bestScore = 0.0f;
+
+    for(int i = 0; i < interactionCount; i++){
+        const Interaction *zone = &interactions[i];
+        if(sim->blocked[i] || zone->type == INTERACTION_NONE) continue;
+        if(zone->y >= player->y + player->rect.h + 36 || zone->y + zone->height <= player->y - 36) continue; // 다른 층
+
+        int priority;
+        if(sim->visits[i] == 0) priority = zone->type == INTERACTION_TELEPORT ? 1 : 0;
+        else if(zone->type == INTERACTION_EVENT && sim->visits[i] < 8 && hasUnreachedNodes(sim, zone->eventID)) priority = 2;
+        else if(zone->type == INTERACTION_TELEPORT) priority = 3 + sim->visits[i];
+        else continue;
+
+        float score = priority * 1000000.0f + fabsf(zone->x + zone->width / 2 - playerCenter);
+        if(best == -1 || score < bestScore){
+            best = i;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+// 자동 조종: UI가 떠 있으면 그 UI를 진행하고, 아니면 목표 상호작용으로 걸어가서 E
+static void updateSimPilot(Simulation *sim){
+    GameContext *game = &sim->game;
+    UIState *ui = &game->ui;
+    Uint32 now = game->clock.time;
+
+    if(ui->isMiniGameActive || ui->isShopVisible || ui->isDialogueActive){
+        holdSimKey(sim, SDL_SCANCODE_UNKNOWN);
+        if(now < sim->nextActionTime) return;
+
+        if(ui->isMiniGameActive){
+            tapSimKey(sim, SDL_SCANCODE_SPACE); // 초당 16연타
+            sim->nextActionTime = now + 62;
+        }
+        else if(ui->isShopVisible){
+            tapSimKey(sim, sim->shopBought ? SDL_SCANCODE_ESCAPE : SDL_SCANCODE_Z);
+            sim->shopBought = !sim->shopBought;
+            sim->nextActionTime = now + 200;
+        }
+        else{
+            DialogueText *dialogue = &ui->dialogues[ui->dialogues->currentID];
+            SimEventCoverage *event = findSimEvent(sim, ui->currentDialogueEvent);
+            int node = ui->dialogues->currentID;
+            int choice = -1;
+
+            int *taken = event != NULL && node >= 0 && node < MAX_SIM_NODES ? event->optionTaken[node] : NULL;
+
+            // 게임 종료(-2)가 아닌 선택지 중 가장 덜 고른 것
+            for(int j = 0; j < dialogue->optionCount && j < 4; j++){
+                if(dialogue->nextIds[j] == -2) continue;
+                if(choice == -1 || (taken != NULL && taken[j] < taken[choice])) choice = j;
+            }
+            if(choice == -1) choice = 0; // 종료밖에 없으면 종료
+
+            // 선택지 이동은 프레임당 한 칸씩 (wasKeyPressed는 한 프레임에 한 번으로 봄)
+            if(dialogue->optionCount > 0 && ui->selectedOption != choice){
+                tapSimKey(sim, SDL_SCANCODE_DOWN);
+                sim->nextActionTime = now + 50;
+                return;
+            }
+            if(dialogue->optionCount > 0 && taken != NULL) taken[choice]++;
+            tapSimKey(sim, SDL_SCANCODE_Z);
+            sim->nextActionTime = now + 150;
+        }
+        return;
+    }
+
+    const PlayerState *player = &game->player;
+    if(sim->target == -1){
+        if(player->velocityY != 0.0f) return; // 떨어지는 중에는 층을 모름
+        sim->target = pickSimTarget(sim);
+        sim->progressX = player->x;
+        sim->progressTime = now;
+        if(sim->target == -1) return;
+    }
+
+    if(isSimTriggerActive(game, sim->target)){
+        holdSimKey(sim, SDL_SCANCODE_UNKNOWN);
+        tapSimKey(sim, SDL_SCANCODE_E);
+        for(int t = 0; t < game->world.activeTriggerCount; t++){
+            sim->visits[game->world.activeTriggers[t]]++;
+        }
+        if(interactions[sim->target].type == INTERACTION_TELEPORT){
+            memset(sim->blocked, 0, sizeof(sim->blocked)); // 다른 층으로 감
+        }
+        sim->target = -1;
+        return;
+    }
+
+    const Interaction *zone = &interactions[sim->target];
+    holdSimKey(sim, zone->x + zone->width / 2 < player->x + player->rect.w / 2 ? SDL_SCANCODE_LEFT : SDL_SCANCODE_RIGHT);
+
+    // 2초 동안 제자리면 벽에 막힌 것
+    if(fabsf(player->x - sim->progressX) > 1.0f){
+        sim->progressX = player->x;
+        sim->progressTime = now;
+    }
+    else if(now - sim->progressTime > 2000){
+        sim->blocked[sim->target] = SDL_TRUE;
+        sim->target = -1;
+    }
+}
+
+static void recordSimCoverage(Simulation *sim){
+    UIState *ui = &sim->game.ui;
+    if(!ui->isDialogueActive) return;
+    SimEventCoverage *event = findSimEvent(sim, ui->currentDialogueEvent);
+    int node = ui->dialogues->currentID;
+    if(event != NULL && node >= 0 && node < event->nodeCount) event->reached[node] = SDL_TRUE;
+}
+
+static SDL_bool isSimComplete(Simulation *sim){
+    for(int i = 0; i < interactionCount; i++){
+        if(interactions[i].type != INTERACTION_NONE && sim->visits[i] == 0) return SDL_FALSE;
+    }
+    for(int e = 0; e < sim->eventCount; e++){
+        if(hasUnreachedNodes(sim, sim->events[e].eventID)) return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+// 도달한 상호작용 수 (total에 전체 수)
+static int countSimInteractions(Simulation *sim, int *total){
+    int reached = 0;
+    *total = 0;
+    for(int i = 0; i < interactionCount; i++){
+        if(interactions[i].type == INTERACTION_NONE) continue;
+        (*total)++;
+        if(sim->visits[i] > 0) reached++;
+    }
+    return reached;
+}
+
+// 도달한 대화 노드 수 (total에 전체 수)
+static int countSimNodes(Simulation *sim, int *total){
+    int reached = 0;
+    *total = 0;
+    for(int e = 0; e < sim->eventCount; e++){
+        for(int n = 0; n < sim->events[e].nodeCount; n++){
+            if(sim->events[e].reached[n]) reached++;
+        }
+        *total += sim->events[e].nodeCount;
+    }
+    return reached;
+}
+
+static void reportSimulation(Simulation *sim, Uint64 ticks, double seconds, const char *reason){
+    double gameSeconds = (double)ticks / physicsTickRate;
+    LOG_INFO(LOG_CORE, "Simulation: %llu ticks (%.1f s game time) in %.2f s, %.0f ticks/s (x%.0f real time), %s",
+             (unsigned long long)ticks, gameSeconds, seconds, ticks / seconds, gameSeconds / seconds, reason);
+
+    int total;
+    int reached = countSimInteractions(sim, &total);
+    LOG_INFO(LOG_CORE, "Interactions reached: %d / %d", reached, total);
+    for(int i = 0; i < interactionCount; i++){
+        if(interactions[i].type != INTERACTION_NONE && sim->visits[i] == 0){
+            LOG_INFO(LOG_CORE, "  not reached: %s (map %d, %.0f, %.0f)", interactions[i].name, interactions[i].mapIndex,
+                     interactions[i].x, interactions[i].y);
+        }
+    }
+
+    int nodeTotal;
+    int nodesReached = countSimNodes(sim, &nodeTotal);
+    LOG_INFO(LOG_CORE, "Dialogue nodes reached: %d / %d", nodesReached, nodeTotal);
+    for(int e = 0; e < sim->eventCount; e++){
+        SimEventCoverage *event = &sim->events[e];
+        char missing[64] = "";
+        for(int n = 0; n < event->nodeCount; n++){
+            if(!event->reached[n]) snprintf(missing + strlen(missing), sizeof(missing) - strlen(missing), " %d", n);
+        }
+        int count = 0;
+        for(int n = 0; n < event->nodeCount; n++) count += event->reached[n];
+        LOG_INFO(LOG_CORE, "  event %d: %d / %d%s%s", event->eventID, count, event->nodeCount,
+                 missing[0] != '\0' ? ", missing" : "", missing);
+    }
+}
+
+// 월드(맵, 플랫폼, 상호작용)가 구축된 뒤 호출, 시뮬레이션이 끝나면 반환
+// result가 있으면 자세한 보고 대신 결과를 채움 (다른 스레드에서 동시에 불러도 됨)
+int runSimulation(const char *scriptPath, int tickLimit, SimResult *result){
+    Simulation *sim = MEM_CALLOC(MEM_CORE, 1, sizeof(Simulation));
+    if(sim == NULL) return 1;
+    GameContext *game = &sim->game;
+
+    if(scriptPath[0] != '\0' && !loadSimScript(sim, scriptPath)){
+        MEM_FREE(sim);
+        return 1;
+    }
+    SDL_bool usePilot = scriptPath[0] == '\0';
+    if(tickLimit <= 0) tickLimit = SIM_DEFAULT_SECONDS * physicsTickRate;
+    if(!usePilot && sim->inputCount > 0){
+        // 스크립트 마지막 입력 뒤 5초 (미니게임 같은 타이머가 끝나도록)
+        Uint64 scriptTicks = (Uint64)(sim->inputs[sim->inputCount - 1].time - SIM_START_TIME + 5000) * physicsTickRate / 1000;
+        if(scriptTicks < (Uint64)tickLimit) tickLimit = (int)scriptTicks;
+    }
+
+    initGameContext(game, SIM_START_TIME);
+    game->audioEnabled = SDL_FALSE;
+    loadSimEvents(sim);
+    sim->target = -1;
+    sim->heldKey = SDL_SCANCODE_UNKNOWN;
+
+    const char *reason = "tick limit";
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 tick = 0;
+
+    for(; tick < (Uint64)tickLimit; tick++){
+        Uint32 now = SIM_START_TIME + (Uint32)(tick * 1000 / physicsTickRate);
+        game->clock.time = now; // 자동 조종과 스크립트는 이번 틱 시각으로 판단
+
+        if(usePilot){
+            updateSimPilot(sim);
+        }
+        while(sim->nextInput < sim->inputCount && sim->inputs[sim->nextInput].time <= now){
+            SimInput *input = &sim->inputs[sim->nextInput++];
+            pushSimKey(sim, input->scancode, input->pressed);
+        }
+        updateInputFrame(game);
+
+        // 메인 루프와 같은 프레임 함수 (이벤트 에셋은 그 자리에서 받아서 진행이 디스크 속도에 따라 달라지지 않도록)
+        updateGameFrame(game, now, EVENT_START_NOW);
+        recordSimCoverage(sim);
+
+        if(game->quitRequested){
+            reason = "quit chosen in dialogue";
+            tick++;
+            break;
+        }
+        if(usePilot && (tick & 127) == 0 && isSimComplete(sim)){
+            reason = "full coverage";
+            tick++;
+            break;
+        }
+    }
+
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    if(seconds <= 0.0) seconds = 1e-9;
+    if(result != NULL){
+        int total;
+        result->ticks = tick;
+        result->seconds = seconds;
+        result->interactionsReached = countSimInteractions(sim, &total);
+        result->nodesReached = countSimNodes(sim, &total);
+        result->playerX = game->player.x;
+        result->playerY = game->player.y;
+        result->randomState = game->randomState;
+    }
+    else{
+        reportSimulation(sim, tick, seconds, reason);
+    }
+
+    cancelPendingEvent(game);
+    resetPrefetch(game);
+    freeAnimations(game->world.animations, game->world.animationCount);
+    MEM_FREE(sim);
+    return 0;
+}
+
+typedef struct SimThread{
+    const char *scriptPath;
+    int tickLimit;
+    int status;
+    SimResult result;
+} SimThread;
+
+static int simulationThread(void *data){
+    SimThread *thread = (SimThread *)data;
+    thread->status = runSimulation(thread->scriptPath, thread->tickLimit, &thread->result);
+    return 0;
+}
+
+static SDL_bool isSameSimResult(const SimResult *a, const SimResult *b){
+    return a->ticks == b->ticks && a->interactionsReached == b->interactionsReached && a->nodesReached == b->nodesReached &&
+           a->playerX == b->playerX && a->playerY == b->playerY && a->randomState == b->randomState;
+}
+
+// --simthreads=N: 같은 시뮬레이션을 GameContext N개로 스레드마다 동시에 돌림
+// 컨텍스트끼리 상태를 나눠 쓰지 않으므로 스레드 수나 실행 순서와 상관없이 결과가 전부 같아야 함 (다르면 실패)
+int runParallelSimulations(const char *scriptPath, int tickLimit, int threadCount){
+    SimThread threads[MAX_SIM_THREADS];
+    SDL_Thread *handles[MAX_SIM_THREADS];
+    if(threadCount > MAX_SIM_THREADS) threadCount = MAX_SIM_THREADS;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for(int i = 0; i < threadCount; i++){
+        threads[i] = (SimThread){ scriptPath, tickLimit, 1, { 0 } };
+        char name[16];
+        snprintf(name, sizeof(name), "Simulation%d", i);
+        handles[i] = SDL_CreateThread(simulationThread, name, &threads[i]);
+        if(handles[i] == NULL){
+            LOG_ERROR(LOG_CORE, "Failed to create simulation thread %d, running it here: %s", i, SDL_GetError());
+            simulationThread(&threads[i]);
+        }
+    }
+    for(int i = 0; i < threadCount; i++){
+        if(handles[i] != NULL) SDL_WaitThread(handles[i], NULL);
+    }
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    if(seconds <= 0.0) seconds = 1e-9;
+
+    int status = 0;
+    Uint64 totalTicks = 0;
+    for(int i = 0; i < threadCount; i++){
+        SimResult *result = &threads[i].result;
+        if(threads[i].status != 0){
+            LOG_ERROR(LOG_CORE, "Simulation thread %d failed", i);
+            status = 1;
+            continue;
+        }
+        LOG_INFO(LOG_CORE, "Simulation thread %d: %llu ticks in %.2f s, interactions %d, nodes %d, player (%.2f, %.2f)", i,
+                 (unsigned long long)result->ticks, result->seconds, result->interactionsReached, result->nodesReached,
+                 result->playerX, result->playerY);
+        if(threads[0].status == 0 && !isSameSimResult(result, &threads[0].result)){
+            LOG_ERROR(LOG_CORE, "Simulation thread %d diverged from thread 0", i);
+            status = 1;
+        }
+        totalTicks += result->ticks;
+    }
+    LOG_INFO(LOG_CORE, "Parallel simulation: %d contexts, %llu ticks in %.2f s, %.0f ticks/s total", threadCount,
+             (unsigned long long)totalTicks, seconds, totalTicks / seconds);
+    return status;
+}
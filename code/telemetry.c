@@ -0,0 +1,206 @@
+#include "global.h"
+#include "telemetryFormat.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 라이브 텔레메트리 (실행 인자 --telemetry, --telemetrysocket[=경로])
+// TELEMETRY_INTERVAL마다 카운터를 모아 공유 메모리의 TelemetryBlock에 덮어씀 (tools/telemetryReader.c로 확인)
+// 소켓을 켜면 연결이 올 때마다 마지막 블록 하나를 보내고 끊음
+// 잠금 없이 sequence로만 맞추고 소켓도 논블로킹이라 프레임을 막지 않음
+#define TELEMETRY_INTERVAL 100  // 게시 주기 (ms)
+
+SDL_bool telemetryEnabled = SDL_FALSE;
+char telemetrySocketPath[108] = "";  // 비어 있으면 소켓 없음
+
+TelemetryBlock *telemetryBlock = NULL;  // 공유 메모리 (열지 못하면 로컬 블록)
+TelemetryBlock telemetryLocal;
+Uint32 telemetryLastPublish = 0;
+Uint64 telemetryFrame = 0;
+
+// 게시 사이의 프레임 시간 누적
+Uint64 telemetryFrameStart = 0;
+double telemetryFrameSum = 0.0;
+float telemetryFrameMax = 0.0f;
+int telemetryFrameCount = 0;
+
+#ifdef _WIN32
+HANDLE telemetryMapping = NULL;
+#else
+int telemetryListenSocket = -1;
+#endif
+
+static void openTelemetryShm(){
+#ifdef _WIN32
+    telemetryMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(TelemetryBlock), "Local\\sdl2dc_telemetry");
+    if(telemetryMapping != NULL){
+        telemetryBlock = MapViewOfFile(telemetryMapping, FILE_MAP_WRITE, 0, 0, sizeof(TelemetryBlock));
+    }
+#else
+    int file = shm_open(TELEMETRY_SHM_NAME, O_CREAT | O_RDWR, 0644);
+    if(file != -1){
+        if(ftruncate(file, sizeof(TelemetryBlock)) == 0){
+            void *data = mmap(NULL, sizeof(TelemetryBlock), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            telemetryBlock = data != MAP_FAILED ? data : NULL;
+        }
+        close(file); // 매핑은 닫아도 유지됨
+    }
+#endif
+    if(telemetryBlock == NULL){
+        LOG_WARN(LOG_CORE, "Failed to open telemetry shared memory, publishing to socket only");
+        telemetryBlock = &telemetryLocal;
+    }
+}
+
+static void openTelemetrySocket(){
+#ifndef _WIN32
+    if(telemetrySocketPath[0] == '\0') return;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", telemetrySocketPath);
+    unlink(telemetrySocketPath); // 지난번 실행이 남긴 소켓 파일
+
+    telemetryListenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(telemetryListenSocket == -1 ||
+       bind(telemetryListenSocket, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+       listen(telemetryListenSocket, 4) != 0){
+        LOG_WARN(LOG_CORE, "Failed to open telemetry socket %s", telemetrySocketPath);
+        if(telemetryListenSocket != -1) close(telemetryListenSocket);
+        telemetryListenSocket = -1;
+        return;
+    }
+    fcntl(telemetryListenSocket, F_SETFL, fcntl(telemetryListenSocket, F_GETFL) | O_NONBLOCK);
+    LOG_INFO(LOG_CORE, "Telemetry socket: %s", telemetrySocketPath);
+#else
+    if(telemetrySocketPath[0] != '\0'){
+        LOG_WARN(LOG_CORE, "Telemetry socket is not supported on Windows, shared memory only");
+    }
+#endif
+}
+
+void initTelemetry(){
+    if(!telemetryEnabled) return;
+    openTelemetryShm();
+    openTelemetrySocket();
+
+    memset(telemetryBlock, 0, sizeof(TelemetryBlock));
+    telemetryBlock->magic = TELEMETRY_MAGIC;
+    telemetryBlock->version = TELEMETRY_VERSION;
+    telemetryBlock->size = sizeof(TelemetryBlock);
+#ifdef _WIN32
+    telemetryBlock->processId = (uint32_t)GetCurrentProcessId();
+#else
+    telemetryBlock->processId = (uint32_t)getpid();
+#endif
+    telemetryFrameStart = SDL_GetPerformanceCounter();
+    LOG_INFO(LOG_CORE, "Telemetry publishing every %d ms", TELEMETRY_INTERVAL);
+}
+
+// 대기 중인 연결에 마지막 블록을 보내고 끊음 (보낼 수 없으면 버림)
+static void serveTelemetrySnapshots(){
+#ifndef _WIN32
+    if(telemetryListenSocket == -1) return;
+
+    int client;
+    while((client = accept(telemetryListenSocket, NULL, NULL)) != -1){
+        fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+        TelemetryBlock snapshot = *telemetryBlock; // 게시 직후에만 불리므로 sequence는 짝수
+#ifdef MSG_NOSIGNAL
+        send(client, &snapshot, sizeof(snapshot), MSG_NOSIGNAL);
+#else
+        send(client, &snapshot, sizeof(snapshot), 0);
+#endif
+        close(client);
+    }
+#endif
+}
+
+static void publishTelemetry(GameContext *game){
+    TelemetryBlock *block = telemetryBlock;
+    block->sequence++;            // 홀수: 쓰는 중
+    SDL_MemoryBarrierRelease();   // 다른 프로세스가 홀수를 보기 전에 내용이 바뀌지 않도록 (약한 메모리 순서 CPU 포함)
+
+    block->uptime = SDL_GetTicks();
+    block->frame = telemetryFrame;
+    block->frameTimeAverage = telemetryFrameCount > 0 ? (float)(telemetryFrameSum / telemetryFrameCount) : 0.0f;
+    block->frameTimeMax = telemetryFrameMax;
+    block->fps = fps;
+    block->hitchCount = (uint32_t)hitchCount;
+
+    block->memoryLiveTotal = 0;
+    for(int i = 0; i < MEM_TAG_COUNT && i < TELEMETRY_MEMORY_TAGS; i++){
+        block->memoryLive[i] = (uint32_t)getMemoryLiveBytes(i);
+        block->memoryLiveTotal += block->memoryLive[i];
+    }
+
+    block->loadedMaps = (uint32_t)currentMapCount;
+    block->platformCount = (uint32_t)platformCount;
+    block->interactionCount = (uint32_t)interactionCount;
+    block->entityCount = (uint32_t)game->world.entities.count;
+
+    block->activeVoices = (uint32_t)Mix_Playing(-1);
+    block->voicesDropped = (uint32_t)voicesDropped;
+    block->voicesStolen = (uint32_t)voicesStolen;
+    block->soundCacheBytes = (uint32_t)soundCacheBytes;
+    block->soundLatency = getSoundLatency();
+
+    getAssetCounts((int *)&block->assetsResident, (int *)&block->assetsPending);
+    block->prefetchHits = (uint32_t)game->world.prefetch.hits;
+    block->prefetchLate = (uint32_t)game->world.prefetch.late;
+    block->prefetchMisses = (uint32_t)game->world.prefetch.misses;
+    block->inputLatencyAverage = game->input.latencyAverage;
+
+    SDL_MemoryBarrierRelease();   // 내용을 다 쓴 뒤에 짝수가 보이도록
+    block->sequence++;            // 짝수: 읽어도 됨
+}
+
+// 프레임 끝에서 호출
+void updateTelemetry(GameContext *game){
+    if(!telemetryEnabled) return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    float frameTime = (float)((now - telemetryFrameStart) * 1000.0 / SDL_GetPerformanceFrequency());
+    telemetryFrameStart = now;
+    telemetryFrameSum += frameTime;
+    if(frameTime > telemetryFrameMax) telemetryFrameMax = frameTime;
+    telemetryFrameCount++;
+    telemetryFrame++;
+
+    Uint32 ticks = SDL_GetTicks();
+    if(ticks - telemetryLastPublish < TELEMETRY_INTERVAL) return;
+    telemetryLastPublish = ticks;
+
+    publishTelemetry(game);
+    telemetryFrameSum = 0.0;
+    telemetryFrameMax = 0.0f;
+    telemetryFrameCount = 0;
+    serveTelemetrySnapshots();
+}
+
+void shutdownTelemetry(){
+    if(!telemetryEnabled) return;
+#ifdef _WIN32
+    if(telemetryBlock != &telemetryLocal && telemetryBlock != NULL) UnmapViewOfFile(telemetryBlock);
+    if(telemetryMapping != NULL) CloseHandle(telemetryMapping);
+    telemetryMapping = NULL;
+#else
+    if(telemetryBlock != &telemetryLocal && telemetryBlock != NULL){
+        munmap(telemetryBlock, sizeof(TelemetryBlock));
+        shm_unlink(TELEMETRY_SHM_NAME);
+    }
+    if(telemetryListenSocket != -1){
+        close(telemetryListenSocket);
+        unlink(telemetrySocketPath);
+    }
+    telemetryListenSocket = -1;
+#endif
+    telemetryBlock = NULL;
+}
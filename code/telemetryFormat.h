@@ -0,0 +1,58 @@
+#ifndef TELEMETRYFORMAT_H
+#define TELEMETRYFORMAT_H
+
+#include <stdint.h>
+
+// 라이브 텔레메트리 블록 형식 (게임의 telemetry.c와 tools/telemetryReader.c가 같이 씀)
+// 게임이 공유 메모리(TELEMETRY_SHM_NAME)에 주기적으로 덮어쓰고, 소켓으로 연결하면 같은 블록 하나를 보내고 끊음
+// 쓰는 동안 sequence가 홀수, 다 쓰면 짝수 (읽는 쪽은 앞뒤 sequence가 같고 짝수일 때까지 다시 읽음)
+// 필드를 추가하면 TELEMETRY_VERSION을 올리고 뒤에만 붙일 것
+#define TELEMETRY_MAGIC 0x4D4C4454u   // "TDLM"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_SHM_NAME "/sdl2dc_telemetry"             // POSIX shm_open 이름 (Windows는 Local\\sdl2dc_telemetry)
+#define TELEMETRY_SOCKET_PATH "/tmp/sdl2dc_telemetry.sock" // 기본 소켓 경로
+#define TELEMETRY_MEMORY_TAGS 8       // MemoryTag 수 이상
+
+typedef struct TelemetryBlock{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                // sizeof(TelemetryBlock)
+    volatile uint32_t sequence;
+    uint32_t processId;
+    uint32_t uptime;              // ms
+    uint64_t frame;
+
+    // 프레임 (직전 게시 이후 구간)
+    float frameTimeAverage;       // ms
+    float frameTimeMax;
+    float fps;
+    uint32_t hitchCount;          // 누적
+
+    // 메모리 (memory.c 분야별 살아있는 바이트)
+    uint32_t memoryLive[TELEMETRY_MEMORY_TAGS];
+    uint32_t memoryLiveTotal;
+
+    // 월드
+    uint32_t loadedMaps;
+    uint32_t platformCount;
+    uint32_t interactionCount;
+    uint32_t entityCount;
+
+    // 오디오
+    uint32_t activeVoices;
+    uint32_t voicesDropped;
+    uint32_t voicesStolen;
+    uint32_t soundCacheBytes;
+    float soundLatency;           // ms
+
+    // 에셋
+    uint32_t assetsResident;
+    uint32_t assetsPending;
+    uint32_t prefetchHits;
+    uint32_t prefetchLate;
+    uint32_t prefetchMisses;
+
+    float inputLatencyAverage;    // ms
+} TelemetryBlock;
+
+#endif // TELEMETRYFORMAT_H
@@ -2,13 +2,16 @@
 #include <cJSON.h>
 #include <stdio.h>
 
+int currentParsingMap = 0;
+SDL_bool isReloadingMap = SDL_FALSE;
+int droppedWorldObjects = 0; // 상한에 걸려 버리거나 잘린 플랫폼 / 다각형 / 상호작용 / NPC 배치 지점 수 (buildWorld마다 다시 셈)
+
 unsigned char *base64_decode(const char *input, size_t len, size_t *out_len){
     static const unsigned char base64_table[65] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     
     unsigned char dtable[256], *out, *pos, block[4], tmp;
     size_t i, count, olen;
-    int pad = 0;
     
     memset(dtable, 0x80, 256);
     for(i = 0; i < 64; i++)
@@ -25,7 +28,7 @@ unsigned char *base64_decode(const char *input, size_t len, size_t *out_len){
         return NULL;
     
     olen = count / 4 * 3;
-    pos = out = (unsigned char *)malloc(olen);
+    pos = out = (unsigned char *)MEM_ALLOC(MEM_MAP, olen);
     if (out == NULL)
         return NULL;
     
@@ -67,17 +70,49 @@ void parseTileLayer(cJSON *layer){
     unsigned char *decodedData = base64_decode(encodedData, strlen(encodedData), &decodedLength);
 
     if(decodedData == NULL){
-        printf("Error decoding base64 tile data\n");
+        LOG_ERROR(LOG_MAP, "Error decoding base64 tile data");
         return;
     }
 
     // 타일 데이터를 처리하는 코드
     for(size_t i = 0; i < decodedLength / 4; i++){  // 타일 데이터는 4바이트씩 처리됩니다.
         unsigned int tileID = ((unsigned int*)decodedData)[i];  // 타일 ID 가져오기
-        printf("Tile %zu: %u\n", i, tileID);
+        LOG_DEBUG(LOG_MAP, "Tile %zu: %u", i, tileID);
     }
 
-    free(decodedData);  // 디코딩된 데이터를 메모리에서 해제
+    MEM_FREE(decodedData);  // 디코딩된 데이터를 메모리에서 해제
+}
+
+// 맵 크기, 타일 크기, 맵 속성(music) 읽기, 형식이 틀리면 SDL_FALSE
+SDL_bool parseMapHeader(Map *map){
+    cJSON *width = cJSON_GetObjectItem(map->mapJson, "width");
+    cJSON *height = cJSON_GetObjectItem(map->mapJson, "height");
+    cJSON *tileWidthItem = cJSON_GetObjectItem(map->mapJson, "tilewidth");
+    cJSON *tileHeightItem = cJSON_GetObjectItem(map->mapJson, "tileheight");
+
+    if(!cJSON_IsNumber(width) || !cJSON_IsNumber(height) ||
+        !cJSON_IsNumber(tileWidthItem) || !cJSON_IsNumber(tileHeightItem)){
+        return SDL_FALSE;
+    }
+
+    map->mapWidth = width->valueint;
+    map->mapHeight = height->valueint;
+    map->tileWidth = tileWidthItem->valueint;
+    map->tileHeight = tileHeightItem->valueint;
+
+    // 맵 속성 music (배경음악 경로)
+    map->music[0] = '\0';
+    cJSON *mapProperties = cJSON_GetObjectItem(map->mapJson, "properties");
+    for(int k = 0; k < cJSON_GetArraySize(mapProperties); k++){
+        cJSON *property = cJSON_GetArrayItem(mapProperties, k);
+        cJSON *propName = cJSON_GetObjectItem(property, "name");
+        cJSON *propValue = cJSON_GetObjectItem(property, "value");
+        if(cJSON_IsString(propName) && cJSON_IsString(propValue) && strcmp(propName->valuestring, "music") == 0){
+            strncpy(map->music, propValue->valuestring, sizeof(map->music) - 1);
+            map->music[sizeof(map->music) - 1] = '\0';
+        }
+    }
+    return SDL_TRUE;
 }
 
 // JSON에서 맵 데이터를 파싱하는 함수
@@ -85,7 +120,7 @@ void parseTileLayer(cJSON *layer){
 unsigned int *parseTileData(Map *map){
     map->layers = cJSON_GetObjectItem(map->mapJson, "layers");
     if(!cJSON_IsArray(map->layers)){
-        printf("Error: No layers in map\n");
+        LOG_ERROR(LOG_MAP, "Error: No layers in map");
         return NULL;
     }
 
@@ -101,14 +136,14 @@ unsigned int *parseTileData(Map *map){
     }
 
     if(tileLayer == NULL){
-        printf("Error: No tile layer found\n");
+        LOG_ERROR(LOG_MAP, "Error: No tile layer found");
         return NULL;
     }
 
     // Base64 인코딩된 타일 데이터 추출
     cJSON *dataItem = cJSON_GetObjectItem(tileLayer, "data");
     if(!cJSON_IsString(dataItem)){
-        printf("Error: Tile layer data is not a string\n");
+        LOG_ERROR(LOG_MAP, "Error: Tile layer data is not a string");
         return NULL;
     }
 
@@ -116,16 +151,16 @@ unsigned int *parseTileData(Map *map){
     size_t decodedLength;
     unsigned char *decodedData = base64_decode(encodedData, strlen(encodedData), &decodedLength);
     if(decodedData == NULL){
-        printf("Error decoding base64 tile data\n");
+        LOG_ERROR(LOG_MAP, "Error decoding base64 tile data");
         return NULL;
     }
 
     // 타일 ID로 변환
     size_t numTiles = decodedLength / 4;  // 각 타일이 4바이트
-    map->tileData = (unsigned int *)malloc(numTiles * sizeof(unsigned int));
+    map->tileData = (unsigned int *)MEM_ALLOC(MEM_MAP, numTiles * sizeof(unsigned int));
     if(map->tileData == NULL){
-        free(decodedData);
-        printf("Error allocating memory for tile data\n");
+        MEM_FREE(decodedData);
+        LOG_ERROR(LOG_MAP, "Error allocating memory for tile data");
         return NULL;
     }
 
@@ -134,14 +169,14 @@ unsigned int *parseTileData(Map *map){
         map->tileData[i] = ((unsigned int *)decodedData)[i];
     }
 
-    free(decodedData);  // 디코딩 데이터 메모리 해제
+    MEM_FREE(decodedData);  // 디코딩 데이터 메모리 해제
     return map->tileData;  // map->tileData 반환
 }
 
 void parseObjectGroup(Map *map, cJSON *objectGroup, int xOffset, int yOffset){
     cJSON *objects = cJSON_GetObjectItem(objectGroup, "objects");
     if(!cJSON_IsArray(objects)){
-        printf("Error: No objects in object group\n");
+        LOG_ERROR(LOG_MAP, "Error: No objects in object group");
         return;
     }
 
@@ -153,78 +188,131 @@ void parseObjectGroup(Map *map, cJSON *objectGroup, int xOffset, int yOffset){
         cJSON *width = cJSON_GetObjectItem(object, "width");
         cJSON *height = cJSON_GetObjectItem(object, "height");
         cJSON *name = cJSON_GetObjectItem(object, "name");
+        if(!cJSON_IsString(name)) name = NULL; // 이름이 없거나 문자열이 아니면 이름 없는 오브젝트로 취급
         cJSON *properties = cJSON_GetObjectItem(object, "properties");
 
         if(cJSON_IsNumber(x) && cJSON_IsNumber(y) && cJSON_IsNumber(width) && cJSON_IsNumber(height)){
             float objectX = x->valuedouble + xOffset;
             float objectY = y->valuedouble + yOffset;
-            printf("Object %s - x: %.3f, y: %.3f, width: %.3f, height: %.3f\n",
+            LOG_DEBUG(LOG_MAP, "Object %s - x: %.3f, y: %.3f, width: %.3f, height: %.3f",
                    name ? name->valuestring : "Unnamed",
                    x->valuedouble, y->valuedouble, width->valuedouble, height->valuedouble);
 
+            // 상호작용 속성은 다음에 추가될 칸에 미리 써 두므로 배열이 가득 차면 건너뜀 (addInteraction이 버린 수를 셈)
+            SDL_bool hasInteractionSlot = interactionCount < MAX_INTERACTIONS;
             if(cJSON_IsArray(properties)){
                 for(int k = 0; k < cJSON_GetArraySize(properties); k++){
                     cJSON *property = cJSON_GetArrayItem(properties, k);
                     cJSON *propName = cJSON_GetObjectItem(property, "name");
                     cJSON *propValue = cJSON_GetObjectItem(property, "value");
+                    if(!cJSON_IsString(propName)) continue;
 
                     if(strcmp(propName->valuestring, "Text") == 0){
+                        if(!hasInteractionSlot) continue;
                         // interaction 객체를 찾기 전에 해당 인덱스를 확인합니다.
                         // interactions 배열에서 상호작용에 맞는 객체를 찾아서 텍스트 할당
                         if(interactions[interactionCount].propertyText != NULL){
-                            free(interactions[interactionCount].propertyText);  // 기존 메모리 해제
+                            MEM_FREE(interactions[interactionCount].propertyText);  // 기존 메모리 해제
                         }
 
                         // 특정 interaction 객체에 텍스트를 저장합니다.
-                        interactions[interactionCount].propertyText = strdup(propValue->valuestring);
+                        interactions[interactionCount].propertyText = MEM_STRDUP(MEM_TEXT, propValue->valuestring);
                         
-                        printf("Loaded text: %s\n", interactions[interactionCount].propertyText);
+                        LOG_DEBUG(LOG_MAP, "Loaded text: %s", interactions[interactionCount].propertyText);
                     }
                     else if(strcmp(propName->valuestring, "SE") == 0){
+                        if(!hasInteractionSlot) continue;
                         if(interactions[interactionCount].SE != NULL){
-                            free(interactions[interactionCount].SE);
+                            MEM_FREE(interactions[interactionCount].SE);
                         }
 
-                        interactions[interactionCount].SE = strdup(propValue->valuestring);
+                        interactions[interactionCount].SE = MEM_STRDUP(MEM_TEXT, propValue->valuestring);
+                        interactions[interactionCount].seID = findSound(propValue->valuestring);
 
-                        printf("Loaded SE: %s\n", interactions[interactionCount].SE);
+                        LOG_DEBUG(LOG_MAP, "Loaded SE: %s", interactions[interactionCount].SE);
                     }
                     else if(propName && cJSON_IsString(propName) && propValue && cJSON_IsNumber(propValue)){
                         if(strcmp(propName->valuestring, "eventID") != 0){
-                            // Shop items 배열에 구매 제한 속성 저장
-                            strncpy(items[itemCount].name, propName->valuestring, sizeof(items[itemCount].name) - 1);
-                            items[itemCount].name[sizeof(items[itemCount].name) - 1] = '\0';  // Null-terminate
-                            items[itemCount].value = propValue->valueint;
-                            items[itemCount].stock = propValue->valueint;
-
-                            printf("Loaded property: %s = %d\n", items[itemCount].name, items[itemCount].value);
-                            printf("item stock has been saved: %s = %d\n", items[itemCount].name, items[itemCount].stock);
-                            itemCount++;
+                            // 이미 있는 아이템이면 (핫 리로드) 가격만 갱신, 재고는 유지
+                            int existing = -1;
+                            for(int item = 0; item < shopCatalogCount; item++){
+                                if(strcmp(shopCatalog[item].name, propName->valuestring) == 0) existing = item;
+                            }
+                            if(existing != -1){
+                                shopCatalog[existing].value = propValue->valueint;
+                                continue;
+                            }
+                            if(shopCatalogCount >= MAX_SHOP_ITEMS) continue;
+
+                            // 상점 목록에 구매 제한 속성 저장 (판마다 initGameContext에서 복사해 재고를 따로 셈)
+                            Shop *catalogItem = &shopCatalog[shopCatalogCount];
+                            strncpy(catalogItem->name, propName->valuestring, sizeof(catalogItem->name) - 1);
+                            catalogItem->name[sizeof(catalogItem->name) - 1] = '\0';  // Null-terminate
+                            catalogItem->value = propValue->valueint;
+                            catalogItem->stock = propValue->valueint;
+
+                            LOG_DEBUG(LOG_MAP, "Loaded property: %s = %d", catalogItem->name, catalogItem->value);
+                            LOG_DEBUG(LOG_MAP, "item stock has been saved: %s = %d", catalogItem->name, catalogItem->stock);
+                            shopCatalogCount++;
                         }
-                        else if(strcmp(propName->valuestring, "eventID") == 0){
+                        else if(strcmp(propName->valuestring, "eventID") == 0 && hasInteractionSlot){
                             // 특정 interaction 객체에 eventID를 저장
                             interactions[interactionCount].eventID = propValue->valueint;
-                            printf("Loaded eventID: %d for interaction: %s\n", interactions[interactionCount].eventID, interactions[interactionCount].name);
+                            LOG_DEBUG(LOG_MAP, "Loaded eventID: %d for interaction: %s", interactions[interactionCount].eventID, interactions[interactionCount].name);
                         }
                     }
                 }
             }
 
+            // 다각형/폴리라인 오브젝트 (경사로 등), 점 좌표는 오브젝트 x, y 기준 상대 좌표
+            cJSON *polygon = cJSON_GetObjectItem(object, "polygon");
+            cJSON *polyline = cJSON_GetObjectItem(object, "polyline");
+            cJSON *shape = cJSON_IsArray(polygon) ? polygon : polyline;
+            if(name != NULL && cJSON_IsArray(shape) &&
+               (strcmp(name->valuestring, "floor") == 0 || strcmp(name->valuestring, "wall") == 0 || strcmp(name->valuestring, "slope") == 0)){
+                float pointsX[MAX_SHAPE_POINTS], pointsY[MAX_SHAPE_POINTS];
+                int pointCount = 0;
+                int droppedPoints = 0;
+                for(int k = 0; k < cJSON_GetArraySize(shape); k++){
+                    cJSON *point = cJSON_GetArrayItem(shape, k);
+                    cJSON *pointX = cJSON_GetObjectItem(point, "x");
+                    cJSON *pointY = cJSON_GetObjectItem(point, "y");
+                    if(!cJSON_IsNumber(pointX) || !cJSON_IsNumber(pointY)) continue;
+                    if(pointCount >= MAX_SHAPE_POINTS){
+                        droppedPoints++;
+                        continue;
+                    }
+                    pointsX[pointCount] = objectX + pointX->valuedouble;
+                    pointsY[pointCount] = objectY + pointY->valuedouble;
+                    pointCount++;
+                }
+                if(droppedPoints > 0){
+                    // 잘린 다각형은 모양이 달라지므로 상한에 걸린 오브젝트로 셈
+                    LOG_WARN(LOG_MAP, "%s shape at (%.0f, %.0f) has more than %d points, %d dropped",
+                             name->valuestring, objectX, objectY, MAX_SHAPE_POINTS, droppedPoints);
+                    droppedWorldObjects++;
+                }
+                addPolygonPlatform(pointsX, pointsY, pointCount, shape == polyline);
+                continue;
+            }
+
             if(name != NULL){
                 SDL_Rect newInteraction = { objectX, objectY, width->valuedouble, height->valuedouble };
                 if(strcmp(name->valuestring, "floor") == 0 || strcmp(name->valuestring, "wall") == 0){
                     addPlatform(newInteraction);
                 }
-                else if(strcmp(name->valuestring, "roofDoor") == 0 || strcmp(name->valuestring, "blockedDoor") == 0 || 
-                        strcmp(name->valuestring, "elevator") == 0 || strcmp(name->valuestring, "1F-3F") == 0 || 
-                        strcmp(name->valuestring, "3F-4F") == 0 ||
-                        strcmp(name->valuestring, "4F-roofF") == 0 || strcmp(name->valuestring, "1F-outDoor") == 0 ||
-                        strcmp(name->valuestring, "otherWay") == 0 || strcmp(name->valuestring, "NotElevator") == 0 ||
-                        strcmp(name->valuestring, "wrongWay") == 0 || strcmp(name->valuestring, "frontDoor") == 0 ||
-                        strcmp(name->valuestring, "bathRoom") == 0 ||
-                        strcmp(name->valuestring, "pyeonUijeom") == 0 || strcmp(name->valuestring, "buy") == 0 || strcmp(name->valuestring, "jinYeoldae") == 0 ||
-                        strcmp(name->valuestring, "frige") == 0 || strcmp(name->valuestring, "bed") == 0 || strcmp(name->valuestring, "toDo") == 0 ||
-                        strcmp(name->valuestring, "Toilet") == 0 ||strcmp(name->valuestring, "Washstand") == 0 || strcmp(name->valuestring, "Washtub") == 0){
+                else if(strcmp(name->valuestring, "npc") == 0 && !isReloadingMap){
+                    if(npcSpawnCount < MAX_NPC_SPAWNS){
+                        // NPC 배치 지점 (발 위치 기준, 72x72 NPC의 왼쪽 위 좌표로 저장해 두고 initGameContext에서 생성)
+                        npcSpawnPoints[npcSpawnCount].x = objectX * 3;
+                        npcSpawnPoints[npcSpawnCount].y = (objectY + height->valuedouble) * 3 - 72;
+                        npcSpawnCount++;
+                    }
+                    else{
+                        droppedWorldObjects++;
+                    }
+                }
+                else if(classifyInteraction(name->valuestring) != INTERACTION_NONE){
                     addInteraction(newInteraction, name->valuestring);
                 }
             }
@@ -236,7 +324,7 @@ void parseObjectGroup(Map *map, cJSON *objectGroup, int xOffset, int yOffset){
 void parseObjectGroups(Map *map, int xOffset, int yOffset){
     cJSON *layers = cJSON_GetObjectItem(map->mapJson, "layers");
     if(!cJSON_IsArray(layers)){
-        printf("Error: No layers in map\n");
+        LOG_ERROR(LOG_MAP, "Error: No layers in map");
         return;
     }
 
@@ -245,7 +333,7 @@ void parseObjectGroups(Map *map, int xOffset, int yOffset){
         cJSON *layer = cJSON_GetArrayItem(layers, i);
         cJSON *layerType = cJSON_GetObjectItem(layer, "type");
         if(cJSON_IsString(layerType) && strcmp(layerType->valuestring, "objectgroup") == 0){
-            printf("Parsing objectgroup layer: %s\n", cJSON_GetObjectItem(layer, "name")->valuestring);
+            LOG_DEBUG(LOG_MAP, "Parsing objectgroup layer: %s", cJSON_GetObjectItem(layer, "name")->valuestring);
             parseObjectGroup(map, layer, xOffset, yOffset);
         }
     }
@@ -253,69 +341,101 @@ void parseObjectGroups(Map *map, int xOffset, int yOffset){
 
 void addPlatform(SDL_Rect platform){
     // 최대 플랫폼 수를 초과하지 않도록 체크
-    if (platformCount < 100) {
+    if (platformCount < MAX_PLATFORMCOUNT) {
         platforms[platformCount].x = platform.x * 3;
         platforms[platformCount].y = platform.y * 3;
         platforms[platformCount].width = platform.w * 3;  // 너비를 3배로 증가
         platforms[platformCount].height = platform.h * 3; // 높이를 3배로 증가
+        platforms[platformCount].pointCount = 0;          // 사각형 플랫폼
+        platforms[platformCount].mapIndex = currentParsingMap;
         platformCount++; // 플랫폼 수 증가
-        printf("Added platform: x=%.2f, y=%.2f, width=%.2f, height=%.2f\n", 
+        LOG_DEBUG(LOG_MAP, "Added platform: x=%.2f, y=%.2f, width=%.2f, height=%.2f", 
             platforms[platformCount - 1].x, platforms[platformCount - 1].y, 
             platforms[platformCount - 1].width, platforms[platformCount - 1].height);
     } else {
-        printf("Maximum platform limit reached.\n");
+        LOG_WARN(LOG_MAP, "Maximum platform limit reached.");
+        droppedWorldObjects++;
     }
 }
 
-/* 이 함수는 머리가 아픈 이슈로 유기
-void addPolygonPlatform(SDL_Point* points, int pointCount, SDL_Rect baseRect) {
-    if(platformCount < 100){
-        int minX = points[0].x, maxX = points[0].x;
-        int minY = points[0].y, maxY = points[0].y;
-
-        // 다각형의 최소/최대 x, y 계산
-        for(int i = 1; i < pointCount; i++){
-            if (points[i].x < minX) minX = points[i].x;
-            if (points[i].x > maxX) maxX = points[i].x;
-            if (points[i].y < minY) minY = points[i].y;
-            if (points[i].y > maxY) maxY = points[i].y;
-        }
+// 다각형(경사로) 플랫폼 추가, 볼록 조각으로 나눠서 저장
+// 폴리라인은 선분 하나하나를 조각으로 저장
+void addPolygonPlatform(const float *pointsX, const float *pointsY, int pointCount, SDL_bool isPolyline){
+    float scaledX[MAX_SHAPE_POINTS], scaledY[MAX_SHAPE_POINTS];
+    if(pointCount < 2 || pointCount > MAX_SHAPE_POINTS) return;
 
-        // 기준 rect의 x, y 오프셋을 추가하여 실제 위치 계산
-        platforms[platformCount].x = (baseRect.x) * 3;  // 3배 확대
-        platforms[platformCount].y = (baseRect.y + minY) * 3;
-        platforms[platformCount].width = (maxX - minX) * 3;  // 폭 계산
-        platforms[platformCount].height = (maxY - minY) * 3;  // 높이 계산
-        platformCount++;
+    for(int i = 0; i < pointCount; i++){
+        scaledX[i] = pointsX[i] * 3; // 3배 확대
+        scaledY[i] = pointsY[i] * 3;
+    }
 
-        // 디버그 출력
-        printf("Added polygon platform: x=%.2f, y=%.2f, width=%.2f, height=%.2f\n",
-               platforms[platformCount - 1].x, platforms[platformCount - 1].y,
-               platforms[platformCount - 1].width, platforms[platformCount - 1].height);
+    if(isPolyline){
+        for(int i = 0; i + 1 < pointCount; i++){
+            addConvexPlatform(&scaledX[i], &scaledY[i], 2);
+        }
     }
     else{
-        printf("Maximum platform limit reached.\n");
+        decomposePolygon(scaledX, scaledY, pointCount);
+    }
+}
+
+// 볼록 조각 하나를 플랫폼 배열에 추가 (좌표는 이미 3배 확대된 월드 좌표)
+void addConvexPlatform(const float *pointsX, const float *pointsY, int pointCount){
+    if(platformCount >= MAX_PLATFORMCOUNT){
+        LOG_WARN(LOG_MAP, "Maximum platform limit reached.");
+        droppedWorldObjects++;
+        return;
     }
+    if(pointCount < 2 || pointCount > MAX_POLYGON_POINTS) return;
+
+    Platform *platform = &platforms[platformCount];
+    float minX = pointsX[0], maxX = pointsX[0];
+    float minY = pointsY[0], maxY = pointsY[0];
+
+    // 다각형의 최소/최대 x, y 계산 (BVH와 스윕용 바운딩 박스)
+    for(int i = 0; i < pointCount; i++){
+        if (pointsX[i] < minX) minX = pointsX[i];
+        if (pointsX[i] > maxX) maxX = pointsX[i];
+        if (pointsY[i] < minY) minY = pointsY[i];
+        if (pointsY[i] > maxY) maxY = pointsY[i];
+        platform->polygon[i].x = (int)(pointsX[i] + 0.5f);
+        platform->polygon[i].y = (int)(pointsY[i] + 0.5f);
+    }
+
+    platform->x = minX;
+    platform->y = minY;
+    platform->width = maxX - minX;
+    platform->height = maxY - minY;
+    platform->pointCount = pointCount;
+    platform->mapIndex = currentParsingMap;
+    platformCount++;
+    polygonPlatformCount++;
+
+    // 디버그 출력
+    LOG_DEBUG(LOG_MAP, "Added polygon platform: %d points, bounds x=%.2f, y=%.2f, width=%.2f, height=%.2f",
+           pointCount, platform->x, platform->y, platform->width, platform->height);
 }
-*/
 
 void addInteraction(SDL_Rect interactionZone, const char* name){
     // 최대 상호작용 수를 초과하지 않도록 체크
-    if (interactionCount < 100) {
+    if (interactionCount < MAX_INTERACTIONS) {
         interactions[interactionCount].x = interactionZone.x * 3;
         interactions[interactionCount].y = interactionZone.y * 3;
         interactions[interactionCount].width = interactionZone.w * 3;  // 너비를 3배로 증가
         interactions[interactionCount].height = interactionZone.h * 3; // 높이를 3배로 증가
         
+        interactions[interactionCount].type = classifyInteraction(name);
+        interactions[interactionCount].mapIndex = currentParsingMap;
         strncpy(interactions[interactionCount].name, name, sizeof(interactions[interactionCount].name) - 1);
         interactions[interactionCount].name[sizeof(interactions[interactionCount].name) - 1] = '\0'; // 안전하게 문자열 종료// 안전하게 문자열 종료
         interactionCount++; // 상호작용 수 증가
-        printf("Added interaction: x=%.2f, y=%.2f, width=%.2f, height=%.2f\n", 
+        LOG_DEBUG(LOG_MAP, "Added interaction: x=%.2f, y=%.2f, width=%.2f, height=%.2f", 
            interactions[interactionCount - 1].x, interactions[interactionCount - 1].y, 
            interactions[interactionCount - 1].width, interactions[interactionCount - 1].height);
     }
     else {
-        printf("Maximum interaction limit reached.\n");
+        LOG_WARN(LOG_MAP, "Maximum interaction limit reached.");
+        droppedWorldObjects++;
     }
 }
 
@@ -324,6 +444,21 @@ int loadMapsFromDirectory(const char* directory, Map* maps, int maxMaps){
     struct dirent *entry;
     int mapCount = 0;
 
+    // 팩이 열려 있으면 팩 목차에서 directory/*.json을 찾음
+    if(isPackOpen()){
+        size_t prefixLength = strlen(directory);
+        for(int i = 0; i < getPackEntryCount() && mapCount < maxMaps; i++){
+            const char *path = getPackEntryPath(i);
+            if(strncmp(path, directory, prefixLength) != 0 || path[prefixLength] != '/' || strstr(path, ".json") == NULL) continue;
+
+            maps[mapCount].asset = requestAsset(path, ASSET_JSON);
+            maps[mapCount].mapJson = NULL;
+            strncpy(maps[mapCount].path, path, sizeof(maps[mapCount].path) - 1);
+            if(maps[mapCount].asset != ASSET_NONE) mapCount++;
+        }
+        return mapCount;
+    }
+
     // 디렉토리 열기
     if((dir = opendir(directory)) == NULL){
         perror("opendir() error");
@@ -333,150 +468,127 @@ int loadMapsFromDirectory(const char* directory, Map* maps, int maxMaps){
     while((entry = readdir(dir)) != NULL && mapCount < maxMaps){
         // .json 파일만 처리
         if(strstr(entry->d_name, ".json") != NULL){
-            char filePath[256];
-            snprintf(filePath, sizeof(filePath), "%s/%s", directory, entry->d_name);
-
-            // JSON 파일 읽기
-            char *jsonData = readFile(filePath);
-            if(jsonData == NULL){
-                printf("Error reading JSON file: %s\n", filePath);
+            char filePath[sizeof(maps[mapCount].path)];
+            if(snprintf(filePath, sizeof(filePath), "%s/%s", directory, entry->d_name) >= (int)sizeof(filePath)){
+                LOG_ERROR(LOG_MAP, "Map path is too long: %s/%s", directory, entry->d_name);
                 continue;
             }
 
-            // JSON 데이터 파싱
-            maps[mapCount].mapJson = cJSON_Parse(jsonData);
-            free(jsonData); // jsonData 메모리 해제
-            if(maps[mapCount].mapJson == NULL){
-                printf("Error parsing JSON file: %s\n", filePath);
+            // 읽기와 파싱은 에셋 로더가 처리, 준비되면 mapJson에 연결
+            maps[mapCount].asset = requestAsset(filePath, ASSET_JSON);
+            maps[mapCount].mapJson = NULL;
+            strcpy(maps[mapCount].path, filePath); // 길이는 위에서 확인
+            if(maps[mapCount].asset == ASSET_NONE){
+                LOG_ERROR(LOG_MAP, "Error requesting JSON file: %s", filePath);
                 continue;
             }
 
-            mapCount++; // 성공적으로 맵이 로드되면 증가
+            mapCount++;
         }
     }
     closedir(dir);
     return mapCount; // 불러온 맵의 개수 반환
 }
 
-// 각 프레임 이미지를 텍스처로 불러오는 함수
-int loadAnimationFrames(int eventID, SDL_Texture ***frames, SDL_Renderer *renderer){
-    // 파일 경로 구성 (예: \resource\eventID\1.png)
-    char filePath[256];
-    snprintf(filePath, sizeof(filePath), "resource/eventID/%d.png", eventID);
-
-    // 스프라이트 시트 불러오기
-    SDL_Surface *spriteSheet = IMG_Load(filePath);
-    if(!spriteSheet){
-        fprintf(stderr, "Failed to load sprite sheet: %s\n", IMG_GetError());
-        return 0;
-    }
-
-    // 프레임 정보 설정
-    const int frameWidth = 24;   // 각 프레임의 가로 크기
-    const int frameHeight = 24;  // 각 프레임의 세로 크기
-    const int totalWidth = spriteSheet->w; // 스프라이트 시트의 전체 가로 길이
-    const int frameCount = totalWidth / frameWidth; // 총 프레임 개수 계산
-
-    // 텍스처 배열 동적 할당
-    *frames = malloc(sizeof(SDL_Texture *) * frameCount);
-    if(!*frames){
-        fprintf(stderr, "Failed to allocate memory for frames.\n");
-        SDL_FreeSurface(spriteSheet);
-        return 0;
-    }
-
-    // 각 프레임을 텍스처로 변환
-    SDL_Rect srcRect = { 0, 0, frameWidth, frameHeight }; // 잘라낼 영역
-    for(int i = 0; i < frameCount; i++){
-        srcRect.x = i * frameWidth; // 현재 프레임의 x 좌표 설정
-
-        // 프레임 추출
-        SDL_Surface *frameSurface = SDL_CreateRGBSurface(0, frameWidth, frameHeight, 32, 
-                                                          0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
-        SDL_BlitSurface(spriteSheet, &srcRect, frameSurface, NULL); // 스프라이트 시트에서 프레임 추출
-
-        // SDL_Texture로 변환
-        (*frames)[i] = SDL_CreateTextureFromSurface(renderer, frameSurface);
-        SDL_FreeSurface(frameSurface);
-
-        if(!(*frames)[i]){
-            fprintf(stderr, "Failed to create texture for frame %d: %s\n", i, SDL_GetError());
-            for(int j = 0; j < i; j++){ // 이전에 할당된 텍스처 해제
-                SDL_DestroyTexture((*frames)[j]);
-            }
-            free(*frames);
-            SDL_FreeSurface(spriteSheet);
-            return 0;
+// 로더가 읽어 둔 맵 JSON으로 타일, 플랫폼, 상호작용을 만들고 검색 구조까지 구축 (창 모드와 시뮬레이션 공용)
+// 타일 데이터를 못 만들면 SDL_FALSE
+SDL_bool buildWorld(Map maps[], int mapCount){
+    int nextX = 0;
+    droppedWorldObjects = 0;
+    for(int i = 0; i < mapCount; i++){
+        maps[i].worldX = nextX;
+        nextX += MAP_STRIDE;
+        maps[i].mapJson = getAssetJson(maps[i].asset);
+        if(maps[i].mapJson == NULL){
+            LOG_ERROR(LOG_MAP, "Error parsing JSON for map %d", i);
+            continue;
         }
-        printf("Frame %d loaded successfully.\n", i); // 디버깅용 메시지
-    }
 
-    SDL_FreeSurface(spriteSheet); // 원본 스프라이트 시트 해제
-    return frameCount; // 총 프레임 수 반환
-}
+        // 맵 크기와 타일 크기 추출
+        if(!parseMapHeader(&maps[i])){
+            LOG_ERROR(LOG_MAP, "Error in map dimensions for map %d", i);
+            continue;
+        }
 
-// NPC 대화 데이터를 불러오는 함수
-void loadNPCDialogue(const char *fileName){
-    // 파일 경로 만들기
-    char filePath[256];
-    snprintf(filePath, sizeof(filePath), "resource/eventID/%s.json", fileName);
+        LOG_INFO(LOG_MAP, "Map %d - Width: %d, Height: %d, Tile Width: %d, Tile Height: %d",
+               i, maps[i].mapWidth, maps[i].mapHeight, maps[i].tileWidth, maps[i].tileHeight);
 
-    // 파일 읽기
-    FILE *file = fopen(filePath, "r");
-    if(file == NULL){
-        printf("Failed to open dialogue file %s\n", filePath);
-        return;
-    }
+        // 기본 간격보다 넓은 맵(스트레스 월드 등)은 옆 맵과 겹치지 않도록 그만큼 띄움
+        if(maps[i].mapWidth * maps[i].tileWidth > MAP_STRIDE){
+            nextX = maps[i].worldX + maps[i].mapWidth * maps[i].tileWidth;
+        }
 
-    // JSON 파싱
-    fseek(file, 0, SEEK_END);
-    long fileSize = ftell(file);
-    rewind(file);
+        int xOffset = maps[i].worldX; // 24x24 기준
+        int yOffset = 0;
+        currentParsingMap = i;
+        parseObjectGroups(&maps[i], xOffset, yOffset); // 오브젝트 그룹 초기화
+        // 타일 데이터 파싱
+        unsigned int *tileData = parseTileData(&maps[i]);
+        if(tileData == NULL){
+            LOG_ERROR(LOG_MAP, "Error parsing tile data");
+            return SDL_FALSE;
+        }
 
-    char *jsonData = (char *)malloc(fileSize + 1);
-    fread(jsonData, 1, fileSize, file);
-    jsonData[fileSize] = '\0';
+        /*
+        // 타일 데이터를 출력 (디버깅용)
+        for(int i = 0; i < maps[i].mapWidth * maps[i].mapHeight; i++){
+            LOG_DEBUG(LOG_CORE, "Tile %d: %u", i, tileData[i]);
+        }
+        */
+    }
+    if(droppedWorldObjects > 0){
+        LOG_WARN(LOG_MAP, "%d platforms / shapes / interactions / NPC spawns did not fit (MAX_PLATFORMCOUNT %d, MAX_SHAPE_POINTS %d, MAX_INTERACTIONS %d, MAX_NPC_SPAWNS %d)",
+                 droppedWorldObjects, MAX_PLATFORMCOUNT, MAX_SHAPE_POINTS, MAX_INTERACTIONS, MAX_NPC_SPAWNS);
+    }
+    // 모든 맵의 플랫폼이 모였으니 충돌 검색용 BVH 구축
+    buildPlatformBVH();
+    buildTriggerIndex();
+    return SDL_TRUE;
+}
 
-    // cJSON 라이브러리로 JSON 파싱
-    cJSON *root = cJSON_Parse(jsonData);
-    if(root == NULL){
-        printf("Failed to parse JSON\n");
-        free(jsonData);
-        fclose(file);
-        return;
+// 월드 x 좌표(3배 확대 후)가 속한 맵 인덱스 (맵 사이 빈 곳이면 왼쪽 맵)
+int findMapAt(float x){
+    int found = 0;
+    for(int i = 1; i < currentMapCount; i++){
+        if(maps[i].worldX * 3 <= x) found = i;
     }
+    return found;
+}
 
+// NPC 대화 데이터를 채우는 함수 (JSON은 에셋 로더가 미리 읽고 파싱해 둠)
+void parseNPCDialogue(DialogueText *dialogues, cJSON *root){
     // 필요한 데이터 가져오기
     cJSON *dialoguesArray = cJSON_GetObjectItem(root, "dialogues");
 
     for(int i = 0; i < cJSON_GetArraySize(dialoguesArray); i++){
         cJSON *dialogue = cJSON_GetArrayItem(dialoguesArray, i);
         DialogueText *currentDialogue = &dialogues[i];  // 각 대화에 대해 독립적인 포인터 사용
-        printf("now saving &dialogues[%d]\n", i);
+        LOG_DEBUG(LOG_DIALOGUE, "now saving &dialogues[%d]", i);
 
         // 대화 텍스트와 이름 저장
         strncpy(currentDialogue->name, cJSON_GetObjectItem(dialogue, "name")->valuestring, sizeof(currentDialogue->name) - 1);
         strcpy(currentDialogue->SE, cJSON_GetObjectItem(dialogue, "SE") ? cJSON_GetObjectItem(dialogue, "SE")->valuestring : "");
+        currentDialogue->seID = findSound(currentDialogue->SE);
         currentDialogue->ID = cJSON_GetObjectItem(dialogue, "id")->valueint;
         currentDialogue->name[sizeof(currentDialogue->name) - 1] = '\0';
         cJSON *text = cJSON_GetObjectItem(dialogue, "text");
         
-        printf("NPC: %s\n", cJSON_GetObjectItem(dialogue, "name")->valuestring);
-        printf("TextID: %d\n", currentDialogue->ID);
-        printf("SE: %s\n", currentDialogue->SE);
+        LOG_DEBUG(LOG_DIALOGUE, "NPC: %s", cJSON_GetObjectItem(dialogue, "name")->valuestring);
+        LOG_DEBUG(LOG_DIALOGUE, "TextID: %d", currentDialogue->ID);
+        LOG_DEBUG(LOG_DIALOGUE, "SE: %s", currentDialogue->SE);
         
         if(cJSON_IsArray(text)){
             for(int j = 0; j < cJSON_GetArraySize(text) && j < 4; j++){
                 strncpy(currentDialogue->text[j], cJSON_GetArrayItem(text, j)->valuestring, sizeof(currentDialogue->text[j]) - 1);
                 currentDialogue->text[j][sizeof(currentDialogue->text[j]) - 1] = '\0';
                 currentDialogue->textLineCount++;
-                printf("Dialogue (multi-line) %d: %s\n", j + 1, currentDialogue->text[j]);
+                LOG_DEBUG(LOG_DIALOGUE, "Dialogue (multi-line) %d: %s", j + 1, currentDialogue->text[j]);
             }
         }
         else{
             strncpy(currentDialogue->text[0], text->valuestring, sizeof(currentDialogue->text[0]) - 1);
             currentDialogue->text[0][sizeof(currentDialogue->text[0]) - 1] = '\0';
-            printf("Dialogue: %s\n", currentDialogue->text[0]);
+            LOG_DEBUG(LOG_DIALOGUE, "Dialogue: %s", currentDialogue->text[0]);
         }
 
         // 선택지 처리
@@ -491,7 +603,7 @@ void loadNPCDialogue(const char *fileName){
             
             currentDialogue->nextIds[j] = cJSON_GetObjectItem(option, "nextId")->valueint;
 
-            printf("Option %d: %s (nextId: %d)\n", j + 1, currentDialogue->options[j], currentDialogue->nextIds[j]);
+            LOG_DEBUG(LOG_DIALOGUE, "Option %d: %s (nextId: %d)", j + 1, currentDialogue->options[j], currentDialogue->nextIds[j]);
         }
 
         // 선택지가 없을 경우 외부 nextId 따르기
@@ -500,54 +612,18 @@ void loadNPCDialogue(const char *fileName){
             // 선택지가 없으면 대화에서 지정된 nextId 값을 사용
             if(currentDialogue->nextIds[0] == 0){ // 값이 설정되지 않았으면 덮어쓰기
                 currentDialogue->nextIds[0] = nextId->valueint;
-                printf("Next Dialogue ID: %d\n", currentDialogue->nextIds[0]);
+                LOG_DEBUG(LOG_DIALOGUE, "Next Dialogue ID: %d", currentDialogue->nextIds[0]);
             }
         }
         else{
             // 선택지가 없고 nextId도 없으면 대화 종료
             if(currentDialogue->nextIds[0] == 0){ // 값이 설정되지 않았으면 덮어쓰기
                 currentDialogue->nextIds[0] = -1;
-                printf("No Next Dialogue ID (end of conversation).\n");
+                LOG_DEBUG(LOG_DIALOGUE, "No Next Dialogue ID (end of conversation).");
             }
         }
 
         // 대화의 끝 구분선
-        printf("-------------------------------\n");
+        LOG_DEBUG(LOG_DIALOGUE, "-------------------------------");
     }
-
-    // 파일과 메모리 해제
-    free(jsonData);
-    fclose(file);
-    cJSON_Delete(root);
 }
-
-// 사운드 효과 로드
-void loadSoundEffect(const char *filePath, const char *name, int volume){
-    if (soundManager.effectCount >= 32) {
-        printf("Sound Manager is full!\n");
-        return;
-    }
-
-    Mix_Chunk *chunk = Mix_LoadWAV(filePath);
-    if (!chunk) {
-        printf("Failed to load sound: %s\n", Mix_GetError());
-        return;
-    }
-
-    SoundEffect *effect = &soundManager.effects[soundManager.effectCount++];
-    effect->chunk = chunk;
-    strncpy(effect->name, name, sizeof(effect->name) - 1);
-    effect->volume = volume;
-}
-
-// 사운드 효과 재생
-void playSoundEffect(const char *name){
-    for (int i = 0; i < soundManager.effectCount; ++i) {
-        if (strcmp(soundManager.effects[i].name, name) == 0) {
-            Mix_VolumeChunk(soundManager.effects[i].chunk, soundManager.effects[i].volume);
-            Mix_PlayChannel(-1, soundManager.effects[i].chunk, 0);  // 채널 -1, 반복 없음
-            return;
-        }
-    }
-    printf("Sound effect not found: %s\n", name);
-}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "global.h"
+
+// 계층형 타이머 휠
+// 시간 제한이 있는 상태(텍스트 표시, 프레임 딜레이, 미니게임 5초 등)의 마감 시각을 여기서 한꺼번에 관리
+// 0단계: 1ms 칸 256개 (256ms), 1단계: 256ms 칸 64개 (약 16초), 2단계: 16384ms 칸 64개 (약 17분)
+// 윗단계 칸은 시간이 되면 아랫단계로 다시 흩어짐 (cascade)
+// 메인 루프는 getNextTimerDelay로 다음 마감까지 남은 시간을 알아내서 그동안 잠들 수 있음
+// 휠은 GameContext마다 하나씩 (TimerWheel, global.h)
+#define TIMER_MAX_DELAY ((1u << (TIMER_LEVEL0_BITS + 2 * TIMER_LEVEL_BITS)) - 1)
+#define TIMER_GENERATION_MASK 0x7FFF // ID 윗부분에 넣는 세대 비트
+
+static void unlinkTimer(TimerWheel *wheel, int index){
+    TimerNode *node = &wheel->pool[index];
+    if(node->prev != -1) wheel->pool[node->prev].next = node->next;
+    else wheel->slots[node->slot] = node->next;
+    if(node->next != -1) wheel->pool[node->next].prev = node->prev;
+    node->slot = -1;
+}
+
+// 마감까지 남은 시간에 맞는 단계의 칸에 넣기
+static void linkTimer(TimerWheel *wheel, int index){
+    TimerNode *node = &wheel->pool[index];
+    Uint32 delay = node->expireTime - wheel->currentTime;
+    Uint32 expire = node->expireTime;
+    int slot;
+
+    if((Sint32)delay < 0){
+        delay = 0;
+        expire = wheel->currentTime;
+    }
+    if(delay > TIMER_MAX_DELAY){
+        // 너무 먼 마감은 마지막 칸에 넣어두고 그때 다시 계산
+        expire = wheel->currentTime + TIMER_MAX_DELAY;
+        delay = TIMER_MAX_DELAY;
+    }
+
+    if(delay < TIMER_LEVEL0_SLOTS){
+        slot = expire & (TIMER_LEVEL0_SLOTS - 1);
+    }
+    else if(delay < (1u << (TIMER_LEVEL0_BITS + TIMER_LEVEL_BITS))){
+        slot = TIMER_LEVEL0_SLOTS + ((expire >> TIMER_LEVEL0_BITS) & (TIMER_LEVEL_SLOTS - 1));
+    }
+    else{
+        slot = TIMER_LEVEL0_SLOTS + TIMER_LEVEL_SLOTS + ((expire >> (TIMER_LEVEL0_BITS + TIMER_LEVEL_BITS)) & (TIMER_LEVEL_SLOTS - 1));
+    }
+
+    node->slot = slot;
+    node->prev = -1;
+    node->next = wheel->slots[slot];
+    if(node->next != -1) wheel->pool[node->next].prev = index;
+    wheel->slots[slot] = index;
+}
+
+void initTimers(GameContext *game, Uint32 currentTime){
+    TimerWheel *wheel = &game->timers;
+    for(int i = 0; i < (int)SDL_arraysize(wheel->slots); i++){
+        wheel->slots[i] = -1;
+    }
+    for(int i = 0; i < TIMER_POOL_SIZE; i++){
+        wheel->pool[i].slot = -1;
+        wheel->pool[i].next = i + 1 < TIMER_POOL_SIZE ? i + 1 : -1;
+    }
+    wheel->freeList = 0;
+    wheel->currentTime = currentTime;
+    wheel->redrawTimer = -1;
+    wheel->redrawExpireTime = 0;
+}
+
+// delay(ms) 뒤에 callback 호출, 취소용 ID 반환 (풀이 가득 차면 -1)
+int addTimer(GameContext *game, Uint32 delay, TimerCallback callback, void *data){
+    TimerWheel *wheel = &game->timers;
+    if(wheel->freeList == -1){
+        LOG_WARN(LOG_CORE, "Timer pool is full!");
+        return -1;
+    }
+    if(delay < 1) delay = 1; // 지금 처리 중인 칸에 들어가면 한 바퀴 뒤에 불리므로 최소 1ms
+
+    int index = wheel->freeList;
+    TimerNode *node = &wheel->pool[index];
+    wheel->freeList = node->next;
+
+    node->expireTime = wheel->currentTime + delay;
+    node->callback = callback;
+    node->data = data;
+    node->generation++;
+    linkTimer(wheel, index);
+    return index | ((int)(node->generation & TIMER_GENERATION_MASK) << 16); // 세대는 15비트만 써서 ID가 음수(-1 = 없음)가 되지 않게
+}
+
+// 아직 안 불린 타이머 취소 (이미 불렸거나 -1이면 무시)
+void cancelTimer(GameContext *game, int timerID){
+    TimerWheel *wheel = &game->timers;
+    if(timerID < 0) return;
+
+    int index = timerID & 0xFFFF;
+    if(index >= TIMER_POOL_SIZE) return;
+
+    TimerNode *node = &wheel->pool[index];
+    if(node->slot == -1 || (node->generation & TIMER_GENERATION_MASK) != ((timerID >> 16) & TIMER_GENERATION_MASK)) return;
+
+    unlinkTimer(wheel, index);
+    node->next = wheel->freeList;
+    wheel->freeList = index;
+}
+
+// 윗단계 칸 하나를 비우고 아랫단계로 다시 넣음
+static void cascadeTimers(TimerWheel *wheel, int slot){
+    int index = wheel->slots[slot];
+    wheel->slots[slot] = -1;
+    while(index != -1){
+        int next = wheel->pool[index].next;
+        linkTimer(wheel, index);
+        index = next;
+    }
+}
+
+// 현재 시각까지 휠을 돌리며 마감된 타이머 호출
+void advanceTimers(GameContext *game, Uint32 currentTime){
+    TimerWheel *wheel = &game->timers;
+    while((Sint32)(currentTime - wheel->currentTime) > 0){
+        wheel->currentTime++;
+
+        int index0 = wheel->currentTime & (TIMER_LEVEL0_SLOTS - 1);
+        if(index0 == 0){
+            int index1 = (wheel->currentTime >> TIMER_LEVEL0_BITS) & (TIMER_LEVEL_SLOTS - 1);
+            if(index1 == 0){
+                int index2 = (wheel->currentTime >> (TIMER_LEVEL0_BITS + TIMER_LEVEL_BITS)) & (TIMER_LEVEL_SLOTS - 1);
+                cascadeTimers(wheel, TIMER_LEVEL0_SLOTS + TIMER_LEVEL_SLOTS + index2);
+            }
+            cascadeTimers(wheel, TIMER_LEVEL0_SLOTS + index1);
+        }
+
+        // 칸을 통째로 떼어낸 뒤 호출 (콜백 안에서 타이머를 다시 걸어도 안전)
+        int index = wheel->slots[index0];
+        wheel->slots[index0] = -1;
+        while(index != -1){
+            TimerNode *node = &wheel->pool[index];
+            int next = node->next;
+            node->slot = -1;
+
+            if((Sint32)(node->expireTime - wheel->currentTime) > 0){
+                linkTimer(wheel, index); // 너무 멀어서 잘려 들어왔던 타이머
+            }
+            else{
+                TimerCallback callback = node->callback;
+                void *data = node->data;
+                node->next = wheel->freeList;
+                wheel->freeList = index;
+                callback(game, data);
+            }
+            index = next;
+        }
+    }
+}
+
+// 다음 타이머까지 남은 시간 (ms), 타이머가 없으면 TIMER_MAX_DELAY
+Uint32 getNextTimerDelay(GameContext *game){
+    TimerWheel *wheel = &game->timers;
+    Uint32 nearest = TIMER_MAX_DELAY;
+    // 0단계는 칸 = 정확한 마감 시각이므로 앞에서부터 첫 번째 칸만 찾으면 됨
+    for(Uint32 offset = 1; offset <= TIMER_LEVEL0_SLOTS; offset++){
+        if(wheel->slots[(wheel->currentTime + offset) & (TIMER_LEVEL0_SLOTS - 1)] != -1){
+            nearest = offset;
+            break;
+        }
+    }
+
+    // 윗단계는 0단계가 한 바퀴 돌 때만 내려오므로 0단계 첫 칸보다 먼저 마감될 수 있음, 칸에 여러 마감이 섞여 있어서 노드를 직접 확인
+    for(int slot = TIMER_LEVEL0_SLOTS; slot < (int)SDL_arraysize(wheel->slots); slot++){
+        for(int index = wheel->slots[slot]; index != -1; index = wheel->pool[index].next){
+            Sint32 delay = (Sint32)(wheel->pool[index].expireTime - wheel->currentTime);
+            if(delay <= 0) return 0; // 내려오기 전에 이미 마감됨
+            if((Uint32)delay < nearest) nearest = (Uint32)delay;
+        }
+    }
+    return nearest;
+}
+
+static void redrawTimerCallback(GameContext *game, void *data){
+    // 메인 루프를 깨우기만 하면 되므로 할 일 없음
+    game->timers.redrawTimer = -1;
+}
+
+// delay(ms) 뒤에 한 프레임 그리도록 예약 (타이핑 효과처럼 시간에 따라 화면만 바뀌는 경우)
+// 이미 더 이른 예약이 있으면 그대로 둠
+void requestRedraw(GameContext *game, Uint32 delay){
+    TimerWheel *wheel = &game->timers;
+    if(wheel->redrawTimer != -1 && (Sint32)(wheel->redrawExpireTime - (wheel->currentTime + delay)) <= 0) return;
+
+    cancelTimer(game, wheel->redrawTimer);
+    wheel->redrawTimer = addTimer(game, delay, redrawTimerCallback, NULL);
+    wheel->redrawExpireTime = wheel->currentTime + delay;
+}
@@ -0,0 +1,158 @@
+#include "global.h"
+
+// 트리거 시스템
+// 월드는 맵이 가로로 이어진 띠 모양이라 상호작용 영역을 x 시작점 기준으로 정렬해 두고 이분 탐색으로 찾음
+// 플레이어가 움직일 때마다 겹치는 영역이 바뀐 것만 진입/이탈 이벤트로 쌓아둠
+// 정렬 인덱스는 모든 판이 같이 쓰고, 겹친 상태와 이벤트는 GameContext마다 (WorldState)
+
+int triggerOrder[MAX_INTERACTIONS];      // x 시작점 순으로 정렬된 상호작용 인덱스
+float triggerMaxEnd[MAX_INTERACTIONS];   // triggerOrder[0..i] 중 가장 오른쪽 끝 (구간 검색 조기 종료용)
+int teleportTarget[MAX_INTERACTIONS];    // 텔레포트 짝 (없으면 -1)
+
+// 이름으로 상호작용 종류 판별 (로딩 시에만 호출)
+InteractionType classifyInteraction(const char *name){
+    static const char *teleportNames[] = { "1F-outDoor", "1F-3F", "3F-4F", "4F-roofF", "roofDoor", "elevator", "frontDoor", "bathRoom", "pyeonUijeom" };
+    static const char *textNames[] = { "otherWay", "wrongWay", "NotElevator", "jinYeoldae", "Washstand", "Washtub" };
+    static const char *eventNames[] = { "blockedDoor", "frige", "bed", "toDo", "Toilet" };
+
+    for(int i = 0; i < (int)SDL_arraysize(teleportNames); i++){
+        if(strcmp(name, teleportNames[i]) == 0) return INTERACTION_TELEPORT;
+    }
+    for(int i = 0; i < (int)SDL_arraysize(textNames); i++){
+        if(strcmp(name, textNames[i]) == 0) return INTERACTION_TEXT;
+    }
+    for(int i = 0; i < (int)SDL_arraysize(eventNames); i++){
+        if(strcmp(name, eventNames[i]) == 0) return INTERACTION_EVENT;
+    }
+    if(strcmp(name, "buy") == 0) return INTERACTION_SHOP;
+    return INTERACTION_NONE;
+}
+
+static int compareTriggerStart(const void *a, const void *b){
+    float startA = interactions[*(const int *)a].x;
+    float startB = interactions[*(const int *)b].x;
+    return (startA > startB) - (startA < startB);
+}
+
+static int compareInteractionName(const void *a, const void *b){
+    int result = strcmp(interactions[*(const int *)a].name, interactions[*(const int *)b].name);
+    return result != 0 ? result : *(const int *)a - *(const int *)b;
+}
+
+// 모든 맵 로딩 후 한 번 호출: x 정렬 인덱스와 텔레포트 짝 테이블 생성
+void buildTriggerIndex(){
+    int byName[MAX_INTERACTIONS];
+
+    for(int i = 0; i < interactionCount; i++){
+        triggerOrder[i] = i;
+        byName[i] = i;
+        teleportTarget[i] = -1;
+    }
+
+    qsort(triggerOrder, interactionCount, sizeof(int), compareTriggerStart);
+    for(int i = 0; i < interactionCount; i++){
+        Interaction *zone = &interactions[triggerOrder[i]];
+        float end = zone->x + zone->width;
+        triggerMaxEnd[i] = (i > 0 && triggerMaxEnd[i - 1] > end) ? triggerMaxEnd[i - 1] : end;
+    }
+
+    // 이름순으로 정렬하면 같은 이름끼리 붙어 있으므로 짝을 한 번에 찾을 수 있음
+    qsort(byName, interactionCount, sizeof(int), compareInteractionName);
+    for(int i = 0; i < interactionCount; ){
+        int j = i + 1;
+        while(j < interactionCount && strcmp(interactions[byName[i]].name, interactions[byName[j]].name) == 0) j++;
+
+        // 같은 이름 그룹 안에서 첫 번째 다른 오브젝트로 연결 (기존 선형 탐색과 같은 결과)
+        if(interactions[byName[i]].type == INTERACTION_TELEPORT && j - i >= 2){
+            for(int k = i; k < j; k++){
+                teleportTarget[byName[k]] = byName[k == i ? i + 1 : i];
+            }
+        }
+        i = j;
+    }
+
+    LOG_INFO(LOG_MAP, "Trigger index built: %d interactions", interactionCount);
+}
+
+// 인덱스를 새로 만든 뒤 호출: 겹친 상태를 비움 (상호작용 인덱스가 바뀌었을 수 있음)
+void resetTriggers(GameContext *game){
+    game->world.activeTriggerCount = 0;
+    game->world.triggerEventCount = 0;
+    game->world.promptInteraction = -1;
+}
+
+static void pushTriggerEvent(WorldState *world, TriggerEventType type, int interactionIndex){
+    if(world->triggerEventCount >= MAX_TRIGGER_EVENTS) return; // 넘치면 버림 (다음 틱에 상태로 다시 맞춰짐)
+    world->triggerEvents[world->triggerEventCount].type = type;
+    world->triggerEvents[world->triggerEventCount].interactionIndex = interactionIndex;
+    world->triggerEventCount++;
+}
+
+// 물리 틱마다 호출: 플레이어와 겹친 상호작용을 찾아 이전 틱과 비교
+void updateTriggers(GameContext *game){
+    WorldState *world = &game->world;
+    float minX = game->player.x;
+    float maxX = game->player.x + game->player.rect.w;
+    float minY = game->player.y;
+    float maxY = game->player.y + game->player.rect.h;
+    int current[MAX_ACTIVE_TRIGGERS];
+    int currentCount = 0;
+
+    // x 시작점 < 플레이어 오른쪽 끝 인 마지막 위치를 이분 탐색
+    int low = 0, high = interactionCount;
+    while(low < high){
+        int mid = (low + high) / 2;
+        if(interactions[triggerOrder[mid]].x < maxX) low = mid + 1;
+        else high = mid;
+    }
+
+    // 왼쪽으로 훑으면서 겹치는 것만 수집, 누적 최대 끝점이 플레이어 왼쪽보다 작아지면 더 볼 필요 없음
+    for(int i = low - 1; i >= 0 && triggerMaxEnd[i] > minX; i--){
+        int index = triggerOrder[i];
+        Interaction *zone = &interactions[index];
+        if(zone->x + zone->width <= minX || zone->y >= maxY || zone->y + zone->height <= minY) continue;
+        if(currentCount >= MAX_ACTIVE_TRIGGERS) break;
+
+        // 인덱스 오름차순 유지 (checkInteractions가 기존 순서대로 처리하도록)
+        int k = currentCount++;
+        while(k > 0 && current[k - 1] > index){
+            current[k] = current[k - 1];
+            k--;
+        }
+        current[k] = index;
+    }
+
+    // 정렬된 두 목록을 비교해서 바뀐 것만 이벤트로
+    int a = 0, b = 0;
+    while(a < world->activeTriggerCount || b < currentCount){
+        if(b >= currentCount || (a < world->activeTriggerCount && world->activeTriggers[a] < current[b])){
+            pushTriggerEvent(world, TRIGGER_EXIT, world->activeTriggers[a++]);
+        }
+        else if(a >= world->activeTriggerCount || current[b] < world->activeTriggers[a]){
+            pushTriggerEvent(world, TRIGGER_ENTER, current[b++]);
+        }
+        else{
+            a++;
+            b++;
+        }
+    }
+
+    memcpy(world->activeTriggers, current, sizeof(int) * currentCount);
+    world->activeTriggerCount = currentCount;
+}
+
+// 프레임마다 호출: 쌓인 진입/이탈 이벤트 처리 (UI 안내 갱신)
+void processTriggerEvents(GameContext *game){
+    WorldState *world = &game->world;
+    for(int i = 0; i < world->triggerEventCount; i++){
+        TriggerEvent *event = &world->triggerEvents[i];
+        if(event->type == TRIGGER_ENTER){
+            world->promptInteraction = event->interactionIndex;
+        }
+        else if(event->interactionIndex == world->promptInteraction){
+            // 아직 겹쳐 있는 다른 영역이 있으면 그쪽으로 안내를 넘김
+            world->promptInteraction = world->activeTriggerCount > 0 ? world->activeTriggers[0] : -1;
+        }
+    }
+    world->triggerEventCount = 0;
+}
@@ -1,154 +1,321 @@
 #include "global.h"
+#include <math.h>
 
-void updateFrame(){
-    int currentTime = SDL_GetTicks();
-    int currentFrameDelay = isMoving ? movingFrameDelay : idleFrameDelay;
+static void playerFrameTimerCallback(GameContext *game, void *data){
+    PlayerState *player = &game->player;
+    player->frame = (player->frame + 1) % 8; // 8프레임
+    player->frameTimer = addTimer(game, player->isMoving ? movingFrameDelay : idleFrameDelay, playerFrameTimerCallback, NULL);
+    player->frameTimerMoving = player->isMoving;
+}
 
-    if(currentTime > lastFrameTime + currentFrameDelay){
-        frame = (frame + 1) % 8; // 8프레임
-        lastFrameTime = currentTime;
+void updateFrame(GameContext *game){
+    PlayerState *player = &game->player;
+    // 이동 상태가 바뀌면 딜레이가 달라지므로 타이머를 다시 검
+    if(player->frameTimer == -1 || player->frameTimerMoving != player->isMoving){
+        cancelTimer(game, player->frameTimer);
+        player->frameTimer = addTimer(game, player->isMoving ? movingFrameDelay : idleFrameDelay, playerFrameTimerCallback, NULL);
+        player->frameTimerMoving = player->isMoving;
     }
+
+    updateEntityFrames(game);
+}
+
+// 애니메이션 프레임 타이머: 마감되면 다음 프레임으로 넘길 표시만 하고 다시 예약 (프레임 갱신은 updateAnimation)
+static void animationTimerCallback(GameContext *game, void *data){
+    tileAnimation *animation = data;
+    animation->frameTimer = -1;
+    if(!animation->isActive || animation->isFinished || animation->isFreezed) return;
+
+    animation->isFrameDue = SDL_TRUE;
+    animation->frameTimer = addTimer(game, animation->frameDuration, animationTimerCallback, animation);
+}
+
+// 애니메이션 재생 시작
+void activateAnimation(GameContext *game, tileAnimation *animation){
+    animation->isActive = SDL_TRUE;
+    animation->isFrameDue = SDL_TRUE; // 첫 프레임은 바로 넘김
+    cancelTimer(game, animation->frameTimer);
+    animation->frameTimer = addTimer(game, animation->frameDuration, animationTimerCallback, animation);
 }
 
 void updateAnimation(tileAnimation *animation){
-    if(!animation->isActive || animation->isFinished){
-        return; // 활성화되지 않았거나 이미 종료된 애니메이션은 업데이트하지 않음
+    if(!animation->isActive || animation->isFinished || !animation->isFrameDue){
+        return; // 비활성, 종료, 아직 프레임 시간이 안 된 애니메이션은 업데이트하지 않음
     }
-    else if(animation->isActive && !animation->isFinished){
-        Uint32 currentTime = SDL_GetTicks();
 
-        // 프레임 갱신
-        if(currentTime - animation->lastFrameTime >= animation->frameDuration){
-            animation->lastFrameTime = currentTime;
-            animation->currentFrame++;
+    // 프레임 갱신
+    animation->isFrameDue = SDL_FALSE;
+    animation->currentFrame++;
 
-            // 마지막 프레임에 도달하면 멈춤
-            if(animation->currentFrame >= animation->frameCount){
-                animation->currentFrame = animation->frameCount - 1; // 마지막 프레임에서 멈춤
-                animation->isFreezed = SDL_TRUE;                     // 일시정지
-            }
-        }
+    // 마지막 프레임에 도달하면 멈춤
+    if(animation->currentFrame >= animation->frameCount){
+        animation->currentFrame = animation->frameCount - 1; // 마지막 프레임에서 멈춤
+        animation->isFreezed = SDL_TRUE;                     // 일시정지
     }
 }
 
-void updateMiniGame(TTF_Font *font){
-    if (!isMiniGameActive) return;
-    static Uint8 previousState[SDL_NUM_SCANCODES] = {0};  // 이전 키 상태 저장
-    const Uint8 *state = SDL_GetKeyboardState(NULL);      // 현재 키 상태 가져오기
+static void updateAnimationRange(void *data, int begin, int end){
+    tileAnimation *animations = data;
+    for(int i = begin; i < end; i++){
+        updateAnimation(&animations[i]);
+    }
+}
 
-    Uint32 currentTime = SDL_GetTicks();
-    Uint32 elapsedTime = (currentTime - miniGameStartTime) / 1000; // 초 단위
+// 애니메이션은 서로 독립적이라 잡 시스템으로 나눠서 갱신
+void updateAnimations(GameContext *game){
+    parallelFor("animation", 0, game->world.animationCount, 4, updateAnimationRange, game->world.animations);
+}
 
-    // 스페이스바가 눌린 상태인지 확인
-    if(state[SDL_SCANCODE_SPACE] && !previousState[SDL_SCANCODE_SPACE]){
-        spaceBarCount++;
-        playSoundEffect("doorBell");
-    }
-    memcpy(previousState, state, SDL_NUM_SCANCODES);
+static void endTextEffectCallback(GameContext *game, void *data){
+    game->ui.isEffectActive = SDL_FALSE; // 효과 종료
+}
 
-    // 5초가 지나면 미니게임 종료
-    if(elapsedTime >= 5){
-        isMiniGameActive = SDL_FALSE;
+// 5초 타이머가 울리면 미니게임 종료
+void finishMiniGame(GameContext *game, void *data){
+    UIState *ui = &game->ui;
+    ui->isMiniGameActive = SDL_FALSE;
 
-        // 종료 메시지 설정
-        activeTextDisplay.text = buffer;
-        activeTextDisplay.startTime = currentTime;
-        activeTextDisplay.duration = 2000; // 2초 동안 표시
+    // 종료 메시지 설정
+    showText(game, ui->miniGameText, 2000); // 2초 동안 표시
 
-        // 관련 애니메이션 활성화
-        for(int a = 0; a < animationCount; a++){
-            if(animations[a].eventID == 1 || animations[a].eventID == 2){  // 특정 eventID 확인 (예: 1번 이벤트)
-                animations[a].isActive = SDL_TRUE;  // 애니메이션 재생 시작
-                printf("Animation with eventID %d activated.\n", animations[a].eventID);
-            }
+    // 관련 애니메이션 활성화
+    for(int a = 0; a < game->world.animationCount; a++){
+        tileAnimation *animation = &game->world.animations[a];
+        if(animation->eventID == 1 || animation->eventID == 2){  // 특정 eventID 확인 (예: 1번 이벤트)
+            activateAnimation(game, animation);  // 애니메이션 재생 시작
+            LOG_DEBUG(LOG_CORE, "Animation with eventID %d activated.", animation->eventID);
         }
-        isDialogueActive = SDL_TRUE;
+    }
+    ui->isDialogueActive = SDL_TRUE;
+}
+
+void updateMiniGame(GameContext *game){
+    UIState *ui = &game->ui;
+    if (!ui->isMiniGameActive) return;
+
+    // 이번 프레임에 들어온 스페이스바 입력을 전부 셈 (프레임 사이 연타, 프레임 끊김에도 누락 없음)
+    // 타임스탬프로 걸러서 5초 제한 안에 눌린 것만 인정
+    int presses = getKeyPressCountBetween(game, SDL_SCANCODE_SPACE, ui->miniGameStartTime, ui->miniGameStartTime + 5000);
+    for(int i = 0; i < presses; i++){
+        ui->spaceBarCount++;
+        playGameSound(game, doorBellSound);
     }
 
-    // 텍스트 효과 활성화 (10단위 카운트마다)
-    if(spaceBarCount % 10 == 0 && spaceBarCount > 0 && !isEffectActive){
-        isEffectActive = SDL_TRUE;
-        effectStartTime = currentTime;
+    // 텍스트 효과 활성화 (10단위 카운트마다), 165ms 뒤 타이머로 종료
+    if(ui->spaceBarCount % 10 == 0 && ui->spaceBarCount > 0 && !ui->isEffectActive){
+        ui->isEffectActive = SDL_TRUE;
+        ui->effectStartTime = game->clock.time;
+        addTimer(game, 165, endTextEffectCallback, NULL);
     }
 
     // 텍스트 효과: 크기와 색상 변경
-    fontSize = 24;
-    textEventColor = BasicColor;
+    ui->fontSize = 24;
+    ui->textEventColor = BasicColor;
 
-    if(isEffectActive){
-        Uint32 effectElapsedTime = currentTime - effectStartTime;
+    if(ui->isEffectActive){
+        ui->fontSize = 32; // 텍스트 크기를 키움
+        ui->textEventColor = YelloColor; // 노란색으로 변경
+    }
 
-        if(effectElapsedTime < 165){ // 0~300ms 동안 효과 적용
-            fontSize = 32; // 텍스트 크기를 키움
-            textEventColor = YelloColor; // 노란색으로 변경
-        }
-        else{
-            isEffectActive = SDL_FALSE; // 효과 종료
-        }
+    sprintf(ui->miniGameText, "띵동대쉬: %d, 초당 %d연타!", ui->spaceBarCount, ui->spaceBarCount / 5);
+}
+
+// sweepAxis가 BVH 후보마다 넘겨받는 상태
+typedef struct SweepQuery{
+    float boxX, boxY, boxW, boxH;
+    float delta;
+    int axis;
+    float firstHit;
+    int hitIndex;
+} SweepQuery;
+
+static void visitSweepPlatform(int index, void *data){
+    const float skin = 0.01f; // 부동소수점 오차 허용치
+    SweepQuery *query = data;
+    Platform *p = &platforms[index];
+    if(p->pointCount > 0) return; // 다각형 조각은 SAT로 따로 처리
+    float boxMin, boxSize, platformMin, platformSize;
+
+    if(query->axis == 0){
+        // 다른 축(y)으로 겹쳐 있어야 x축 이동 중에 부딪힐 수 있음 (모서리에 딱 붙은 건 제외)
+        if(query->boxY >= p->y + p->height - skin || query->boxY + query->boxH <= p->y + skin) return;
+        boxMin = query->boxX; boxSize = query->boxW; platformMin = p->x; platformSize = p->width;
+    }
+    else{
+        if(query->boxX >= p->x + p->width - skin || query->boxX + query->boxW <= p->x + skin) return;
+        boxMin = query->boxY; boxSize = query->boxH; platformMin = p->y; platformSize = p->height;
     }
 
-    sprintf(buffer, "띵동대쉬: %d, 초당 %d연타!", spaceBarCount, spaceBarCount / 5);
+    // 진행 방향 앞쪽 면까지의 거리
+    float delta = query->delta;
+    float gap = delta > 0 ? platformMin - (boxMin + boxSize) : (platformMin + platformSize) - boxMin;
+
+    // 이미 겹쳐 있거나 뒤쪽에 있는 플랫폼은 무시 (텔레포트 직후 끼임 방지)
+    if(delta > 0 ? gap < -skin : gap > skin) return;
+
+    float t = gap / delta;
+    if(t < 0.0f) t = 0.0f;
+    if(t < query->firstHit){
+        query->firstHit = t;
+        query->hitIndex = index;
+    }
 }
 
-void updatePhysics(){
-    // 중력 적용
-    velocityY += gravity;
-    playerY += velocityY; // y좌표 변경
+// 한 축 방향으로 움직이는 플레이어 박스가 플랫폼에 처음 닿는 시점(TOI, 0~1)을 구함 (swept AABB)
+// axis 0 = x축, 1 = y축 / 충돌한 플랫폼 인덱스는 hitIndex에 저장 (없으면 -1)
+float sweepAxis(float boxX, float boxY, float boxW, float boxH, float delta, int axis, int *hitIndex){
+    *hitIndex = -1;
+    if(delta == 0.0f) return 1.0f;
 
-    // 플레이어의 rect를 업데이트
-    playerRect.x = playerX - camera.x; 
-    playerRect.y = playerY - camera.y;
-
-    // 모든 플랫폼과 충돌 체크
-    for(int i = 0; i < platformCount; i++){
-        SDL_Rect platformRect = {platforms[i].x - camera.x, platforms[i].y - camera.y, platforms[i].width, platforms[i].height};
-        // y축 충돌 체크
-        if(SDL_HasIntersection(&playerRect, &platformRect)){
-            if(velocityY > 0){
-                int dontMovePlayerY = 0;
-                if(playerRect.x < platformRect.x){
-                    playerX = platformRect.x - playerRect.w + camera.x;
-                }
-                if(playerRect.x + playerRect.w > platformRect.x + platformRect.w) {
-                    playerX = platformRect.x + platformRect.w + camera.x - 72;
-                }
-                playerY = platformRect.y - playerRect.h; // y좌표 조정
-                velocityY = 0; // 속도 0으로 초기화
-                isJumping = 0; // 점프 상태 해제
+    SweepQuery query = { boxX, boxY, boxW, boxH, delta, axis, 1.0f, -1 };
+
+    // 이동 경로 전체를 덮는 영역으로 BVH에서 후보 플랫폼만 훑음
+    float minX = boxX + (axis == 0 && delta < 0 ? delta : 0);
+    float minY = boxY + (axis == 1 && delta < 0 ? delta : 0);
+    float maxX = boxX + boxW + (axis == 0 && delta > 0 ? delta : 0);
+    float maxY = boxY + boxH + (axis == 1 && delta > 0 ? delta : 0);
+    queryPlatformBVH(minX, minY, maxX, maxY, visitSweepPlatform, &query);
+
+    *hitIndex = query.hitIndex;
+    return query.firstHit;
+}
+
+// resolvePolygonPlatforms가 BVH 후보마다 넘겨받는 상태 (밀어낸 결과가 다음 후보 검사에 바로 반영됨)
+typedef struct PolygonPush{
+    float *x, *y;
+    float w, h;
+    float *vy;
+    int hits;
+} PolygonPush;
+
+static void visitPolygonPlatform(int index, void *data){
+    PolygonPush *push = data;
+    Platform *p = &platforms[index];
+    float pushX, pushY;
+    if(p->pointCount == 0) return;
+    if(!collideBoxPolygon(*push->x, *push->y, push->w, push->h, p, &pushX, &pushY)) return;
+
+    float pushLengthSq = pushX * pushX + pushY * pushY;
+    if(pushY < 0 && pushY * pushY >= pushLengthSq * 0.25f){
+        // 위를 향한 면 (기울기 60도 이하): 옆으로 미끄러지지 않게 수직으로만 올려놓음
+        *push->y += pushLengthSq / pushY;
+        if(*push->vy > 0) *push->vy = 0;
+        push->hits |= BOX_HIT_FLOOR;
+    }
+    else{
+        *push->x += pushX;
+        *push->y += pushY;
+        if(pushY > 0 && *push->vy < 0) *push->vy = 0; // 경사진 천장
+        push->hits |= BOX_HIT_WALL;
+    }
+}
+
+// 박스와 겹친 다각형(경사로) 조각을 SAT로 밀어냄
+int resolvePolygonPlatforms(float *x, float *y, float w, float h, float *vy){
+    PolygonPush push = { x, y, w, h, vy, 0 };
+    queryPlatformBVH(*x, *y, *x + w, *y + h, visitPolygonPlatform, &push);
+    return push.hits;
+}
+
+// 박스 하나를 속도만큼 이동시키며 플랫폼과 충돌 처리 (플레이어와 NPC 공용)
+// 바닥에 닿으면 BOX_HIT_FLOOR, 벽에 막히면 BOX_HIT_WALL 비트를 반환
+int moveBox(float *x, float *y, float w, float h, float *vx, float *vy, float stepTime){
+    int hits = 0;
+    int hitIndex;
+
+    // 다각형은 겹침 검사라서 한 번에 박스 절반 이상 움직이지 않도록 틱을 쪼갬 (사각형은 스윕이라 필요 없음)
+    int substeps = 1;
+    if(polygonPlatformCount > 0){
+        float maxMove = fmaxf(fabsf(*vx), fabsf(*vy)) * stepTime;
+        float substepCount = 1.0f + maxMove / (fminf(w, h) * 0.5f);
+        // 속도가 터무니없이 크면 (텔레포트 직후, NaN 등) 틱 하나가 끝나지 않으므로 상한을 둠
+        substeps = substepCount < MAX_MOVE_SUBSTEPS ? (int)substepCount : MAX_MOVE_SUBSTEPS;
+    }
+    float subStepTime = stepTime / substeps;
+
+    for(int s = 0; s < substeps; s++){
+        // y축 스윕: 이번 틱 이동량 안에서 처음 닿는 플랫폼 앞에서 멈춤
+        float deltaY = *vy * subStepTime;
+        sweepAxis(*x, *y, w, h, deltaY, 1, &hitIndex);
+        if(hitIndex != -1){
+            if(deltaY > 0){
+                *y = platforms[hitIndex].y - h; // 바닥 위에 정확히 올려놓음
+                hits |= BOX_HIT_FLOOR;
+            }
+            else{
+                *y = platforms[hitIndex].y + platforms[hitIndex].height; // 천장에 머리 박음
             }
-            break; // 첫 번째 충돌만 처리
+            *vy = 0; // 속도 0으로 초기화
         }
-    }
-    // 플레이어의 rect를 업데이트 (y좌표 조정 후)
-    playerRect.y = playerY - camera.y;
-    playerRect.x = playerX - camera.x;
-
-    // x축 충돌
-    for(int i = 0; i < platformCount; i++){
-        SDL_Rect platformRect = {platforms[i].x - camera.x, platforms[i].y - camera.y, platforms[i].width, platforms[i].height};
-        //printf("%d  %d  %d\n", platformRect.x, platformRect.y, platformRect.w);
-        if(SDL_HasIntersection(&playerRect, &platformRect)){
-            if(playerRect.x < platformRect.x){ // 플레이어가 플랫폼의 왼쪽에 있을 때
-                playerX = platformRect.x - playerRect.w + camera.x; // 카메라 좌표 반영
+        else{
+            *y += deltaY;
+        }
+
+        // x축 스윕: y를 먼저 확정했으니 바닥 위에서는 그대로 미끄러지듯 이동
+        float deltaX = *vx * subStepTime;
+        sweepAxis(*x, *y, w, h, deltaX, 0, &hitIndex);
+        if(hitIndex != -1){
+            if(deltaX > 0){
+                *x = platforms[hitIndex].x - w; // 벽 왼쪽 면에 붙임
             }
-            else{ // 플레이어가 플랫폼의 오른쪽에 있을 때
-                playerX = platformRect.x + platformRect.w + camera.x; // 카메라 좌표 반영
+            else{
+                *x = platforms[hitIndex].x + platforms[hitIndex].width; // 벽 오른쪽 면에 붙임
             }
-            break; // 첫 번째 충돌을 찾으면 루프 종료
+            hits |= BOX_HIT_WALL;
+        }
+        else{
+            *x += deltaX;
+        }
+
+        if(polygonPlatformCount > 0){
+            hits |= resolvePolygonPlatforms(x, y, w, h, vy);
         }
     }
-    playerRect.x = playerX - camera.x;
+    return hits;
 }
 
-void updateCamera(float deltaTime){
+void updatePhysics(GameContext *game, float stepTime){
+    PlayerState *player = &game->player;
+    player->previousX = player->x;
+    player->previousY = player->y;
+
+    // 중력 적용
+    player->velocityY += gravity * stepTime;
+
+    int hits = moveBox(&player->x, &player->y, player->rect.w, player->rect.h, &player->velocityX, &player->velocityY, stepTime);
+    if(hits & BOX_HIT_FLOOR){
+        player->isJumping = 0; // 점프 상태 해제
+    }
+
+    // 플레이어의 rect를 업데이트
+    player->rect.x = player->x - game->camera.rect.x;
+    player->rect.y = player->y - game->camera.rect.y;
+
+    // NPC 등 나머지 엔티티
+    updateEntityPhysics(game, stepTime);
+}
+
+void updateCamera(GameContext *game, float deltaTime){
+    CameraState *camera = &game->camera;
+    const PlayerState *player = &game->player;
     const float cameraSpeed = 5.0f; // 부드러운 카메라 속도 (픽셀/초)
 
     // 카메라의 x, y 좌표를 플레이어의 x 좌표를 기준으로 부드럽게 조정
-    cameraX += (playerX - cameraX - (camera.w / 2 - playerRect.w / 2)) * cameraSpeed * deltaTime;
-    //camera.y = (int)(playerY - (camera.h / 2 - playerRect.h / 2));
+    // 잠들었다 깨어난 긴 프레임에서 지나치지 않도록 한 프레임에 최대 목표 지점까지만
+    float followRate = cameraSpeed * deltaTime;
+    if(followRate > 1.0f) followRate = 1.0f;
+    camera->x += (player->x - camera->x - (camera->rect.w / 2 - player->rect.w / 2)) * followRate;
+    //camera->rect.y = (int)(player->y - (camera->rect.h / 2 - player->rect.h / 2));
 
     // 카메라가 화면의 경계를 넘지 않도록 제한
-    if (cameraX < 0) cameraX = 0;
+    if (camera->x < 0) camera->x = 0;
+
+    camera->rect.x = (int)camera->x; // 카메라 rect의 x 값은 int로 변환 (분리용)
+}
 
-    camera.x = (int)cameraX; // 카메라 rect의 x 값은 int로 변환 (분리용)
+// 카메라가 목표 위치에 거의 도착했는지 (더 그려도 화면이 안 바뀌는지)
+SDL_bool isCameraSettled(GameContext *game){
+    float target = game->player.x - (game->camera.rect.w / 2 - game->player.rect.w / 2);
+    if(target < 0) target = 0;
+    return fabsf(target - game->camera.x) < 0.5f;
 }
\ No newline at end of file
@@ -8,60 +8,63 @@
 #include <stdlib.h>
 #include <dirent.h>
 // 로컬파일
-#include "code\tileData.c"
-#include "code\render.c"
-#include "code\handleInfo.c"
-#include "code\update.c"
-#include "code\initialize.c"
+#include "code/log.c"
+#include "code/memory.c"
+#include "code/tileData.c"
+#include "code/collision.c"
+#include "code/trigger.c"
+#include "code/entity.c"
+#include "code/job.c"
+#include "code/input.c"
+#include "code/timer.c"
+#include "code/audio.c"
+#include "code/music.c"
+#include "code/asset.c"
+#include "code/pack.c"
+#include "code/prefetch.c"
+#include "code/profiler.c"
+#include "code/hitch.c"
+#include "code/telemetry.c"
+#include "code/hotReload.c"
+#include "code/render.c"
+#include "code/handleInfo.c"
+#include "code/update.c"
+#include "code/simulate.c"
+#include "code/replay.c"
+#include "code/save.c"
+#include "code/initialize.c"
 
 #define MAX_MAPCOUNT 100
 
-// 마지막 시간 기록
-Uint32 lastTime = 0;
-
-// 플레이어 좌표 (물리엔진과 렌더링(SDL_Rect) 분리용)
-float playerX = 12000.0f;
-float playerY = 360.0f;
-
-SDL_Rect playerRect = { 0, 0, 72, 72 }; // 렌더링할 플레이어 rect
-
-int velocityY = 0;
-int gravity = 1;
-int direction = 1;
-int isJumping = 0;
-int isMoving = 0;
-
-int frame = 0;
+float gravity = 14400.0f;  // 중력 가속도 (픽셀/초^2, 기존 120FPS에서 프레임당 1픽셀 가속과 동일)
 int idleFrameDelay = 500;  // 가만히 있을 때의 프레임 딜레이 (ms)
 int movingFrameDelay = 70;  // 움직일 때의 프레임 딜레이 (ms)
-int lastFrameTime = 0;
-int eKeyPressed = 0;
-char *propertyText = NULL;
 
 Map maps[MAX_MAPCOUNT];
 int currentMapCount = 0; // 현재 로드된 맵 수
+char mapDirectory[128] = "tile"; // 실행 인자 --tiles=폴더 (tools/worldGenerator로 만든 스트레스 월드 등)
 
-Platform platforms[100]; // 플랫폼 배열
+Platform platforms[MAX_PLATFORMCOUNT]; // 플랫폼 배열
 int platformCount = 0; // 현재 플랫폼 수
+int polygonPlatformCount = 0; // 그중 다각형 조각 수
 
-Interaction interactions[100]; // 상호작용 배열
+Interaction interactions[MAX_INTERACTIONS]; // 상호작용 배열
 int interactionCount = 0;      // 현재 상호작용 수
 
-float cameraX = 11500.0f; // 카메라 좌표 (분리용)
-SDL_Rect camera = { 0, 0, 800, 600 }; // 카메라 정보
-
 SDL_Texture* spriteSheet = NULL; // 스프라이트 시트 텍스처
 
 // JSON 데이터에서 추출한 맵 데이터 관련 정보
 int mapWidth, mapHeight;
 int tileWidth, tileHeight;
-int *tileData; // 타일 데이터 배열
 
 SDL_Window *window = NULL;
 SDL_Renderer *renderer = NULL;
 SDL_Texture *tilesetTexture = NULL;
 
-int playerGold = 10000;
+Shop shopCatalog[MAX_SHOP_ITEMS]; // 맵에서 읽은 상점 목록 (판마다 복사해서 재고를 셈)
+int shopCatalogCount = 0;
+
+int physicsTickRate = 120;   // 실행 인자 --tickrate=N 으로 변경 가능
 
 int getItemPrice(const char *itemName){
     if (strcmp(itemName, "영양젤리") == 0) {
@@ -74,122 +77,173 @@ int getItemPrice(const char *itemName){
     return 0; // 기본값
 }
 
-void checkInteractions(SDL_Rect *playerRect){
-    float playerXWithCamera = playerX;
-    float playerYWithCamera = playerY;
-
-    for(int i = 0; i < interactionCount; i++){
+void checkInteractions(GameContext *game){
+    PlayerState *player = &game->player;
+    WorldState *world = &game->world;
+    // 플레이어와 겹친 상호작용은 트리거 시스템이 틱마다 갱신해 둠 (전체 배열을 훑지 않음)
+    for(int t = 0; t < world->activeTriggerCount; t++){
+        int i = world->activeTriggers[t];
         Interaction interactionZone = interactions[i];
 
-        // 플레이어와 오브젝트 간의 충돌 체크
-        if((playerXWithCamera < (interactionZone.x + interactionZone.width)) &&
-            ((playerXWithCamera + playerRect->w) > interactionZone.x) &&
-            (playerYWithCamera < (interactionZone.y + interactionZone.height)) &&
-            ((playerYWithCamera + playerRect->h) > interactionZone.y)){
-
-            // 이동 오브젝트 처리
-            if(strcmp(interactionZone.name, "1F-outDoor") == 0 ||
-                strcmp(interactionZone.name, "1F-3F") == 0 ||
-                strcmp(interactionZone.name, "3F-4F") == 0 ||
-                strcmp(interactionZone.name, "4F-roofF") == 0 ||
-                strcmp(interactionZone.name, "roofDoor") == 0 ||
-                strcmp(interactionZone.name, "elevator") == 0 ||
-                strcmp(interactionZone.name, "frontDoor") == 0 ||
-                strcmp(interactionZone.name, "bathRoom") == 0 ||
-                strcmp(interactionZone.name, "pyeonUijeom") == 0){
-                int index = -1;
-
-                // 현재 오브젝트와 동일한 이름을 가진 다른 오브젝트 찾기
-                for(int j = 0; j < interactionCount; j++){
-                    if(j != i && strcmp(interactions[j].name, interactionZone.name) == 0){
-                        index = j;
-                        break;
-                    }
-                }
-
-                if(index != -1){
-                    // 다른 오브젝트로 텔레포트
-                    Interaction targetInteractionZone = interactions[index];
-
-                    if(interactionZone.SE != NULL && strlen(interactionZone.SE) > 0){
-                        playSoundEffect(interactionZone.SE);
-                    }
-
-                    // 텔레포트
-                    playerX = targetInteractionZone.x;
-                    playerY = targetInteractionZone.y;
-
-                    // 마지막 상호작용 위치 저장
-                    lastInteractions[i].x = playerRect->x;
-                    lastInteractions[i].y = playerRect->y;
-                    strcpy(lastInteractions[i].name, interactionZone.name);
-
-                    printf("Teleporting to %s at (%.2f, %.2f)\n", targetInteractionZone.name, targetInteractionZone.x, targetInteractionZone.y);
-                    return;  // 텔레포트 후 종료
-                }
-            }
-            // 속성값 Text의 텍스트 처리
-            else if(strcmp(interactionZone.name, "otherWay") == 0 ||
-                    strcmp(interactionZone.name, "wrongWay") == 0 ||
-                    strcmp(interactionZone.name, "NotElevator") == 0 ||
-                    strcmp(interactionZone.name, "jinYeoldae") == 0 ||
-                    strcmp(interactionZone.name, "Washstand") == 0 ||
-                    strcmp(interactionZone.name, "Washtub") == 0){
-                handleTextInteraction(&interactionZone);
+        // 이동 오브젝트 처리
+        if(interactionZone.type == INTERACTION_TELEPORT){
+            // 같은 이름을 가진 다른 오브젝트는 로딩 때 미리 짝지어 둠
+            int index = teleportTarget[i];
+
+            if(index != -1){
+                // 다른 오브젝트로 텔레포트
+                Interaction targetInteractionZone = interactions[index];
+
+                playGameSound(game, interactionZone.seID);
+
+                // 텔레포트 (보간이 순간이동 경로를 따라 번지지 않도록 직전 좌표도 같이 옮김)
+                player->x = targetInteractionZone.x;
+                player->y = targetInteractionZone.y;
+                player->previousX = player->x;
+                player->previousY = player->y;
+
+                // 마지막 상호작용 위치 저장
+                world->lastInteractions[i].x = player->rect.x;
+                world->lastInteractions[i].y = player->rect.y;
+                strcpy(world->lastInteractions[i].name, interactionZone.name);
+
+                LOG_DEBUG(LOG_MAP, "Teleporting to %s at (%.2f, %.2f)", targetInteractionZone.name, targetInteractionZone.x, targetInteractionZone.y);
+                return;  // 텔레포트 후 종료
             }
-            // 상점
-            else if(strcmp(interactionZone.name, "buy") == 0){
-                if(!isShopVisible){
-                    isShopVisible = SDL_TRUE;  // UI 활성화
-                }
+        }
+        // 속성값 Text의 텍스트 처리
+        else if(interactionZone.type == INTERACTION_TEXT){
+            handleTextInteraction(game, &interactions[i]);
+        }
+        // 상점
+        else if(interactionZone.type == INTERACTION_SHOP){
+            if(!game->ui.isShopVisible){
+                game->ui.isShopVisible = SDL_TRUE;  // UI 활성화
             }
-            // 이벤트 시스템
-            else if(strcmp(interactionZone.name, "blockedDoor") == 0 ||
-                    strcmp(interactionZone.name, "frige") == 0 ||
-                    strcmp(interactionZone.name, "bed") == 0 || 
-                    strcmp(interactionZone.name, "toDo") == 0 ||
-                    strcmp(interactionZone.name, "Toilet") == 0){
-                handleEvent(interactions[i].eventID);
-
-                // 이벤트 ID와 좌표를 기반으로 애니메이션 추가
-                tileAnimation newAnimation;
-                animationCount = 0; // 이러면 Animation 배열로 하는 의미가 없지만 일단 귀찮으니 패스
-                newAnimation.eventID = interactions[i].eventID;
-                newAnimation.x = interactions[i].x;
-                newAnimation.y = interactions[i].y;
-                newAnimation.frameCount = loadAnimationFrames(newAnimation.eventID, &newAnimation.frames, renderer);
-
-                if(newAnimation.frameCount > 0){
-                    newAnimation.currentFrame = 0;
-                    newAnimation.frameDuration = 50;   // 각 프레임 지속 시간 (예: 100ms)
-                    newAnimation.lastFrameTime = 0;    // 초기화
-                    newAnimation.isActive = SDL_FALSE; // 비활성화 상태로 시작
-                    newAnimation.isFreezed = SDL_FALSE;
-                    newAnimation.isFinished = SDL_FALSE;
-
-                    // 배열에 추가
-                    animations[animationCount++] = newAnimation;
-                    printf("Interaction %s triggered. Animation initialized in animations[%d]\n", interactionZone.name, animationCount++);
-                }
-                char eventFileName[16];
-                snprintf(eventFileName, sizeof(eventFileName), "%d", interactions[i].eventID);
-                loadNPCDialogue(eventFileName);  // 대화 로드
+        }
+        // 이벤트 시스템
+        else if(interactionZone.type == INTERACTION_EVENT){
+            // 애니메이션 시트와 대화 JSON을 로더에 요청하고, 준비되면 updatePendingEvent에서 이벤트 시작 (게임이 파일 읽기로 멈추지 않음)
+            if(world->pendingEventInteraction == -1){
+                recordPrefetchResult(game, i);
+
+                char filePath[64];
+                snprintf(filePath, sizeof(filePath), "resource/eventID/%d.png", interactions[i].eventID);
+                world->pendingEventSheet = requestAsset(filePath, ASSET_TEXTURE);
+                snprintf(filePath, sizeof(filePath), "resource/eventID/%d.json", interactions[i].eventID);
+                world->pendingEventDialogue = requestAsset(filePath, ASSET_JSON);
+                world->pendingEventInteraction = i;
             }
         }
     }
 }
 
+// 기다리던 이벤트 취소 (핫 리로드로 상호작용 인덱스가 바뀔 때)
+void cancelPendingEvent(GameContext *game){
+    WorldState *world = &game->world;
+    if(world->pendingEventInteraction == -1) return;
+    releaseAsset(world->pendingEventSheet);
+    releaseAsset(world->pendingEventDialogue);
+    world->pendingEventSheet = ASSET_NONE;
+    world->pendingEventDialogue = ASSET_NONE;
+    world->pendingEventInteraction = -1;
+}
+
+// 프레임마다 호출: 이벤트 에셋이 준비되면 이벤트 시작 (애니메이션 추가, 대화 로드), 시작했으면 SDL_TRUE
+SDL_bool updatePendingEvent(GameContext *game){
+    WorldState *world = &game->world;
+    tileAnimation *animations = world->animations;
+    if(world->pendingEventInteraction == -1) return SDL_FALSE;
+    if(!isAssetSettled(world->pendingEventSheet) || !isAssetSettled(world->pendingEventDialogue)) return SDL_FALSE;
+
+    int i = world->pendingEventInteraction;
+    world->pendingEventInteraction = -1;
+
+    markEventFlag(game, interactions[i].eventID);
+    handleEvent(game, interactions[i].eventID);
+
+    // 이벤트 ID와 좌표를 기반으로 애니메이션 추가
+    tileAnimation newAnimation;
+    freeAnimations(animations, world->animationCount); // 이전 이벤트 시트 반납
+    world->animationCount = 0; // 이러면 Animation 배열로 하는 의미가 없지만 일단 귀찮으니 패스
+    newAnimation.eventID = interactions[i].eventID;
+    newAnimation.x = interactions[i].x;
+    newAnimation.y = interactions[i].y;
+    newAnimation.sheet = getAssetTexture(world->pendingEventSheet);
+    newAnimation.sheetAsset = world->pendingEventSheet;
+    newAnimation.frameCount = 0;
+
+    if(newAnimation.sheet != NULL){
+        int sheetWidth;
+        SDL_QueryTexture(newAnimation.sheet, NULL, NULL, &sheetWidth, NULL);
+        newAnimation.frameCount = sheetWidth / 24; // 24x24 프레임
+    }
+
+    if(newAnimation.frameCount > 0){
+        newAnimation.currentFrame = 0;
+        newAnimation.frameDuration = 50;   // 각 프레임 지속 시간 (예: 100ms)
+        newAnimation.lastFrameTime = 0;    // 초기화
+        newAnimation.isFrameDue = SDL_FALSE;
+        newAnimation.frameTimer = -1;
+        newAnimation.isActive = SDL_FALSE; // 비활성화 상태로 시작
+        newAnimation.isFreezed = SDL_FALSE;
+        newAnimation.isFinished = SDL_FALSE;
+
+        // 배열에 추가
+        animations[world->animationCount++] = newAnimation;
+        LOG_DEBUG(LOG_CORE, "Interaction %s triggered. Animation initialized in animations[%d]", interactions[i].name, world->animationCount - 1);
+    }
+    else{
+        releaseAsset(world->pendingEventSheet);
+    }
+
+    // 대화 로드
+    cJSON *dialogueJson = getAssetJson(world->pendingEventDialogue);
+    if(dialogueJson != NULL){
+        parseNPCDialogue(game->ui.dialogues, dialogueJson);
+        game->ui.currentDialogueEvent = interactions[i].eventID;
+        markDialogueNode(game, interactions[i].eventID, 0);
+    }
+    releaseAsset(world->pendingEventDialogue);
+    world->pendingEventSheet = ASSET_NONE;
+    world->pendingEventDialogue = ASSET_NONE;
+    return SDL_TRUE;
+}
+
+// 기다리던 이벤트의 에셋을 그 자리에서 받음 (시뮬레이션, 리플레이: 진행이 디스크 속도에 따라 달라지지 않도록)
+// 로더가 읽는 동안은 로더가 깨울 때까지 잠들고, 디코딩이 끝난 이미지는 여기서 텍스처로 올림
+void waitForPendingEvent(GameContext *game){
+    WorldState *world = &game->world;
+    while(world->pendingEventInteraction != -1){
+        processAssetUploads(ASSET_UPLOADS_PER_FRAME);
+        if(!isAssetSettled(world->pendingEventSheet)){
+            waitForAssetLoader(world->pendingEventSheet, ASSET_WAIT_TIMEOUT);
+        }
+        else if(!isAssetSettled(world->pendingEventDialogue)){
+            waitForAssetLoader(world->pendingEventDialogue, ASSET_WAIT_TIMEOUT);
+        }
+        else{
+            break;
+        }
+    }
+}
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
 // 에러 메시지 박스를 띄우고 프로그램을 종료하는 함수
 void showErrorAndExit(const char* title, const char* errorMessage){
     // 콘솔 출력
-    printf("%s: %s\n", title, errorMessage);
+    LOG_ERROR(LOG_CORE, "%s: %s", title, errorMessage);
+    flushLog(); // 메시지 박스가 떠 있는 동안에도 콘솔에 보이도록
     
-    // SDL 내장 메시지 박스
-    // SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, title, errorMessage, NULL);
-
+#ifdef _WIN32
     // 윈도우API 메시지 박스
     MessageBoxA(NULL, errorMessage, title, MB_ICONERROR | MB_OK);
+#else
+    // SDL 내장 메시지 박스 (디스플레이가 없으면 실패하지만 콘솔에는 이미 출력됨)
+    SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, title, errorMessage, NULL);
+#endif
 
     // SDL 종료 (필요한 경우)
     SDL_Quit();
@@ -215,23 +269,257 @@ void updateFPS(){
     }
 }
 
+// 파일 전체를 읽어서 NUL로 끝나는 버퍼로 반환 (팩에 있으면 팩에서)
 char* readFile(const char* filename){
-    FILE *file = fopen(filename, "rb");
+    SDL_RWops *file = openAssetFile(filename);
     if(!file) return NULL;
 
-    fseek(file, 0, SEEK_END);
-    long length = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    Sint64 length = SDL_RWsize(file);
+    if(length < 0){
+        SDL_RWclose(file);
+        return NULL;
+    }
 
-    char *data = (char*)malloc(length + 1);
-    fread(data, 1, length, file);
+    char *data = (char*)MEM_ALLOC(MEM_CORE, length + 1);
+    SDL_RWread(file, data, 1, (size_t)length);
     data[length] = '\0';
 
-    fclose(file);
+    SDL_RWclose(file);
     return data;
 }
 
+// 화면이 시간에 따라 스스로 바뀌지 않는 상태인지 (플레이어 정지, 카메라 정착, NPC/미니게임 없음)
+// 로더 스레드는 끝나도 메인 루프를 깨우지 않으므로, 기다리는 이벤트나 읽는 중 / 업로드 대기 중인 에셋이 있으면 잠들지 않음
+SDL_bool isWorldIdle(GameContext *game){
+    if(game->world.pendingEventInteraction != -1 || getAssetProgress() < 1.0f) return SDL_FALSE;
+    return game->player.velocityX == 0.0f && game->player.velocityY == 0.0f && game->world.entities.count == 0 &&
+           !game->ui.isMiniGameActive && isCameraSettled(game);
+}
+
+// 맵, 상점 목록, NPC 배치 지점을 다 읽은 뒤 판 시작 (창 모드와 리플레이 공용)
+void startGame(GameContext *game, Uint32 currentTime, int stressNPCCount){
+    initGameContext(game, currentTime);
+    game->clock.lastTime = 0; // 첫 프레임의 긴 델타는 물리 누적 상한에서 버려짐 (예전과 같음)
+    if(stressNPCCount > 0){
+        spawnWanderingNPCs(game, stressNPCCount, npcSpriteSheet);
+    }
+
+    // 임시 키 안내
+    showText(game, "이동: WASD,   상호작용: E,   확인: Z,   띵동대쉬: Spacebar", 10000); // 10초 동안 표시
+}
+
+// 프레임 하나 진행: UI 입력 -> 타이머 -> 고정 틱 물리 -> 이벤트 -> 카메라 (입력 버퍼는 updateInputFrame으로 확정된 뒤)
+// 시간은 currentTime 하나만 써서 같은 입력과 시간이면 같은 결과가 나옴 (리플레이가 이 함수로 다시 돌림)
+// 기다리던 이벤트가 이번 프레임에 시작됐으면 SDL_TRUE
+SDL_bool updateGameFrame(GameContext *game, Uint32 currentTime, EventStartMode eventStart){
+    const float physicsStep = 1.0f / physicsTickRate; // 물리 틱 하나의 길이 (초)
+
+    // 현재 시간과 마지막 시간을 기준으로 델타 타임 계산
+    GameClock *clock = &game->clock;
+    clock->time = currentTime;
+    float deltaTime = (currentTime - clock->lastTime) / 1000.0f; // 초 단위로 델타 타임 계산
+    clock->lastTime = currentTime;
+
+    PROFILE_BEGIN(PROFILE_INPUT);
+    UIState *ui = &game->ui;
+    if(!ui->isShopVisible && !ui->isMiniGameActive && !ui->isDialogueActive){
+        handleInput(game);
+    }
+    else{
+        game->player.velocityX = 0.0f; // UI가 열려 있는 동안은 제자리에 멈춤
+        game->player.isMoving = 0;
+    }
+    if(ui->isShopVisible){
+        handleShopInput(game);
+    }
+    if(ui->isMiniGameActive){
+        updateMiniGame(game);
+    }
+    if(ui->isDialogueActive){
+        handleChoiceInput(game);
+    }
+    PROFILE_END(PROFILE_INPUT);
+
+    PROFILE_BEGIN(PROFILE_ANIMATION);
+    advanceTimers(game, clock->time); // 마감된 타이머 처리 (입력 처리 뒤라서 마감 직전 입력도 먼저 반영됨)
+    updateAnimations(game);
+    PROFILE_END(PROFILE_ANIMATION);
+    // 고정 틱으로 물리 진행 (프레임 시간이 길어도 틱 단위로 나눠서 처리)
+    PROFILE_BEGIN(PROFILE_PHYSICS);
+    clock->physicsAccumulator += deltaTime;
+    if(clock->physicsAccumulator > physicsStep * MAX_PHYSICS_STEPS){
+        clock->physicsAccumulator = physicsStep * MAX_PHYSICS_STEPS; // 로딩 직후 같은 긴 프레임은 버림
+    }
+    while(clock->physicsAccumulator >= physicsStep){
+        updatePhysics(game, physicsStep);
+        updateTriggers(game);
+        clock->physicsAccumulator -= physicsStep;
+    }
+    processTriggerEvents(game);
+    PROFILE_END(PROFILE_PHYSICS);
+    PROFILE_BEGIN(PROFILE_ASSETS);
+    updatePrefetch(game);
+    SDL_bool eventStarted = SDL_FALSE;
+    if(eventStart == EVENT_START_NOW){
+        waitForPendingEvent(game);
+    }
+    if(eventStart != EVENT_START_HOLD){
+        eventStarted = updatePendingEvent(game);
+    }
+    processAssetUploads(ASSET_UPLOADS_PER_FRAME);
+    updateMusic(game);
+    PROFILE_END(PROFILE_ASSETS);
+    clock->physicsAlpha = clock->physicsAccumulator / physicsStep;
+    updateFrame(game);
+    PROFILE_BEGIN(PROFILE_CAMERA);
+    updateCamera(game, deltaTime);
+    PROFILE_END(PROFILE_CAMERA);
+    return eventStarted;
+}
+
+// 벤치마크(tools/benchmark.c)는 이 파일을 통째로 포함하고 자기 main을 씀
+#ifndef DINGDONG_NO_MAIN
+// 창에 보이는 판 (플레이어, 카메라, UI 등 판마다 바뀌는 상태는 전부 GameContext 안에)
+static GameContext mainGame;
+
 int main(int argc, char* argv[]){
+    GameContext *game = &mainGame;
+    int stressNPCCount = 0; // --npcs=N: 배회 NPC N명 추가 (스트레스 테스트용)
+    int jobWorkers = 0;     // --workers=N: 잡 워커 수 (0이면 코어 수, 1이면 단일 스레드)
+    SDL_bool profileOnStart = SDL_FALSE;
+    SDL_bool newGame = SDL_FALSE;  // --newgame: 세이브가 있어도 처음부터
+    initLogger();
+    initMemoryTracking();
+
+    // 실행 인자 처리 (--tickrate=30 처럼 물리 틱 수를 낮춰 CPU 사용량을 줄일 수 있음)
+    for(int i = 1; i < argc; i++){
+        if(strncmp(argv[i], "--tickrate=", 11) == 0){
+            int rate = atoi(argv[i] + 11);
+            if(rate >= 10 && rate <= 1000){
+                physicsTickRate = rate;
+            }
+        }
+        else if(strncmp(argv[i], "--npcs=", 7) == 0){
+            stressNPCCount = atoi(argv[i] + 7);
+        }
+        else if(strncmp(argv[i], "--workers=", 10) == 0){
+            jobWorkers = atoi(argv[i] + 10);
+        }
+        else if(strncmp(argv[i], "--audiobuffer=", 14) == 0){
+            audioBufferSamples = atoi(argv[i] + 14);
+        }
+        else if(strncmp(argv[i], "--soundcache=", 13) == 0){
+            soundCacheBudget = atoi(argv[i] + 13) * 1024;
+        }
+        else if(strncmp(argv[i], "--prefetchradius=", 17) == 0){
+            prefetchRadius = (float)atof(argv[i] + 17);
+        }
+        else if(strncmp(argv[i], "--loglevel=", 11) == 0){
+            setLogLevel(argv[i] + 11); // debug, info, warn, error
+        }
+        else if(strncmp(argv[i], "--hitchbudget=", 14) == 0){
+            hitchBudget = (float)atof(argv[i] + 14); // 이보다 긴 프레임은 보고서로 남김 (0이면 끔)
+        }
+        else if(strcmp(argv[i], "--profile") == 0){
+            profileOnStart = SDL_TRUE; // 처음부터 기록하고 종료할 때 profile_trace.json 저장
+        }
+        else if(strcmp(argv[i], "--hotreload") == 0){
+            hotReloadEnabled = SDL_TRUE; // 개발용: tile, resource/eventID 파일이 바뀌면 다시 읽음
+        }
+        else if(strcmp(argv[i], "--telemetry") == 0){
+            telemetryEnabled = SDL_TRUE; // 공유 메모리로 카운터 게시 (tools/telemetryReader로 확인)
+        }
+        else if(strncmp(argv[i], "--telemetrysocket", 17) == 0){
+            telemetryEnabled = SDL_TRUE; // 공유 메모리와 같이 UNIX 소켓으로도 게시
+            const char *path = argv[i][17] == '=' ? argv[i] + 18 : TELEMETRY_SOCKET_PATH;
+            strncpy(telemetrySocketPath, path, sizeof(telemetrySocketPath) - 1);
+        }
+        else if(strncmp(argv[i], "--simulate", 10) == 0){
+            simulateEnabled = SDL_TRUE; // 창 없이 가상 시계로 게임 로직만 돌리고 도달률 보고
+            if(argv[i][10] == '=') strncpy(simulateScript, argv[i] + 11, sizeof(simulateScript) - 1);
+        }
+        else if(strncmp(argv[i], "--tiles=", 8) == 0){
+            strncpy(mapDirectory, argv[i] + 8, sizeof(mapDirectory) - 1);
+        }
+        else if(strncmp(argv[i], "--simticks=", 11) == 0){
+            simulateTickLimit = atoi(argv[i] + 11);
+        }
+        else if(strncmp(argv[i], "--simthreads=", 13) == 0){
+            simulateThreads = atoi(argv[i] + 13); // 같은 시뮬레이션을 스레드마다 따로 동시에 돌려서 결과 비교
+        }
+        else if(strncmp(argv[i], "--record=", 9) == 0){
+            strncpy(replayRecordPath, argv[i] + 9, sizeof(replayRecordPath) - 1); // 입력 녹화 (--replay로 재생)
+        }
+        else if(strncmp(argv[i], "--replay=", 9) == 0){
+            strncpy(replayPath, argv[i] + 9, sizeof(replayPath) - 1); // 녹화한 입력을 소프트웨어 렌더러로 재생하고 종료
+        }
+        else if(strncmp(argv[i], "--golden=", 9) == 0){
+            strncpy(replayGoldenPath, argv[i] + 9, sizeof(replayGoldenPath) - 1); // 재생한 화면 해시와 비교할 파일
+        }
+        else if(strcmp(argv[i], "--writegolden") == 0){
+            replayWriteGolden = SDL_TRUE; // 비교하지 않고 --golden 파일을 새로 씀
+        }
+        else if(strncmp(argv[i], "--replayreport=", 15) == 0){
+            strncpy(replayReportPath, argv[i] + 15, sizeof(replayReportPath) - 1);
+        }
+        else if(strncmp(argv[i], "--save=", 7) == 0){
+            strncpy(savePath, argv[i] + 7, sizeof(savePath) - 1);
+        }
+        else if(strncmp(argv[i], "--autosave=", 11) == 0){
+            autosaveInterval = atoi(argv[i] + 11); // 자동 저장 간격 (초, 0이면 끔)
+        }
+        else if(strcmp(argv[i], "--nosave") == 0){
+            savesEnabled = SDL_FALSE;
+        }
+        else if(strcmp(argv[i], "--newgame") == 0){
+            newGame = SDL_TRUE;
+        }
+    }
+    // 녹화, 재생 중에 맵이 바뀌면 같은 입력으로 같은 결과가 나오지 않음
+    // 세이브를 읽거나 자동 저장해도 녹화와 재생의 시작 상태가 달라짐
+    if(replayRecordPath[0] != '\0' || replayPath[0] != '\0'){
+        hotReloadEnabled = SDL_FALSE;
+        savesEnabled = SDL_FALSE;
+    }
+    // 재생은 창 없이 (SDL_VIDEODRIVER를 직접 지정하면 그대로 씀) 소프트웨어 렌더러로 그려서 화면 해시가 GPU에 따라 달라지지 않도록
+    if(replayPath[0] != '\0'){
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+
+    // 시뮬레이션: 창, 렌더러, 오디오 없이 월드만 구축해서 돌림 (텍스처는 읽지 않음)
+    if(simulateEnabled){
+        SDL_Init(0);
+        initJobSystem(jobWorkers);
+        openPack("data.pak");
+        initAssets();
+        int mapCount = loadMapsFromDirectory(mapDirectory, maps, MAX_MAPCOUNT);
+        while(getAssetProgress() < 1.0f){
+            processAssetUploads(ASSET_UPLOADS_PER_FRAME);
+            SDL_Delay(1);
+        }
+        currentMapCount = mapCount;
+        int result = 1;
+        if(mapCount > 0 && buildWorld(maps, mapCount)){
+            if(simulateThreads > 1){
+                result = runParallelSimulations(simulateScript, simulateTickLimit, simulateThreads);
+            }
+            else{
+                result = runSimulation(simulateScript, simulateTickLimit, NULL);
+            }
+        }
+        freeInteractions();
+        freeMapData(maps, MAX_MAPCOUNT);
+        shutdownAssets();
+        shutdownJobSystem();
+        closePack();
+        reportMemoryLeaks();
+        shutdownLogger();
+        SDL_Quit();
+        return result;
+    }
+
     SDL_Init(SDL_INIT_VIDEO);
     IMG_Init(IMG_INIT_PNG);
     if(SDL_Init(SDL_INIT_VIDEO) != 0){
@@ -250,98 +538,100 @@ int main(int argc, char* argv[]){
         showErrorAndExit("I think your speakers need some break", SDL_GetError());
     }
 
-    if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 4096) < 0){
+    if(openAudioDevice() < 0){
         showErrorAndExit("No Minecraft on library computer", Mix_GetError());
     }
 
-    SDL_Window* window = SDL_CreateWindow("DingDongDash", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-
-    SDL_Surface* tempSurface = IMG_Load("resource\\walk and idle.png");
-    printf("sprite loaded!\n");
-    if(!tempSurface){
-        showErrorAndExit("WHO TOUCH THE SPRITE FILE!?", IMG_GetError());
-    }
-    
-    spriteSheet = SDL_CreateTextureFromSurface(renderer, tempSurface);
-    SDL_FreeSurface(tempSurface);
+    initJobSystem(jobWorkers);
 
-    TTF_Font *font = TTF_OpenFont("resource\\The Jamsil.ttf", 24);
+    SDL_Window* window = SDL_CreateWindow("DingDongDash", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
+    renderer = SDL_CreateRenderer(window, -1, replayPath[0] != '\0' ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
+
+    // 첫 프레임부터 로딩 화면을 띄우고 파일은 로더 스레드가 읽음
+    renderLoadingScreen(renderer, 0.0f);
+    Uint32 loadingStartTime = SDL_GetTicks();
+    openPack("data.pak"); // 없으면 개별 파일에서 읽음 (tools/packBuilder로 생성)
+    initAssets();
+    AssetHandle spriteAsset = requestAsset("resource/walk and idle.png", ASSET_TEXTURE);
+    AssetHandle tilesetAsset = requestAsset("resource/Tileset00.png", ASSET_TEXTURE);
+    AssetHandle npcAsset = requestAsset("resource/npcType1.png", ASSET_TEXTURE);
+    int mapCount = loadMapsFromDirectory(mapDirectory, maps, MAX_MAPCOUNT);
+
+    TTF_Font *font = TTF_OpenFontRW(openAssetFile("resource/The Jamsil.ttf"), 1, 24);
     if(!font){
         showErrorAndExit("WHO TOUCH THE FONT FILE!?", TTF_GetError());
     }
     
-    tilesetTexture = loadTexture("resource\\Tileset00.png", renderer);
-
-    // JSON 파일 불러오기
-    int mapCount = loadMapsFromDirectory("tile", maps, MAX_MAPCOUNT);
-    if(mapCount <= 0){
-        showErrorAndExit("WHO TOUCH THE TILE FILE!?", "Error loading maps from directory");
-    }
-    for(int i = 0; i < mapCount; i++){
-        if(maps[i].mapJson == NULL){
-            printf("Error parsing JSON for map %d\n", i);
-            continue;
-        }
 
-        // 맵 크기와 타일 크기 추출
-        cJSON *width = cJSON_GetObjectItem(maps[i].mapJson, "width");
-        cJSON *height = cJSON_GetObjectItem(maps[i].mapJson, "height");
-        cJSON *tileWidthItem = cJSON_GetObjectItem(maps[i].mapJson, "tilewidth");
-        cJSON *tileHeightItem = cJSON_GetObjectItem(maps[i].mapJson, "tileheight");
+    // 효과음은 맵보다 먼저 로드 (상호작용 SE 이름을 로딩 때 SoundID로 바꿔두기 위해)
+    // UI
+    canselSound = loadSoundEffect("resource/audio/[SE]cansel.wav", "cansel", 64);
+    loadSoundEffect("resource/audio/[SE]clickShort.wav", "clickShort", 64);
 
-        if(!cJSON_IsNumber(width) || !cJSON_IsNumber(height) ||
-            !cJSON_IsNumber(tileWidthItem) || !cJSON_IsNumber(tileHeightItem)){
-            printf("Error in map dimensions for map %d\n", i);
-            continue;
+    // Movement
+    doorBellSound = loadSoundEffect("resource/audio/[SE]doorBell.wav", "doorBell", 64);
+    loadSoundEffect("resource/audio/[SE]doorOpen.wav", "doorOpen", 64);
+    loadSoundEffect("resource/audio/[SE]doorClose.wav", "doorClose", 64);
+    loadSoundEffect("resource/audio/[SE]slideDoorOpen.wav", "slideDoorOpen", 64);
+    registerCompressedSound("resource/audio/[SE]elevator.wav", "elevator", 64);
+    registerCompressedSound("resource/audio/[SE]stair.wav", "stair", 64);
+
+    // Object (가끔 나는 소리는 처음 재생할 때 디코딩해서 캐시에 올림)
+    cashSound = loadSoundEffect("resource/audio/[SE]cash.wav", "cash", 64);
+    registerCompressedSound("resource/audio/[SE]paper.wav", "paper", 64);
+    registerCompressedSound("resource/audio/[SE]flushed.wav", "flushed!", 64);
+
+    // 동시 재생 상한 / 우선순위 / 최소 간격 (띵동 연타가 채널을 다 차지하지 않도록)
+    setSoundVoiceLimit(doorBellSound, 3, 0, 30);
+    setSoundVoiceLimit(canselSound, 1, 2, 0);
+    setSoundVoiceLimit(cashSound, 1, 2, 0);
+    setSoundVoiceLimit(findSound("clickShort"), 1, 2, 0);
+    setSoundVoiceLimit(findSound("doorOpen"), 2, 2, 0);
+    setSoundVoiceLimit(findSound("doorClose"), 2, 2, 0);
+
+    // 요청한 에셋이 모두 준비될 때까지 로딩 화면 (텍스처는 프레임마다 몇 개씩 업로드)
+    while(getAssetProgress() < 1.0f){
+        SDL_Event loadingEvent;
+        while(SDL_PollEvent(&loadingEvent)){
+            if(loadingEvent.type == SDL_QUIT) running = SDL_FALSE;
         }
+        processAssetUploads(ASSET_UPLOADS_PER_FRAME);
+        renderLoadingScreen(renderer, getAssetProgress());
+        SDL_Delay(1);
+    }
 
-        maps[i].mapWidth = width->valueint;
-        maps[i].mapHeight = height->valueint;
-        maps[i].tileWidth = tileWidthItem->valueint;
-        maps[i].tileHeight = tileHeightItem->valueint;
-
-        printf("Map %d - Width: %d, Height: %d, Tile Width: %d, Tile Height: %d\n",
-               i, maps[i].mapWidth, maps[i].mapHeight, maps[i].tileWidth, maps[i].tileHeight);
-
-        int xOffset = i * 984; // 24x24 기준
-        int yOffset = 0;
-        parseObjectGroups(&maps[i], xOffset, yOffset); // 오브젝트 그룹 초기화
-        // 타일 데이터 파싱
-        unsigned int *tileData = parseTileData(&maps[i]);
-        if(tileData == NULL){
-            printf("Error parsing tile data\n");
-            return -1;
-        }
+    LOG_INFO(LOG_CORE, "Assets loaded in %u ms (%s)", SDL_GetTicks() - loadingStartTime, isPackOpen() ? "pack" : "loose files");
 
-        /*
-        // 타일 데이터를 출력 (디버깅용)
-        for(int i = 0; i < maps[i].mapWidth * maps[i].mapHeight; i++){
-            printf("Tile %d: %u\n", i, tileData[i]);
-        }
-        */
+    spriteSheet = getAssetTexture(spriteAsset);
+    if(!spriteSheet){
+        showErrorAndExit("WHO TOUCH THE SPRITE FILE!?", IMG_GetError());
     }
-    
-    Mix_AllocateChannels(16);
-    // UI
-    loadSoundEffect("resource\\audio\\[SE]cansel.wav", "cansel", 64);
-    loadSoundEffect("resource\\audio\\[SE]clickShort.wav", "clickShort", 64);
-
-    // Movement
-    loadSoundEffect("resource\\audio\\[SE]doorBell.wav", "doorBell", 64);
-    loadSoundEffect("resource\\audio\\[SE]doorOpen.wav", "doorOpen", 64);
-    loadSoundEffect("resource\\audio\\[SE]doorClose.wav", "doorClose", 64);
-    loadSoundEffect("resource\\audio\\[SE]slideDoorOpen.wav", "slideDoorOpen", 64);
-    loadSoundEffect("resource\\audio\\[SE]elevator.wav", "elevator", 64);
-    loadSoundEffect("resource\\audio\\[SE]stair.wav", "stair", 64);
-
-    // Object
-    loadSoundEffect("resource\\audio\\[SE]cash.wav", "cash", 64);
-    loadSoundEffect("resource\\audio\\[SE]paper.wav", "paper", 64);
-    loadSoundEffect("resource\\audio\\[SE]flushed.wav", "flushed!", 64);
+    LOG_DEBUG(LOG_CORE, "sprite loaded!");
+    tilesetTexture = getAssetTexture(tilesetAsset);
+    if(!tilesetTexture){
+        showErrorAndExit("WHO TOUCH THE IMAGE FILE!?", IMG_GetError());
+    }
+    npcSpriteSheet = getAssetTexture(npcAsset);
 
+    // JSON 파일 불러오기
+    currentMapCount = mapCount;
+    if(mapCount <= 0){
+        showErrorAndExit("WHO TOUCH THE TILE FILE!?", "Error loading maps from directory");
+    }
+    if(!buildWorld(maps, mapCount)){
+        return -1;
+    }
+    initHotReload();
+    if(savesEnabled){
+        initSaveSystem();
+    }
+    initHitchDetector();
+    initTelemetry();
+    initProfiler();
+    if(profileOnStart){
+        setProfilerEnabled(SDL_TRUE);
+    }
     SDL_Event event;
-    const Uint8* state = SDL_GetKeyboardState(NULL);
 
     fpsStartTime = SDL_GetTicks(); // FPS 확인용
 
@@ -349,41 +639,73 @@ int main(int argc, char* argv[]){
     Uint32 debugLastTime = 0;  // 처음에는 0으로 초기화
     Uint32 currentTime = SDL_GetTicks();  // 현재 시간 가져오기
 
-    // 임시 키 안내
-    activeTextDisplay.text = "이동: WASD,   상호작용: E,   확인: Z,   띵동대쉬: Spacebar";
-    activeTextDisplay.startTime = currentTime;
-    activeTextDisplay.duration = 10000; // 10초 동안 표시
+    // 맵, 상점 목록, NPC 배치 지점을 다 읽었으니 판 시작 (재생이면 창 루프 대신 리플레이를 돌림)
+    int exitCode = 0;
+    if(replayPath[0] != '\0'){
+        exitCode = runReplay(game, renderer, maps, mapCount, font);
+        running = SDL_FALSE;
+    }
+    else{
+        startGame(game, currentTime, stressNPCCount);
+        if(!newGame){
+            loadGame(game); // 세이브가 있으면 이어함
+        }
+        startAutosave(game);
+        startReplayRecording(game, stressNPCCount);
+    }
 
-    while(running){
+    while(running && !game->quitRequested){
+        // 아무것도 움직이지 않으면 다음 타이머 마감이나 입력이 올 때까지 잠듦 (오버레이가 떠 있으면 계속 그림)
+        if(isWorldIdle(game) && !profilerOverlayVisible){
+            Uint32 wait = getNextTimerDelay(game);
+            if(wait > IDLE_MAX_WAIT) wait = IDLE_MAX_WAIT;
+            if(SDL_WaitEventTimeout(&event, wait)){
+                if (event.type == SDL_QUIT) running = SDL_FALSE;
+                recordInputEvent(game, &event);
+            }
+        }
+        beginHitchFrame();
+        PROFILE_BEGIN(PROFILE_INPUT);
         while(SDL_PollEvent(&event)){
             if (event.type == SDL_QUIT) running = SDL_FALSE;
+            recordInputEvent(game, &event);
         }
+        updateInputFrame(game);
+        pollHotReload(game); // 바뀐 맵/대화 파일을 프레임 사이에 반영
 
-        // 현재 시간과 마지막 시간을 기준으로 델타 타임 계산
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f; // 초 단위로 델타 타임 계산
-        lastTime = currentTime;
-
-        if(!isShopVisible && !isMiniGameActive && !isDialogueActive){
-            handleInput(state, deltaTime, font);
+        // F3: 프로파일러 오버레이, F4: 크롬 추적 파일 저장
+        if(wasKeyPressed(game, SDL_SCANCODE_F3)){
+            profilerOverlayVisible = !profilerOverlayVisible;
+            setProfilerEnabled(profilerOverlayVisible || profileOnStart);
         }
-        if(isShopVisible){
-            handleShopInput(&shop, &playerGold);
+        if(wasKeyPressed(game, SDL_SCANCODE_F4) && profilerEnabled){
+            exportProfileTrace("profile_trace.json");
         }
-        if(isMiniGameActive){
-            updateMiniGame(font);
+        // F5: 분야별 메모리 사용량
+        if(wasKeyPressed(game, SDL_SCANCODE_F5)){
+            dumpMemoryUsage();
         }
-        if(isDialogueActive){
-            handleChoiceInput(&dialogues[dialogues->currentID], &selectedOption);
-        }
-        for(int i = 0; i < animationCount; i++){
-            updateAnimation(&animations[i]);
+        // F6: 지금 저장, F7: 세이브 다시 읽기 (대화, 상점, 미니게임 중에는 무시)
+        if(!game->ui.isDialogueActive && !game->ui.isShopVisible && !game->ui.isMiniGameActive){
+            if(wasKeyPressed(game, SDL_SCANCODE_F6) && requestSave(game, SDL_FALSE)){
+                showText(game, "저장했습니다", 1500);
+            }
+            if(wasKeyPressed(game, SDL_SCANCODE_F7) && loadGame(game)){
+                showText(game, "세이브를 불러왔습니다", 1500);
+            }
         }
-        updatePhysics();
-        updateFrame();
-        updateCamera(deltaTime);
-        render(renderer, maps, mapCount, activeTextDisplay.text, font);
+
+        PROFILE_END(PROFILE_INPUT);
+
+        Uint32 currentTime = SDL_GetTicks();
+        SDL_bool eventStarted = updateGameFrame(game, currentTime, EVENT_START_WHEN_READY);
+        recordReplayFrame(game, currentTime, eventStarted);
+        render(game, renderer, maps, mapCount, font);
         updateFPS();
+        endProfileFrame();
+        endMemoryFrame();
+        endHitchFrame();
+        updateTelemetry(game);
 
         // FPS 제한 (120)
         Uint32 frameTicks = SDL_GetTicks() - currentTime;
@@ -394,27 +716,51 @@ int main(int argc, char* argv[]){
         // 디버깅용
         currentTime = SDL_GetTicks();  // 현재 시간 업데이트
         if(currentTime - debugLastTime > 2000){  // 1000ms (1초) 이상 차이 나면
-            printf("playerX / Y: %.3f / %.3f  |   camera.x: %.3f   |   FPS: %.2f\n", playerX, playerY, cameraX, fps);
-            printf("playerRect.x / y / w: %d / %d / %d  |  platformCount: %d\n", playerRect.x, playerRect.y, playerRect.w, platformCount);
+            LOG_DEBUG(LOG_CORE, "playerX / Y: %.3f / %.3f  |   camera.x: %.3f   |   FPS: %.2f", game->player.x, game->player.y, game->camera.x, fps);
+            LOG_DEBUG(LOG_CORE, "playerRect.x / y / w: %d / %d / %d  |  platformCount: %d", game->player.rect.x, game->player.rect.y, game->player.rect.w, platformCount);
+            LOG_DEBUG(LOG_CORE, "input latency last / avg / max: %u / %.1f / %u ms", game->input.latencyLast, game->input.latencyAverage, game->input.latencyMax);
+            LOG_DEBUG(LOG_CORE, "sound latency: %.1f ms (buffer %d samples), voices dropped / stolen: %d / %d, sound cache: %d KB", getSoundLatency(), audioBufferSamples, voicesDropped, voicesStolen, soundCacheBytes / 1024);
+            LOG_DEBUG(LOG_CORE, "hitches over %.1f ms: %d", hitchBudget, hitchCount);
+            LOG_DEBUG(LOG_CORE, "prefetch radius %.0f: hit / late / miss: %d / %d / %d (%d requests)", prefetchRadius,
+                      game->world.prefetch.hits, game->world.prefetch.late, game->world.prefetch.misses, game->world.prefetch.requests);
             debugLastTime = currentTime;  // 마지막 시간 업데이트
         }
         if(event.type == SDL_QUIT){  // X 버튼을 누른 경우
             running = SDL_FALSE;  // SDL_BOOL에서 SDL_FALSE 사용
         }
     }
+    if(profileOnStart){
+        exportProfileTrace("profile_trace.json");
+    }
+    stopReplayRecording();
+    requestSave(game, SDL_TRUE); // 종료할 때 마지막 상태 저장 (--nosave, 녹화, 재생이면 안 함)
+    shutdownSaveSystem(); // 쓰는 중인 세이브를 다 쓸 때까지 기다림
     // 메모리 해제
-    SDL_DestroyTexture(spriteSheet);
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    shutdownTelemetry();
+    shutdownHotReload();
     for(int i = 0; i < MAX_MAPCOUNT; i++){
-        cJSON_Delete(maps[i].mapJson);
-    }
-    if(tileData != NULL){
-        free(tileData);
+        // 핫 리로드로 다시 읽은 맵 JSON은 에셋이 아니라 맵이 가지고 있음
+        if(maps[i].asset == ASSET_NONE && maps[i].mapJson != NULL){
+            cJSON_Delete(maps[i].mapJson);
+            maps[i].mapJson = NULL;
+        }
     }
+    freeInteractions();
+    freeMapData(maps, MAX_MAPCOUNT);
+    closeCachedFonts();
+    TTF_CloseFont(font);
+    shutdownAssets(); // 스프라이트, 타일셋, 맵 JSON 등 로더가 가진 것 전부 해제
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    shutdownJobSystem();
+    shutdownMusic();
     freeSoundEffects();
     Mix_CloseAudio();
+    closePack(); // 폰트와 소리가 팩 메모리를 가리키므로 전부 해제한 뒤에
+    reportMemoryLeaks();
+    shutdownLogger();
     IMG_Quit();
     SDL_Quit();
-    return 0;
-}
\ No newline at end of file
+    return exitCode;
+}
+#endif // DINGDONG_NO_MAIN
@@ -0,0 +1,505 @@
+// 마이크로 / 매크로 벤치마크
+// 사용법: bench_<이름> [--iterations=N] [--out=결과.json] [--data=데이터 폴더] [--tiles=맵 폴더] [--npcs=N]
+// 게임 코드(main.c)를 통째로 포함해서 실제 함수를 그대로 잼, 결과는 커밋끼리 비교할 수 있도록 JSON 한 개로 출력
+// CMake가 이 파일을 BENCHMARK_NAME마다 하나씩 빌드함 (bench_base64_decode, bench_parseTileData, ...)
+// BENCHMARK_NAME 없이 빌드하면 첫 번째 인자로 이름을 받음
+// 예: bench_parseTileData --iterations=500 --out=parseTileData.json
+// 스트레스 월드(tools/worldGenerator)는 --tiles로 지정: bench_stressWorld --tiles=build/stress/64
+#define DINGDONG_NO_MAIN
+#include "../main.c"
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef BENCHMARK_COMMIT
+#define BENCHMARK_COMMIT "unknown"
+#endif
+#ifndef BENCHMARK_BUILD_TYPE
+#define BENCHMARK_BUILD_TYPE "unknown"
+#endif
+
+#define MAX_BENCH_SAMPLES 100000
+#define BENCH_WARMUP 3
+
+typedef struct BenchContext{
+    int iterations;
+    int npcCount;
+    Uint64 samples[MAX_BENCH_SAMPLES]; // 반복마다 걸린 시간 (ns)
+    int sampleCount;
+    double work;                       // 반복 한 번이 처리한 양 (바이트, 타일, 맵, 틱 등)
+    const char *workUnit;
+    cJSON *world;                      // 월드 크기와 로딩 통계 (맵을 읽는 벤치마크만)
+} BenchContext;
+
+typedef SDL_bool (*BenchFunction)(BenchContext *bench);
+
+static Uint64 benchStart;
+
+static void beginSample(){
+    benchStart = SDL_GetPerformanceCounter();
+}
+
+static void endSample(BenchContext *bench){
+    Uint64 elapsed = SDL_GetPerformanceCounter() - benchStart;
+    if(bench->sampleCount < MAX_BENCH_SAMPLES){
+        bench->samples[bench->sampleCount++] = elapsed * 1000000000ull / SDL_GetPerformanceFrequency();
+    }
+}
+
+// 맵 JSON을 로더로 읽어서 다 올라올 때까지 기다림 (맵 수 반환)
+static int loadBenchMaps(){
+    int mapCount = loadMapsFromDirectory(mapDirectory, maps, MAX_MAPCOUNT);
+    while(getAssetProgress() < 1.0f){
+        processAssetUploads(ASSET_UPLOADS_PER_FRAME);
+        waitForAssetLoader(ASSET_NONE, ASSET_WAIT_TIMEOUT);
+    }
+    currentMapCount = mapCount;
+    return mapCount;
+}
+
+static void releaseBenchMaps(int mapCount){
+    for(int i = 0; i < mapCount; i++){
+        releaseAsset(maps[i].asset);
+        maps[i].asset = ASSET_NONE;
+        maps[i].mapJson = NULL;
+    }
+    processAssetUploads(0); // 반납된 JSON 해제
+}
+
+// 헤드리스 소프트웨어 렌더러 (창 없이 800x600 서피스에 그림)
+static SDL_Surface *benchSurface = NULL;
+
+static SDL_bool createBenchRenderer(){
+    benchSurface = SDL_CreateRGBSurfaceWithFormat(0, 800, 600, 32, SDL_PIXELFORMAT_ARGB8888);
+    renderer = benchSurface != NULL ? SDL_CreateSoftwareRenderer(benchSurface) : NULL;
+    if(renderer == NULL){
+        LOG_ERROR(LOG_CORE, "Failed to create software renderer: %s", SDL_GetError());
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static void destroyBenchRenderer(){
+    if(renderer != NULL) SDL_DestroyRenderer(renderer);
+    if(benchSurface != NULL) SDL_FreeSurface(benchSurface);
+    renderer = NULL;
+    benchSurface = NULL;
+}
+
+// base64_decode: 1 MB짜리 무작위 데이터를 인코딩해 두고 디코딩만 반복
+static SDL_bool benchBase64Decode(BenchContext *bench){
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const size_t rawLength = 1 << 20;
+    size_t encodedLength = rawLength / 3 * 4 + 4;
+    char *encoded = MEM_ALLOC(MEM_CORE, encodedLength + 1);
+    Uint32 state = 0x9E3779B9u;
+    size_t length = 0;
+
+    for(size_t i = 0; i < rawLength; i += 3){
+        Uint32 bits = 0;
+        for(int b = 0; b < 3; b++){
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            bits = (bits << 8) | (state & 0xFF);
+        }
+        encoded[length++] = table[(bits >> 18) & 63];
+        encoded[length++] = table[(bits >> 12) & 63];
+        encoded[length++] = table[(bits >> 6) & 63];
+        encoded[length++] = table[bits & 63];
+    }
+    encoded[length] = '\0';
+
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        size_t decodedLength;
+        if(i >= 0) beginSample();
+        unsigned char *decoded = base64_decode(encoded, length, &decodedLength);
+        if(i >= 0) endSample(bench);
+        MEM_FREE(decoded);
+    }
+    MEM_FREE(encoded);
+    bench->work = (double)length;
+    bench->workUnit = "bytes";
+    return SDL_TRUE;
+}
+
+// parseTileData: 읽어 둔 맵 JSON 전부에서 타일 레이어를 다시 디코딩
+static SDL_bool benchParseTileData(BenchContext *bench){
+    int mapCount = loadBenchMaps();
+    if(mapCount <= 0) return SDL_FALSE;
+    for(int m = 0; m < mapCount; m++){
+        maps[m].mapJson = getAssetJson(maps[m].asset);
+        if(maps[m].mapJson == NULL || !parseMapHeader(&maps[m])) return SDL_FALSE;
+    }
+
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        if(i >= 0) beginSample();
+        for(int m = 0; m < mapCount; m++){
+            MEM_FREE(maps[m].tileData);
+            maps[m].tileData = NULL;
+            if(parseTileData(&maps[m]) == NULL) return SDL_FALSE;
+        }
+        if(i >= 0) endSample(bench);
+    }
+
+    bench->work = 0;
+    for(int m = 0; m < mapCount; m++) bench->work += maps[m].mapWidth * maps[m].mapHeight;
+    bench->workUnit = "tiles";
+    freeMapData(maps, mapCount);
+    releaseBenchMaps(mapCount);
+    return SDL_TRUE;
+}
+
+// loadMapsFromDirectory: 요청부터 로더 스레드가 JSON을 다 파싱할 때까지 (캐시가 남지 않도록 매번 반납)
+static SDL_bool benchLoadMaps(BenchContext *bench){
+    int mapCount = 0;
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        if(i >= 0) beginSample();
+        mapCount = loadBenchMaps();
+        if(i >= 0) endSample(bench);
+        if(mapCount <= 0) return SDL_FALSE;
+        releaseBenchMaps(mapCount);
+    }
+    bench->work = mapCount;
+    bench->workUnit = "maps";
+    return SDL_TRUE;
+}
+
+// 월드 구축까지 (renderTileMap, updatePhysics용)
+// 상한(MAX_PLATFORMCOUNT 등)에 걸려 버린 오브젝트가 있으면 결과가 월드 크기를 반영하지 않으므로 실패 처리
+static SDL_bool buildBenchWorld(){
+    int mapCount = loadBenchMaps();
+    if(mapCount <= 0 || !buildWorld(maps, mapCount)) return SDL_FALSE;
+    if(droppedWorldObjects > 0){
+        fprintf(stderr, "%s: %d world objects exceed the engine limits (platforms %d/%d, interactions %d/%d, NPC spawns %d/%d)\n",
+                mapDirectory, droppedWorldObjects, platformCount, MAX_PLATFORMCOUNT, interactionCount, MAX_INTERACTIONS,
+                npcSpawnCount, MAX_NPC_SPAWNS);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static void freeBenchWorld(){
+    freeInteractions();
+    freeMapData(maps, MAX_MAPCOUNT);
+    releaseBenchMaps(currentMapCount);
+}
+
+static int getTrackedLiveBytes(){
+    int bytes = 0;
+    for(int t = 0; t < MEM_TAG_COUNT; t++) bytes += getMemoryLiveBytes(t);
+    return bytes;
+}
+
+// 결과에 월드 크기를 같이 남김 (규모별로 그래프를 그릴 수 있도록)
+static void recordBenchWorld(BenchContext *bench, double loadTime){
+    int tiles = 0;
+    for(int m = 0; m < currentMapCount; m++) tiles += maps[m].mapWidth * maps[m].mapHeight;
+
+    bench->world = cJSON_CreateObject();
+    cJSON_AddStringToObject(bench->world, "tiles", mapDirectory);
+    cJSON_AddNumberToObject(bench->world, "maps", currentMapCount);
+    cJSON_AddNumberToObject(bench->world, "tileCount", tiles);
+    cJSON_AddNumberToObject(bench->world, "platforms", platformCount);
+    cJSON_AddNumberToObject(bench->world, "polygonPlatforms", polygonPlatformCount);
+    cJSON_AddNumberToObject(bench->world, "interactions", interactionCount);
+    cJSON_AddNumberToObject(bench->world, "loadTime", loadTime);
+    cJSON_AddNumberToObject(bench->world, "liveBytesAfterLoad", getTrackedLiveBytes());
+}
+
+// renderTileMap: 소프트웨어 렌더러로 화면 한 장 (카메라를 월드 끝까지 옮겨 가며)
+static SDL_bool benchRenderTileMap(BenchContext *bench){
+    if(!createBenchRenderer()) return SDL_FALSE;
+    SDL_Surface *tileset = IMG_Load_RW(openAssetFile("resource/Tileset00.png"), 1);
+    tilesetTexture = tileset != NULL ? SDL_CreateTextureFromSurface(renderer, tileset) : NULL;
+    if(tileset != NULL) SDL_FreeSurface(tileset);
+    if(tilesetTexture == NULL || !buildBenchWorld()){
+        destroyBenchRenderer();
+        return SDL_FALSE;
+    }
+
+    int worldWidth = (maps[currentMapCount - 1].worldX + maps[currentMapCount - 1].mapWidth * maps[currentMapCount - 1].tileWidth) * 3;
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        int cameraX = (int)(((Sint64)(i + BENCH_WARMUP) * 97) % (worldWidth > 800 ? worldWidth - 800 : 1));
+        if(i >= 0) beginSample();
+        SDL_RenderClear(renderer);
+        for(int m = 0; m < currentMapCount; m++){
+            renderTileMap(renderer, &maps[m], maps[m].worldX * 3 - cameraX, 0);
+        }
+        if(i >= 0) endSample(bench);
+    }
+
+    bench->work = 1;
+    bench->workUnit = "frames";
+    freeBenchWorld();
+    SDL_DestroyTexture(tilesetTexture);
+    tilesetTexture = NULL;
+    destroyBenchRenderer();
+    return SDL_TRUE;
+}
+
+// updatePhysics: 물리 틱 하나 (플레이어 + --npcs명의 배회 NPC)
+static SDL_bool benchUpdatePhysics(BenchContext *bench){
+    if(!buildBenchWorld()) return SDL_FALSE;
+
+    GameContext *game = MEM_CALLOC(MEM_CORE, 1, sizeof(GameContext));
+    initGameContext(game, 1000);
+    game->audioEnabled = SDL_FALSE;
+    spawnWanderingNPCs(game, bench->npcCount, NULL);
+
+    const float physicsStep = 1.0f / physicsTickRate;
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        if(i >= 0) beginSample();
+        updatePhysics(game, physicsStep);
+        if(i >= 0) endSample(bench);
+    }
+
+    bench->work = 1 + game->world.entities.count;
+    bench->workUnit = "bodies";
+    MEM_FREE(game);
+    freeBenchWorld();
+    return SDL_TRUE;
+}
+
+// 글자 렌더링: renderText 한 줄 (대화창 한 줄 분량의 한글)
+static SDL_bool benchRenderText(BenchContext *bench){
+    if(TTF_Init() == -1 || !createBenchRenderer()) return SDL_FALSE;
+    TTF_Font *font = TTF_OpenFontRW(openAssetFile("resource/The Jamsil.ttf"), 1, 24);
+    if(font == NULL){
+        LOG_ERROR(LOG_CORE, "Failed to open font: %s", TTF_GetError());
+        destroyBenchRenderer();
+        return SDL_FALSE;
+    }
+
+    const char *line = "이동: WASD,   상호작용: E,   확인: Z,   띵동대쉬: Spacebar";
+    SDL_Color color = { 255, 255, 255, 255 };
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        if(i >= 0) beginSample();
+        renderText(renderer, line, 20, 20, font, color);
+        if(i >= 0) endSample(bench);
+    }
+
+    bench->work = strlen(line);
+    bench->workUnit = "bytes";
+    TTF_CloseFont(font);
+    destroyBenchRenderer();
+    TTF_Quit();
+    return SDL_TRUE;
+}
+
+// 스트레스 월드: 로딩(요청 -> 월드 구축) 한 번을 재고, 프레임 하나(updateGameFrame -> 렌더)를 반복해서 잼
+// 플레이어는 첫 맵에서 좌우로 오가고, 카메라가 따라가므로 컬링과 충돌 검색이 월드 크기에 따라 어떻게 되는지 보임
+static SDL_bool benchStressWorld(BenchContext *bench){
+    if(TTF_Init() == -1 || !createBenchRenderer()) return SDL_FALSE;
+    TTF_Font *font = TTF_OpenFontRW(openAssetFile("resource/The Jamsil.ttf"), 1, 24);
+    SDL_Surface *tileset = IMG_Load_RW(openAssetFile("resource/Tileset00.png"), 1);
+    tilesetTexture = tileset != NULL ? SDL_CreateTextureFromSurface(renderer, tileset) : NULL;
+    if(tileset != NULL) SDL_FreeSurface(tileset);
+
+    Uint64 loadStart = SDL_GetPerformanceCounter();
+    SDL_bool built = buildBenchWorld();
+    double loadTime = (double)(SDL_GetPerformanceCounter() - loadStart) * 1e9 / SDL_GetPerformanceFrequency();
+    if(font == NULL || tilesetTexture == NULL || !built){
+        if(font != NULL) TTF_CloseFont(font);
+        destroyBenchRenderer();
+        return SDL_FALSE;
+    }
+    recordBenchWorld(bench, loadTime);
+
+    GameContext *game = MEM_CALLOC(MEM_CORE, 1, sizeof(GameContext));
+    initGameContext(game, 1000);
+    game->audioEnabled = SDL_FALSE;
+    game->player.x = game->player.previousX = maps[0].worldX * 3 + 144.0f;
+    game->player.y = game->player.previousY = 0.0f;
+    game->camera.x = game->player.x - 400.0f;
+    spawnWanderingNPCs(game, bench->npcCount, NULL);
+
+    SDL_Scancode walkKey = SDL_SCANCODE_RIGHT;
+    for(int i = -BENCH_WARMUP; i < bench->iterations; i++){
+        Uint32 now = 1000 + (Uint32)((i + BENCH_WARMUP) * 1000 / physicsTickRate);
+
+        // 5초마다 방향을 바꿈
+        if((i + BENCH_WARMUP) % (physicsTickRate * 5) == 0){
+            SDL_Event key;
+            memset(&key, 0, sizeof(key));
+            key.key.timestamp = now;
+            key.type = SDL_KEYUP;
+            key.key.keysym.scancode = walkKey;
+            recordInputEvent(game, &key);
+            walkKey = walkKey == SDL_SCANCODE_RIGHT ? SDL_SCANCODE_LEFT : SDL_SCANCODE_RIGHT;
+            key.type = SDL_KEYDOWN;
+            key.key.keysym.scancode = walkKey;
+            recordInputEvent(game, &key);
+        }
+
+        if(i >= 0) beginSample();
+        updateInputFrame(game);
+        updateGameFrame(game, now, EVENT_START_WHEN_READY);
+        render(game, renderer, maps, currentMapCount, font);
+        endMemoryFrame();
+        if(i >= 0) endSample(bench);
+    }
+
+    bench->work = 1;
+    bench->workUnit = "frames";
+    cancelPendingEvent(game);
+    resetPrefetch(game);
+    freeAnimations(game->world.animations, game->world.animationCount);
+    MEM_FREE(game);
+    freeBenchWorld();
+    SDL_DestroyTexture(tilesetTexture);
+    tilesetTexture = NULL;
+    closeCachedFonts();
+    TTF_CloseFont(font);
+    destroyBenchRenderer();
+    TTF_Quit();
+    return SDL_TRUE;
+}
+
+typedef struct BenchEntry{
+    const char *name;
+    BenchFunction function;
+    int defaultIterations;
+} BenchEntry;
+
+static const BenchEntry benchmarks[] = {
+    { "base64_decode",         benchBase64Decode,  200 },
+    { "parseTileData",         benchParseTileData, 2000 },
+    { "loadMapsFromDirectory", benchLoadMaps,      50 },
+    { "renderTileMap",         benchRenderTileMap, 500 },
+    { "updatePhysics",         benchUpdatePhysics, 5000 },
+    { "renderText",            benchRenderText,    2000 },
+    { "stressWorld",           benchStressWorld,   1200 },
+};
+
+static int compareSamples(const void *a, const void *b){
+    Uint64 x = *(const Uint64 *)a, y = *(const Uint64 *)b;
+    return x < y ? -1 : x > y;
+}
+
+// 결과 JSON (시간은 전부 나노초)
+static char *formatBenchResult(const BenchEntry *entry, BenchContext *bench){
+    qsort(bench->samples, bench->sampleCount, sizeof(Uint64), compareSamples);
+    double total = 0.0;
+    for(int i = 0; i < bench->sampleCount; i++) total += (double)bench->samples[i];
+    double mean = total / bench->sampleCount;
+    double median = (double)bench->samples[bench->sampleCount / 2];
+
+    int peakBytes = 0;
+    for(int t = 0; t < MEM_TAG_COUNT; t++) peakBytes += SDL_AtomicGet(&memoryStats[t].peakBytes);
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "benchmark", entry->name);
+    cJSON_AddStringToObject(root, "commit", BENCHMARK_COMMIT);
+    cJSON_AddStringToObject(root, "buildType", BENCHMARK_BUILD_TYPE);
+    cJSON_AddNumberToObject(root, "iterations", bench->sampleCount);
+    cJSON_AddStringToObject(root, "unit", "ns");
+    cJSON_AddNumberToObject(root, "min", (double)bench->samples[0]);
+    cJSON_AddNumberToObject(root, "median", median);
+    cJSON_AddNumberToObject(root, "mean", mean);
+    cJSON_AddNumberToObject(root, "p95", (double)bench->samples[(int)(bench->sampleCount * 0.95)]);
+    cJSON_AddNumberToObject(root, "max", (double)bench->samples[bench->sampleCount - 1]);
+    cJSON_AddNumberToObject(root, "work", bench->work);
+    cJSON_AddStringToObject(root, "workUnit", bench->workUnit);
+    cJSON_AddNumberToObject(root, "workPerSecond", median > 0.0 ? bench->work * 1e9 / median : 0.0);
+    cJSON_AddNumberToObject(root, "peakTrackedBytes", peakBytes);
+    if(bench->world != NULL) cJSON_AddItemToObject(root, "world", bench->world);
+    char *text = cJSON_Print(root);
+    cJSON_Delete(root);
+    return text;
+}
+
+int main(int argc, char* argv[]){
+    const char *name = NULL;
+    const char *outPath = NULL;
+    const char *dataPath = NULL;
+    int iterations = 0;
+    static BenchContext bench;
+    bench.npcCount = 1000;
+#ifdef BENCHMARK_NAME
+    name = BENCHMARK_NAME;
+#endif
+
+    for(int i = 1; i < argc; i++){
+        if(strncmp(argv[i], "--iterations=", 13) == 0){
+            iterations = atoi(argv[i] + 13);
+        }
+        else if(strncmp(argv[i], "--out=", 6) == 0){
+            outPath = argv[i] + 6;
+        }
+        else if(strncmp(argv[i], "--data=", 7) == 0){
+            dataPath = argv[i] + 7; // tile, resource 폴더가 있는 곳 (기본은 현재 폴더)
+        }
+        else if(strncmp(argv[i], "--tiles=", 8) == 0){
+            strncpy(mapDirectory, argv[i] + 8, sizeof(mapDirectory) - 1); // 맵 JSON 폴더 (기본 tile)
+        }
+        else if(strncmp(argv[i], "--npcs=", 7) == 0){
+            bench.npcCount = atoi(argv[i] + 7);
+        }
+        else if(name == NULL && argv[i][0] != '-'){
+            name = argv[i];
+        }
+    }
+
+    const BenchEntry *entry = NULL;
+    for(int i = 0; i < (int)(sizeof(benchmarks) / sizeof(benchmarks[0])); i++){
+        if(name != NULL && strcmp(benchmarks[i].name, name) == 0) entry = &benchmarks[i];
+    }
+    if(entry == NULL){
+        fprintf(stderr, "usage: %s <benchmark> [--iterations=N] [--out=file.json] [--data=dir] [--tiles=dir] [--npcs=N]\n", argv[0]);
+        for(int i = 0; i < (int)(sizeof(benchmarks) / sizeof(benchmarks[0])); i++){
+            fprintf(stderr, "  %s\n", benchmarks[i].name);
+        }
+        return 2;
+    }
+    if(dataPath != NULL){
+#ifdef _WIN32
+        int changed = _chdir(dataPath) == 0;
+#else
+        int changed = chdir(dataPath) == 0;
+#endif
+        if(!changed){
+            perror(dataPath);
+            return 1;
+        }
+    }
+    bench.iterations = iterations > 0 ? iterations : entry->defaultIterations;
+    if(bench.iterations > MAX_BENCH_SAMPLES) bench.iterations = MAX_BENCH_SAMPLES;
+
+    initLogger();
+    setLogLevel("warn"); // 결과 JSON만 stdout에 남도록
+    initMemoryTracking();
+    SDL_Init(0);
+    IMG_Init(IMG_INIT_PNG);
+    initJobSystem(0);
+    openPack("data.pak");
+    initAssets();
+
+    SDL_bool ok = entry->function(&bench) && bench.sampleCount > 0;
+    if(ok){
+        char *result = formatBenchResult(entry, &bench);
+        FILE *out = outPath != NULL ? fopen(outPath, "w") : stdout;
+        if(out != NULL){
+            fprintf(out, "%s\n", result);
+            if(out != stdout) fclose(out);
+        }
+        else{
+            perror(outPath);
+            ok = SDL_FALSE;
+        }
+        MEM_FREE(result);
+    }
+    else{
+        LOG_ERROR(LOG_CORE, "Benchmark %s failed", entry->name);
+    }
+
+    shutdownAssets();
+    shutdownJobSystem();
+    closePack();
+    shutdownLogger();
+    IMG_Quit();
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// 에셋 팩 빌더
+// 사용법: packBuilder [-c] 출력.pak 폴더1 [폴더2 ...]
+// 폴더 안의 파일을 전부 (하위 폴더 포함) 하나의 팩 파일로 묶음, -c를 주면 줄어드는 파일만 LZ 압축
+// 예: packBuilder -c data.pak tile resource
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../code/packFormat.h"
+
+#define MAX_PACK_FILES 4096
+
+typedef struct SourceFile{
+    char path[PACK_PATH_LENGTH];
+} SourceFile;
+
+SourceFile files[MAX_PACK_FILES];
+int fileCount = 0;
+
+static void collectFiles(const char *directory){
+    DIR *dir = opendir(directory);
+    if(dir == NULL){
+        perror(directory);
+        return;
+    }
+
+    struct dirent *entry;
+    while((entry = readdir(dir)) != NULL){
+        if(entry->d_name[0] == '.') continue;
+
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+
+        struct stat fileStat;
+        if(stat(path, &fileStat) != 0) continue;
+        if(S_ISDIR(fileStat.st_mode)){
+            collectFiles(path);
+        }
+        else if(S_ISREG(fileStat.st_mode)){
+            if(strlen(path) >= PACK_PATH_LENGTH){
+                printf("Path too long, skipped: %s\n", path);
+                continue;
+            }
+            if(fileCount >= MAX_PACK_FILES){
+                printf("Too many files, skipped: %s\n", path);
+                continue;
+            }
+            strcpy(files[fileCount++].path, path);
+        }
+    }
+    closedir(dir);
+}
+
+static int compareFiles(const void *a, const void *b){
+    return strcmp(((const SourceFile *)a)->path, ((const SourceFile *)b)->path);
+}
+
+static unsigned char *readWholeFile(const char *path, size_t *size){
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = malloc(length > 0 ? length : 1);
+    if(data != NULL && fread(data, 1, length, file) != (size_t)length){
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+}
+
+static void writePadding(FILE *pack, long *position){
+    static const unsigned char zeros[PACK_ALIGNMENT] = { 0 };
+    long padding = (PACK_ALIGNMENT - (*position % PACK_ALIGNMENT)) % PACK_ALIGNMENT;
+    fwrite(zeros, 1, padding, pack);
+    *position += padding;
+}
+
+int main(int argc, char *argv[]){
+    int compress = 0;
+    int argIndex = 1;
+    if(argIndex < argc && strcmp(argv[argIndex], "-c") == 0){
+        compress = 1;
+        argIndex++;
+    }
+    if(argc - argIndex < 2){
+        printf("Usage: packBuilder [-c] output.pak directory [directory ...]\n");
+        return 1;
+    }
+
+    const char *outputPath = argv[argIndex++];
+    for(; argIndex < argc; argIndex++){
+        collectFiles(argv[argIndex]);
+    }
+    qsort(files, fileCount, sizeof(SourceFile), compareFiles); // 게임에서 이분 탐색
+
+    FILE *pack = fopen(outputPath, "wb");
+    if(pack == NULL){
+        perror(outputPath);
+        return 1;
+    }
+
+    PackHeader header = { PACK_MAGIC, PACK_VERSION, (uint32_t)fileCount, 0 };
+    PackEntry *entries = calloc(fileCount > 0 ? fileCount : 1, sizeof(PackEntry));
+    fwrite(&header, sizeof(header), 1, pack);
+    fwrite(entries, sizeof(PackEntry), fileCount, pack); // 목차 자리 (나중에 다시 씀)
+
+    long position = sizeof(header) + sizeof(PackEntry) * fileCount;
+    size_t totalSize = 0, totalStored = 0;
+
+    for(int i = 0; i < fileCount; i++){
+        size_t size;
+        unsigned char *data = readWholeFile(files[i].path, &size);
+        if(data == NULL){
+            printf("Failed to read %s\n", files[i].path);
+            fclose(pack);
+            return 1;
+        }
+
+        const unsigned char *stored = data;
+        size_t storedSize = size;
+        unsigned char *packed = NULL;
+        uint32_t flags = 0;
+
+        // 1/8 이상 줄어들 때만 압축 (PNG/OGG처럼 이미 압축된 파일은 그대로)
+        if(compress && size > 64){
+            packed = malloc(size + size / 255 + 16);
+            size_t packedSize = packLZ(data, size, packed);
+            if(packedSize < size - size / 8){
+                stored = packed;
+                storedSize = packedSize;
+                flags |= PACK_ENTRY_COMPRESSED;
+            }
+        }
+
+        writePadding(pack, &position);
+        strcpy(entries[i].path, files[i].path); // 길이는 collectFiles에서 확인함
+        entries[i].offset = (uint32_t)position;
+        entries[i].size = (uint32_t)size;
+        entries[i].storedSize = (uint32_t)storedSize;
+        entries[i].flags = flags;
+        fwrite(stored, 1, storedSize, pack);
+        position += (long)storedSize;
+
+        printf("%-60s %8zu -> %8zu%s\n", files[i].path, size, storedSize, flags ? " (LZ)" : "");
+        totalSize += size;
+        totalStored += storedSize;
+        free(packed);
+        free(data);
+    }
+
+    fseek(pack, sizeof(header), SEEK_SET);
+    fwrite(entries, sizeof(PackEntry), fileCount, pack);
+    fclose(pack);
+    free(entries);
+
+    printf("Packed %d files: %zu -> %zu bytes into %s\n", fileCount, totalSize, totalStored, outputPath);
+    return 0;
+}
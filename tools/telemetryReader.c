@@ -0,0 +1,134 @@
+// 라이브 텔레메트리 읽기
+// 사용법: telemetryReader [-w] [-s [소켓 경로]]
+// 게임을 --telemetry로 실행하면 공유 메모리에서, --telemetrysocket으로 실행했다면 -s로 소켓에서 블록을 읽어 출력
+// -w를 주면 1초마다 계속 출력 (Ctrl+C로 끝냄)
+// 예: telemetryReader -w
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../code/telemetryFormat.h"
+
+static const char *memoryTagNames[] = { "core", "map", "json", "text", "audio", "texture", "ui" };
+
+// 공유 메모리에서 한 벌 복사 (게임이 쓰는 중이면 다시), 실패하면 -1
+// 게임 쪽은 SDL_MemoryBarrierRelease로 sequence와 내용을 나눠 쓰므로, 여기서는 acquire로 짝을 맞춤
+static int readShm(const TelemetryBlock *shared, TelemetryBlock *block){
+    for(int attempt = 0; attempt < 1000; attempt++){
+        uint32_t before = __atomic_load_n(&shared->sequence, __ATOMIC_ACQUIRE); // 이후 복사가 앞당겨지지 않음
+        if(before & 1) continue;
+        memcpy(block, shared, sizeof(TelemetryBlock));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE); // 복사가 다시 읽는 sequence보다 늦어지지 않음
+        if(__atomic_load_n(&shared->sequence, __ATOMIC_RELAXED) == before) return 0;
+    }
+    fprintf(stderr, "telemetry block keeps changing, giving up\n");
+    return -1;
+}
+
+// 소켓으로 연결해 블록 하나를 받음, 실패하면 -1
+static int readSocket(const char *path, TelemetryBlock *block){
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(client == -1 || connect(client, (struct sockaddr *)&address, sizeof(address)) != 0){
+        perror(path);
+        if(client != -1) close(client);
+        return -1;
+    }
+
+    // 게임은 다음 게시 때 (최대 100ms 뒤) 보내줌
+    size_t received = 0;
+    while(received < sizeof(TelemetryBlock)){
+        ssize_t length = recv(client, (char *)block + received, sizeof(TelemetryBlock) - received, 0);
+        if(length <= 0) break;
+        received += (size_t)length;
+    }
+    close(client);
+    if(received != sizeof(TelemetryBlock)){
+        fprintf(stderr, "%s: short read (%zu of %zu bytes)\n", path, received, sizeof(TelemetryBlock));
+        return -1;
+    }
+    return 0;
+}
+
+static int checkBlock(const TelemetryBlock *block){
+    if(block->magic != TELEMETRY_MAGIC){
+        fprintf(stderr, "not a telemetry block (magic %08x)\n", block->magic);
+        return -1;
+    }
+    if(block->version != TELEMETRY_VERSION || block->size != sizeof(TelemetryBlock)){
+        fprintf(stderr, "telemetry version %u (%u bytes), this reader expects %d (%zu bytes)\n",
+                block->version, block->size, TELEMETRY_VERSION, sizeof(TelemetryBlock));
+        return -1;
+    }
+    return 0;
+}
+
+static void printBlock(const TelemetryBlock *block){
+    printf("pid %u  uptime %u.%03u s  frame %llu\n", block->processId, block->uptime / 1000, block->uptime % 1000,
+           (unsigned long long)block->frame);
+    printf("  frame    %.2f ms avg, %.2f ms max, %.1f fps, %u hitches\n",
+           block->frameTimeAverage, block->frameTimeMax, block->fps, block->hitchCount);
+    printf("  memory   %.1f KB live (", block->memoryLiveTotal / 1024.0f);
+    for(int i = 0; i < (int)(sizeof(memoryTagNames) / sizeof(memoryTagNames[0])); i++){
+        printf("%s%s %.1f", i > 0 ? ", " : "", memoryTagNames[i], block->memoryLive[i] / 1024.0f);
+    }
+    printf(")\n");
+    printf("  world    %u maps, %u platforms, %u interactions, %u entities\n",
+           block->loadedMaps, block->platformCount, block->interactionCount, block->entityCount);
+    printf("  audio    %u voices, dropped / stolen %u / %u, cache %u KB, latency %.1f ms\n",
+           block->activeVoices, block->voicesDropped, block->voicesStolen, block->soundCacheBytes / 1024, block->soundLatency);
+    printf("  assets   %u resident, %u pending, prefetch hit / late / miss %u / %u / %u\n",
+           block->assetsResident, block->assetsPending, block->prefetchHits, block->prefetchLate, block->prefetchMisses);
+    printf("  input    %.1f ms latency avg\n", block->inputLatencyAverage);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]){
+    int watch = 0;
+    const char *socketPath = NULL;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "-w") == 0){
+            watch = 1;
+        }
+        else if(strcmp(argv[i], "-s") == 0){
+            socketPath = i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : TELEMETRY_SOCKET_PATH;
+        }
+        else{
+            fprintf(stderr, "usage: %s [-w] [-s [socket path]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const TelemetryBlock *shared = NULL;
+    if(socketPath == NULL){
+        int file = shm_open(TELEMETRY_SHM_NAME, O_RDONLY, 0);
+        if(file == -1){
+            perror(TELEMETRY_SHM_NAME " (is the game running with --telemetry?)");
+            return 1;
+        }
+        void *data = mmap(NULL, sizeof(TelemetryBlock), PROT_READ, MAP_SHARED, file, 0);
+        close(file);
+        if(data == MAP_FAILED){
+            perror("mmap");
+            return 1;
+        }
+        shared = data;
+    }
+
+    do{
+        TelemetryBlock block;
+        int result = shared != NULL ? readShm(shared, &block) : readSocket(socketPath, &block);
+        if(result != 0 || checkBlock(&block) != 0) return 1;
+        printBlock(&block);
+        if(watch) sleep(1);
+    } while(watch);
+    return 0;
+}
@@ -0,0 +1,278 @@
+// 스트레스 테스트용 월드 생성기
+// 사용법: worldGenerator [옵션] 출력폴더
+// Tiled에서 내보낸 것과 같은 형식(base64 타일 레이어 + NoPassing / Interaction 오브젝트 그룹)의 맵 JSON을 만듦
+// 게임이나 bench_stressWorld에 --tiles=출력폴더로 넘기면 그대로 읽음
+//   --maps=N           맵 수 (기본 9, 게임은 최대 100장)
+//   --width=W          맵 가로 타일 수 (기본 60)
+//   --height=H         맵 세로 타일 수 (기본 40)
+//   --density=0~1      빈칸이 아닌 타일 비율 (기본 0.6)
+//   --flip=0~1         뒤집기 플래그(가로/세로/대각선)가 붙은 타일 비율 (기본 0.25)
+//   --platforms=N      맵마다 떠 있는 발판 수 (바닥과 양쪽 벽은 별도, 기본 20)
+//   --slopes=0~1       발판 중 경사로(다각형) 비율 (기본 0.2)
+//   --interactions=N   맵마다 상호작용 수 (텔레포트 / 텍스트 / 이벤트 / 상점을 섞음, 기본 8)
+//   --npcs=N           맵마다 NPC 배치 지점 수 (기본 0)
+//   --events=1,4,5     이벤트 상호작용에 돌아가며 붙일 eventID (기본 1,4,5,6,7)
+//   --seed=N           난수 시드 (같은 시드면 같은 월드)
+// 예: worldGenerator --maps=64 --width=120 --height=60 build/stress/64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+#define TILE_SIZE 24
+#define TILESET_TILES 120     // Tileset00.png (240x288, 24x24 타일 10x12)
+#define MAX_EVENT_IDS 32
+
+// 타일 ID 상위 비트 (Tiled 규칙, renderTileMap과 같음)
+#define FLIP_HORIZONTAL 0x80000000u
+#define FLIP_VERTICAL 0x40000000u
+#define FLIP_DIAGONAL 0x20000000u
+
+typedef struct GeneratorOptions{
+    int mapCount;
+    int width, height;
+    double density;
+    double flipRatio;
+    int platformCount;
+    double slopeRatio;
+    int interactionCount;
+    int npcCount;
+    int eventIDs[MAX_EVENT_IDS];
+    int eventIDCount;
+    uint32_t seed;
+} GeneratorOptions;
+
+// 게임(trigger.c classifyInteraction)이 아는 이름만 씀
+static const char *teleportNames[] = { "1F-outDoor", "1F-3F", "3F-4F", "4F-roofF", "roofDoor", "elevator", "frontDoor", "bathRoom", "pyeonUijeom" };
+static const char *textNames[] = { "otherWay", "wrongWay", "NotElevator", "jinYeoldae", "Washstand", "Washtub" };
+static const char *eventNames[] = { "blockedDoor", "frige", "bed", "toDo", "Toilet" };
+static const char *teleportSounds[] = { "doorOpen", "doorClose", "slideDoorOpen", "elevator", "stair" };
+
+static uint32_t randomState;
+
+// xorshift 난수 (entity.c와 같음)
+static uint32_t nextRandom(){
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static double randomUnit(){
+    return (nextRandom() & 0xFFFFFF) / (double)0x1000000;
+}
+
+static int randomRange(int low, int high){ // [low, high]
+    return high <= low ? low : low + (int)(nextRandom() % (uint32_t)(high - low + 1));
+}
+
+static void writeBase64(FILE *file, const unsigned char *data, size_t length){
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for(size_t i = 0; i < length; i += 3){
+        uint32_t bits = (uint32_t)data[i] << 16;
+        if(i + 1 < length) bits |= (uint32_t)data[i + 1] << 8;
+        if(i + 2 < length) bits |= data[i + 2];
+        fputc(table[(bits >> 18) & 63], file);
+        fputc(table[(bits >> 12) & 63], file);
+        fputc(i + 1 < length ? table[(bits >> 6) & 63] : '=', file);
+        fputc(i + 2 < length ? table[bits & 63] : '=', file);
+    }
+}
+
+// 타일 레이어 (리틀 엔디언 uint32 배열을 base64로)
+static void writeTileLayer(FILE *file, const GeneratorOptions *options){
+    size_t count = (size_t)options->width * options->height;
+    unsigned char *data = malloc(count * 4);
+    for(size_t i = 0; i < count; i++){
+        uint32_t gid = 0;
+        if(randomUnit() < options->density){
+            gid = (uint32_t)randomRange(1, TILESET_TILES);
+            if(randomUnit() < options->flipRatio){
+                uint32_t flags[] = { FLIP_HORIZONTAL, FLIP_VERTICAL, FLIP_DIAGONAL };
+                gid |= flags[nextRandom() % 3];
+                if(nextRandom() & 1) gid |= flags[nextRandom() % 3]; // 두 개가 겹친 경우도 섞음
+            }
+        }
+        data[i * 4] = gid & 0xFF;
+        data[i * 4 + 1] = (gid >> 8) & 0xFF;
+        data[i * 4 + 2] = (gid >> 16) & 0xFF;
+        data[i * 4 + 3] = (gid >> 24) & 0xFF;
+    }
+
+    fprintf(file, "  {\"compression\":\"\", \"data\":\"");
+    writeBase64(file, data, count * 4);
+    fprintf(file, "\", \"encoding\":\"base64\", \"height\":%d, \"id\":1, \"name\":\"Background\", \"opacity\":1,"
+                  " \"type\":\"tilelayer\", \"visible\":true, \"width\":%d, \"x\":0, \"y\":0},\n",
+            options->height, options->width);
+    free(data);
+}
+
+static int nextObjectId;
+
+static void beginObject(FILE *file, int *first, const char *name, double x, double y, double width, double height){
+    fprintf(file, "%s    {\"height\":%g, \"id\":%d, \"name\":\"%s\", \"rotation\":0, \"type\":\"\", \"visible\":true,"
+                  " \"width\":%g, \"x\":%g, \"y\":%g",
+            *first ? "" : ",\n", height, nextObjectId++, name, width, x, y);
+    *first = 0;
+}
+
+// 충돌 오브젝트: 바닥 한 줄, 양쪽 벽, 떠 있는 발판과 경사로
+static void writeNoPassingLayer(FILE *file, const GeneratorOptions *options){
+    int mapWidth = options->width * TILE_SIZE;
+    int groundY = (options->height - 1) * TILE_SIZE;
+    int first = 1;
+
+    fprintf(file, "  {\"draworder\":\"topdown\", \"id\":2, \"name\":\"NoPassing\", \"objects\":[\n");
+    beginObject(file, &first, "floor", TILE_SIZE, groundY, mapWidth - TILE_SIZE * 2, TILE_SIZE);
+    fputc('}', file);
+    beginObject(file, &first, "wall", 0, 0, TILE_SIZE, groundY + TILE_SIZE);
+    fputc('}', file);
+    beginObject(file, &first, "wall", mapWidth - TILE_SIZE, 0, TILE_SIZE, groundY + TILE_SIZE);
+    fputc('}', file);
+
+    for(int i = 0; i < options->platformCount; i++){
+        int width = randomRange(3, 10) * TILE_SIZE;
+        int x = randomRange(1, options->width - 2 - width / TILE_SIZE) * TILE_SIZE;
+        int y = randomRange(2, options->height - 4) * TILE_SIZE;
+
+        if(randomUnit() < options->slopeRatio){
+            // 경사로: 직각삼각형 (왼쪽이 높거나 오른쪽이 높음)
+            int rise = randomRange(1, 3) * TILE_SIZE;
+            beginObject(file, &first, "slope", x, y, 0, 0);
+            if(nextRandom() & 1){
+                fprintf(file, ", \"polygon\":[{\"x\":0, \"y\":0}, {\"x\":%d, \"y\":%d}, {\"x\":0, \"y\":%d}]}", width, rise, rise);
+            }
+            else{
+                fprintf(file, ", \"polygon\":[{\"x\":0, \"y\":%d}, {\"x\":%d, \"y\":0}, {\"x\":%d, \"y\":%d}]}", rise, width, width, rise);
+            }
+        }
+        else{
+            beginObject(file, &first, "floor", x, y, width, TILE_SIZE);
+            fputc('}', file);
+        }
+    }
+    fprintf(file, "\n  ], \"opacity\":1, \"type\":\"objectgroup\", \"visible\":true, \"x\":0, \"y\":0},\n");
+}
+
+// 상호작용: 바닥 위에 텔레포트(옆 맵과 짝) / 텍스트 / 이벤트 / 상점을 돌아가며 배치
+static void writeInteractionLayer(FILE *file, const GeneratorOptions *options, int mapIndex){
+    int groundY = (options->height - 1) * TILE_SIZE;
+    int first = 1;
+    fprintf(file, "  {\"draworder\":\"topdown\", \"id\":3, \"name\":\"Interaction\", \"objects\":[\n");
+
+    for(int i = 0; i < options->interactionCount; i++){
+        double x = randomRange(2, options->width - 3) * TILE_SIZE;
+        switch(i % 4){
+            case 0: { // 텔레포트: 짝수 번째는 다음 맵과, 홀수 번째는 이전 맵과 같은 이름 (이름이 같으면 게임이 짝지음)
+                int pairMap = (i / 4) % 2 == 0 ? mapIndex : (mapIndex + options->mapCount - 1) % options->mapCount;
+                const char *name = teleportNames[pairMap % (int)(sizeof(teleportNames) / sizeof(teleportNames[0]))];
+                beginObject(file, &first, name, x, groundY - TILE_SIZE, 14, TILE_SIZE);
+                fprintf(file, ", \"properties\":[{\"name\":\"SE\", \"type\":\"string\", \"value\":\"%s\"}]}",
+                        teleportSounds[nextRandom() % (sizeof(teleportSounds) / sizeof(teleportSounds[0]))]);
+                break;
+            }
+            case 1:
+                beginObject(file, &first, textNames[nextRandom() % (sizeof(textNames) / sizeof(textNames[0]))], x, groundY - TILE_SIZE, 24, TILE_SIZE);
+                fprintf(file, ", \"properties\":[{\"name\":\"Text\", \"type\":\"string\", \"value\":\"map %d text %d\"}]}", mapIndex, i);
+                break;
+            case 2:
+                beginObject(file, &first, eventNames[nextRandom() % (sizeof(eventNames) / sizeof(eventNames[0]))], x, groundY - 8, 24, 8);
+                fprintf(file, ", \"properties\":[{\"name\":\"eventID\", \"type\":\"int\", \"value\":%d}]}",
+                        options->eventIDs[(mapIndex + i / 4) % options->eventIDCount]);
+                break;
+            default:
+                beginObject(file, &first, "buy", x, groundY - TILE_SIZE, 24, TILE_SIZE);
+                fprintf(file, ", \"properties\":[{\"name\":\"영양젤리\", \"type\":\"int\", \"value\":%d},"
+                              " {\"name\":\"컵라면\", \"type\":\"int\", \"value\":%d}]}",
+                        randomRange(1, 9), randomRange(1, 9));
+                break;
+        }
+    }
+
+    for(int i = 0; i < options->npcCount; i++){
+        beginObject(file, &first, "npc", randomRange(2, options->width - 4) * TILE_SIZE, groundY - TILE_SIZE, TILE_SIZE, TILE_SIZE);
+        fputc('}', file);
+    }
+    fprintf(file, "\n  ], \"opacity\":1, \"type\":\"objectgroup\", \"visible\":true, \"x\":0, \"y\":0}\n");
+}
+
+static int writeMap(const char *directory, const GeneratorOptions *options, int mapIndex){
+    char path[512];
+    snprintf(path, sizeof(path), "%s/stress%03d.json", directory, mapIndex);
+    FILE *file = fopen(path, "wb");
+    if(file == NULL){
+        perror(path);
+        return -1;
+    }
+
+    nextObjectId = 1;
+    fprintf(file, "{\"compressionlevel\":-1, \"height\":%d, \"infinite\":false,\n \"layers\":[\n", options->height);
+    writeTileLayer(file, options);
+    writeNoPassingLayer(file, options);
+    writeInteractionLayer(file, options, mapIndex);
+    fprintf(file, " ],\n \"nextlayerid\":4, \"nextobjectid\":%d, \"orientation\":\"orthogonal\", \"renderorder\":\"right-down\","
+                  " \"tiledversion\":\"1.11.0\", \"tileheight\":%d,\n"
+                  " \"tilesets\":[{\"firstgid\":1, \"source\":\"../tileSet작업물/tileSet00.tsx\"}],\n"
+                  " \"tilewidth\":%d, \"type\":\"map\", \"version\":\"1.10\", \"width\":%d}\n",
+            nextObjectId, TILE_SIZE, TILE_SIZE, options->width);
+    fclose(file);
+    return 0;
+}
+
+static void parseEventIDs(GeneratorOptions *options, const char *list){
+    options->eventIDCount = 0;
+    while(*list != '\0' && options->eventIDCount < MAX_EVENT_IDS){
+        options->eventIDs[options->eventIDCount++] = atoi(list);
+        const char *comma = strchr(list, ',');
+        if(comma == NULL) break;
+        list = comma + 1;
+    }
+}
+
+int main(int argc, char *argv[]){
+    GeneratorOptions options = { 9, 60, 40, 0.6, 0.25, 20, 0.2, 8, 0, { 1, 4, 5, 6, 7 }, 5, 0x9E3779B9u };
+    const char *directory = NULL;
+
+    for(int i = 1; i < argc; i++){
+        if(strncmp(argv[i], "--maps=", 7) == 0) options.mapCount = atoi(argv[i] + 7);
+        else if(strncmp(argv[i], "--width=", 8) == 0) options.width = atoi(argv[i] + 8);
+        else if(strncmp(argv[i], "--height=", 9) == 0) options.height = atoi(argv[i] + 9);
+        else if(strncmp(argv[i], "--density=", 10) == 0) options.density = atof(argv[i] + 10);
+        else if(strncmp(argv[i], "--flip=", 7) == 0) options.flipRatio = atof(argv[i] + 7);
+        else if(strncmp(argv[i], "--platforms=", 12) == 0) options.platformCount = atoi(argv[i] + 12);
+        else if(strncmp(argv[i], "--slopes=", 9) == 0) options.slopeRatio = atof(argv[i] + 9);
+        else if(strncmp(argv[i], "--interactions=", 15) == 0) options.interactionCount = atoi(argv[i] + 15);
+        else if(strncmp(argv[i], "--npcs=", 7) == 0) options.npcCount = atoi(argv[i] + 7);
+        else if(strncmp(argv[i], "--events=", 9) == 0) parseEventIDs(&options, argv[i] + 9);
+        else if(strncmp(argv[i], "--seed=", 7) == 0) options.seed = (uint32_t)strtoul(argv[i] + 7, NULL, 10);
+        else if(argv[i][0] != '-') directory = argv[i];
+        else{
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if(directory == NULL || options.mapCount <= 0 || options.width < 8 || options.height < 8 || options.eventIDCount == 0){
+        fprintf(stderr, "usage: worldGenerator [--maps=N] [--width=W] [--height=H] [--density=0-1] [--flip=0-1]\n"
+                        "                      [--platforms=N] [--slopes=0-1] [--interactions=N] [--npcs=N]\n"
+                        "                      [--events=1,4,5] [--seed=N] <output directory>\n"
+                        "(width and height must be at least 8 tiles)\n");
+        return 2;
+    }
+    randomState = options.seed != 0 ? options.seed : 1; // 0이면 xorshift가 멈춤
+    makeDirectory(directory); // 이미 있으면 실패해도 그대로 씀
+
+    for(int i = 0; i < options.mapCount; i++){
+        if(writeMap(directory, &options, i) != 0) return 1;
+    }
+    printf("Wrote %d maps (%dx%d tiles, %d platforms, %d interactions each) to %s\n",
+           options.mapCount, options.width, options.height, options.platformCount + 3, options.interactionCount, directory);
+    return 0;
+}